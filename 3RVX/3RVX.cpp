@@ -1,6 +1,7 @@
 ﻿#include <Windows.h>
 #include <gdiplus.h>
 #pragma comment(lib, "gdiplus.lib")
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -9,14 +10,20 @@
 
 #include "3RVX.h"
 #include "DisplayManager.h"
+#include "HotkeyAction.h"
 #include "HotkeyInfo.h"
 #include "HotkeyManager.h"
+#include "HotkeyProfiles.h"
 #include "KeyboardHotkeyProcessor.h"
+#include "Launcher.h"
 #include "Logger.h"
 #include "OSD\EjectOSD.h"
 #include "OSD\VolumeOSD.h"
 #include "Settings.h"
+#include "SettingsChanges.h"
 #include "SkinManager.h"
+#include "Trace.h"
+#include "WindowProcessSource.h"
 
 HANDLE mutex;
 HINSTANCE hInst;
@@ -28,11 +35,20 @@ EjectOSD *eOSD;
 
 HotkeyManager *hkManager;
 KeyboardHotkeyProcessor kbHotkeyProcessor;
-std::unordered_map<int, HotkeyInfo> hotkeys;
+std::unordered_map<int, HotkeyAction> hotkeys;
+HotkeyProfiles *profiles;
+WindowProcessSource windowProcesses;
+HWINEVENTHOOK foregroundHook;
 
 void init();
+void reload();
+void LoadHotkeys();
 HWND CreateMainWnd(HINSTANCE hInstance);
-void ProcessHotkeys(HotkeyInfo &hki);
+void RegisterHotkeys(std::vector<HotkeyInfo> hkInfo);
+void ProcessHotkeys(HotkeyAction &hka);
+void ToggleTrace();
+void CALLBACK ForegroundProc(HWINEVENTHOOK hook, DWORD event, HWND hWnd,
+    LONG idObject, LONG idChild, DWORD thread, DWORD time);
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 
 
@@ -43,6 +59,13 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     Logger::Start();
 
+    /* Tracing can be started here to include startup (settings, language
+     * and skin loading) in the trace. The Start/Stop Trace hotkey action
+     * stops it and writes the trace. */
+    if (wcsstr(lpCmdLine, L"-trace") != NULL) {
+        Trace::Start();
+    }
+
     QCLOG(L"  _____ ______     ____  _______ ");
     QCLOG(L" |___ /|  _ \\ \\   / /\\ \\/ /___ / ");
     QCLOG(L"   |_ \\| |_) \\ \\ / /  \\  /  |_ \\ ");
@@ -79,17 +102,21 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     mainWnd = CreateMainWnd(hInstance);
     if (mainWnd == NULL) {
-        CLOG(L"Could not create main window");
+        ELOG(L"Could not create main window");
         return EXIT_FAILURE;
     }
 
     HRESULT hr = CoInitializeEx(NULL,
         COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
     if (hr != S_OK) {
-        CLOG(L"Failed to initialize the COM library.");
+        ELOG(L"Failed to initialize the COM library.");
         return EXIT_FAILURE;
     }
 
+    /* Programs are launched on worker threads; results come back to the
+     * main window. */
+    Launcher::Start(mainWnd);
+
     /* Tell the program to initialize */
     PostMessage(mainWnd, WM_3RVX_CONTROL, MSG_LOAD, NULL);
 
@@ -100,6 +127,7 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         DispatchMessage(&msg);
     }
 
+    Launcher::Stop();
     GdiplusShutdown(gdiplusToken);
     CoUninitialize();
 
@@ -115,8 +143,6 @@ void init() {
     delete eOSD;
 
     Settings *settings = Settings::Instance();
-    settings->Load();
-
     SkinManager::Instance()->LoadSkin(settings->SkinXML());
 
     /* TODO: Detect monitor changes, update this map, and reload/reorg OSDs */
@@ -131,17 +157,105 @@ void init() {
         hkManager->Shutdown();
     }
     hkManager = HotkeyManager::Instance(mainWnd);
+    hotkeys.clear();
+    LoadHotkeys();
+
+    WTSRegisterSessionNotification(mainWnd, NOTIFY_FOR_THIS_SESSION);
+}
+
+void reload() {
+    Settings *settings = Settings::Instance();
+    std::vector<std::string> changes = settings->Changes();
+    int affected = SettingsChanges::Affected(changes);
+    CLOG(L"Settings changed: %d; affected subsystems: %x",
+        (int) changes.size(), affected);
+
+    if (affected & SettingsChanges::OSDs) {
+        /* The skin or audio setup changed; start over. */
+        init();
+        return;
+    }
+
+    if (affected & SettingsChanges::WindowBehavior) {
+        vOSD->UpdateWindowSettings();
+        eOSD->UpdateWindowSettings();
+    }
+
+    if (affected & SettingsChanges::WindowPosition) {
+        vOSD->Reposition();
+        eOSD->Reposition();
+    }
 
-    hotkeys = Settings::Instance()->Hotkeys();
+    if (affected & SettingsChanges::Hotkeys) {
+        LoadHotkeys();
+    }
+}
+
+void LoadHotkeys() {
+    Settings *settings = Settings::Instance();
+
+    /* Per-program hotkey profiles. The active profile only changes when the
+     * foreground window does, so nothing is resolved per keystroke. */
+    if (foregroundHook != NULL) {
+        UnhookWinEvent(foregroundHook);
+        foregroundHook = NULL;
+    }
+    delete profiles;
+    profiles = new HotkeyProfiles(&windowProcesses);
+    profiles->Load(settings->Hotkeys(), settings->Profiles());
+    if (profiles->Empty() == false) {
+        profiles->Foreground(GetForegroundWindow());
+        foregroundHook = SetWinEventHook(
+            EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND,
+            NULL, &ForegroundProc, 0, 0,
+            WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    }
+    RegisterHotkeys(profiles->Active());
+}
+
+void RegisterHotkeys(std::vector<HotkeyInfo> hkInfo) {
+    /* Remove any hotkeys from the previous profile */
     for (auto it = hotkeys.begin(); it != hotkeys.end(); ++it) {
-        /* Enable arg caching */
-        it->second.EnableArgCache();
+        if (it->first >= HKM_SEQUENCE_BASE) {
+            hkManager->UnregisterSequence(it->first);
+        } else {
+            hkManager->Unregister(it->first);
+        }
+    }
+    hotkeys.clear();
+
+    /* Compile the hotkeys to their typed actions once, up front, so
+     * dispatching them doesn't require any argument parsing */
+    for (HotkeyInfo &hki : hkInfo) {
+        HotkeyAction hka(hki);
+        if (hka.Valid() == false) {
+            WLOG(L"Invalid hotkey arguments: %s", hki.ToString().c_str());
+            continue;
+        }
 
-        int combination = it->first;
-        hkManager->Register(combination);
+        /* Single combinations are identified by the combination itself;
+         * sequences are assigned an identifier by the HotkeyManager. */
+        int id = hki.keyCombination;
+        if (hki.IsSequence()) {
+            id = hkManager->RegisterSequence(hki.Steps(), hki.holdTime);
+            if (id == 0) {
+                continue;
+            }
+        } else {
+            hkManager->Register(id);
+        }
+        hotkeys[id] = hka;
     }
+}
 
-    WTSRegisterSessionNotification(mainWnd, NOTIFY_FOR_THIS_SESSION);
+void CALLBACK ForegroundProc(HWINEVENTHOOK hook, DWORD event, HWND hWnd,
+        LONG idObject, LONG idChild, DWORD thread, DWORD time) {
+
+    if (profiles != NULL && profiles->Foreground(hWnd)) {
+        CLOG(L"Switching to hotkey profile: %s",
+            profiles->ActiveProfile().c_str());
+        RegisterHotkeys(profiles->Active());
+    }
 }
 
 HWND CreateMainWnd(HINSTANCE hInstance) {
@@ -173,56 +287,76 @@ HWND CreateMainWnd(HINSTANCE hInstance) {
     return hWnd;
 }
 
-void ProcessHotkeys(HotkeyInfo &hki) {
-    switch (hki.action) {
+void ProcessHotkeys(HotkeyAction &hka) {
+    TRACE_SPAN("ProcessHotkeys");
+    switch (hka.action) {
     case HotkeyInfo::IncreaseVolume:
     case HotkeyInfo::DecreaseVolume:
     case HotkeyInfo::SetVolume:
     case HotkeyInfo::Mute:
     case HotkeyInfo::VolumeSlider:
         if (vOSD) {
-            vOSD->ProcessHotkeys(hki);
+            vOSD->ProcessHotkeys(hka);
         }
         break;
 
     case HotkeyInfo::EjectDrive:
     case HotkeyInfo::EjectLastDisk:
         if (eOSD) {
-            eOSD->ProcessHotkeys(hki);
+            eOSD->ProcessHotkeys(hka);
         }
         break;
 
     case HotkeyInfo::MediaKey:
     case HotkeyInfo::VirtualKey:
-        kbHotkeyProcessor.ProcessHotkeys(hki);
+        kbHotkeyProcessor.ProcessHotkeys(hka);
         break;
 
     case HotkeyInfo::Run:
-        if (hki.HasArgs()) {
-            ShellExecute(NULL, L"open", hki.args[0].c_str(),
-                NULL, NULL, SW_SHOWNORMAL);
-        }
+        Launcher::Open(hka.target);
         break;
 
     case HotkeyInfo::Settings:
-        ShellExecute(NULL, L"open", Settings::SettingsApp().c_str(),
-            NULL, NULL, SW_SHOWNORMAL);
+        Settings::LaunchSettingsApp();
         break;
 
     case HotkeyInfo::Exit:
         SendMessage(mainWnd, WM_CLOSE, NULL, NULL);
         break;
+
+    case HotkeyInfo::RecordTrace:
+        SendMessage(mainWnd, WM_3RVX_CONTROL, MSG_TRACE, NULL);
+        break;
     }
 }
 
+void ToggleTrace() {
+    if (Trace::Active() == false) {
+        CLOG(L"Recording trace");
+        Trace::Start();
+        return;
+    }
+
+    Trace::Stop();
+    std::wstring file = Settings::SettingsDir() + L"\\3RVX_Trace";
+    std::ofstream json(file + L".json");
+    Trace::WriteJSON(json);
+    std::ofstream csv(file + L".csv");
+    Trace::WriteSummary(csv);
+    CLOG(L"Wrote trace: %s.json, %s.csv", file.c_str(), file.c_str());
+}
+
 LRESULT CALLBACK WndProc(
     HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
 
     switch (message) {
     case WM_HOTKEY: {
+        TRACE_SPAN("WM_HOTKEY");
         CLOG(L"Hotkey: %d", (int) wParam);
-        HotkeyInfo hki = hotkeys[(int) wParam];
-        ProcessHotkeys(hki);
+        auto it = hotkeys.find((int) wParam);
+        if (it != hotkeys.end()) {
+            ProcessHotkeys(it->second);
+        }
         break;
     }
 
@@ -233,6 +367,9 @@ LRESULT CALLBACK WndProc(
 
     case WM_CLOSE: {
         CLOG(L"Shutting down");
+        if (foregroundHook != NULL) {
+            UnhookWinEvent(foregroundHook);
+        }
         HotkeyManager::Instance()->Shutdown();
         vOSD->HideIcon();
         DestroyWindow(mainWnd);
@@ -248,13 +385,44 @@ LRESULT CALLBACK WndProc(
     if (message == WM_3RVX_CONTROL) {
         switch (wParam) {
         case MSG_LOAD:
-            init();
+            /* After the initial load, only the parts of the program affected
+             * by the changed settings are updated. */
+            Settings::Instance()->Load();
+            if (vOSD == NULL) {
+                init();
+            } else {
+                reload();
+            }
             break;
 
         case MSG_SETTINGS:
             Settings::LaunchSettingsApp();
             break;
 
+        case MSG_FIXWIN:
+            HotkeyManager::FixWin((unsigned short) lParam);
+            break;
+
+        case MSG_LAUNCHED:
+            Launcher::Completed();
+            break;
+
+        case MSG_TRACE:
+            ToggleTrace();
+            break;
+
+        case MSG_REHOOK:
+            if (HotkeyManager::Instance()) {
+                HotkeyManager::Instance()->Rehook();
+            }
+            break;
+
+        case MSG_REPLAY:
+            if (HotkeyManager::Instance()) {
+                HotkeyManager::Instance()->Replay();
+            }
+            break;
+
         case MSG_HIDEOSD:
             int except = (OSDType) lParam;
             switch (except) {
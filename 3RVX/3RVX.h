@@ -12,4 +12,9 @@ static const UINT WM_3RVX_SETTINGSCTRL
 #define MSG_SETTINGS WM_APP + 101
 #define MSG_EXIT     WM_APP + 102
 #define MSG_HIDEOSD  WM_APP + 103
-#define MSG_ACTIVATE WM_APP + 104
\ No newline at end of file
+#define MSG_ACTIVATE WM_APP + 104
+#define MSG_FIXWIN   WM_APP + 105
+#define MSG_REHOOK   WM_APP + 106
+#define MSG_LAUNCHED WM_APP + 107
+#define MSG_TRACE    WM_APP + 108
+#define MSG_REPLAY   WM_APP + 109
\ No newline at end of file
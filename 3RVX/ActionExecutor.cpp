@@ -0,0 +1,89 @@
+#include "ActionExecutor.h"
+
+ActionExecutor::ActionExecutor(Notify notify, unsigned int threads) :
+_notify(notify),
+_stop(false) {
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    for (unsigned int i = 0; i < threads; ++i) {
+        _threads.push_back(std::thread(&ActionExecutor::Worker, this));
+    }
+}
+
+ActionExecutor::~ActionExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _queue.clear();
+    }
+    _cv.notify_all();
+
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+}
+
+bool ActionExecutor::Submit(const std::wstring &key, Action action) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stop || _active.count(key) > 0) {
+            return false;
+        }
+
+        _active.insert(key);
+        Job job = { key, action };
+        _queue.push_back(job);
+    }
+    _cv.notify_one();
+    return true;
+}
+
+bool ActionExecutor::Busy(const std::wstring &key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _active.count(key) > 0;
+}
+
+std::vector<ActionExecutor::Result> ActionExecutor::Completed() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<Result> completed;
+    completed.swap(_completed);
+    return completed;
+}
+
+void ActionExecutor::Worker() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        while (_stop == false && _queue.empty()) {
+            _cv.wait(lock);
+        }
+
+        if (_stop) {
+            return;
+        }
+
+        Job job = _queue.front();
+        _queue.pop_front();
+        lock.unlock();
+
+        bool success = false;
+        try {
+            success = job.action();
+        } catch (...) {
+            success = false;
+        }
+
+        lock.lock();
+        _active.erase(job.key);
+        Result result = { job.key, success };
+        _completed.push_back(result);
+
+        if (_notify) {
+            lock.unlock();
+            _notify();
+            lock.lock();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/// <summary>
+/// Runs blocking actions (launching programs, opening documents, etc.) on a
+/// small pool of worker threads so they don't stall the UI thread.
+/// <p>
+/// Each action is identified by a key; while an action is queued or running,
+/// further submissions with the same key are ignored, so a hotkey that is
+/// pressed repeatedly only launches its program once. When an action
+/// finishes, its result is queued and the notification callback is invoked
+/// (from the worker thread) so the owner can collect the results on its own
+/// thread with Completed().
+/// </summary>
+class ActionExecutor {
+public:
+    /// <summary>A blocking action; returns false if it failed.</summary>
+    typedef std::function<bool ()> Action;
+    typedef std::function<void ()> Notify;
+
+    struct Result {
+        std::wstring key;
+        bool success;
+    };
+
+    static const unsigned int DefaultThreads = 2;
+
+    ActionExecutor(Notify notify, unsigned int threads = DefaultThreads);
+
+    /// <summary>
+    /// Stops the worker threads. Actions that are still queued are
+    /// discarded; running actions are allowed to finish.
+    /// </summary>
+    ~ActionExecutor();
+
+    /// <summary>
+    /// Queues an action. Returns false if an action with the same key is
+    /// already queued or running.
+    /// </summary>
+    bool Submit(const std::wstring &key, Action action);
+
+    /// <summary>Determines whether an action is queued or running.</summary>
+    bool Busy(const std::wstring &key);
+
+    /// <summary>
+    /// Retrieves (and clears) the results of finished actions.
+    /// </summary>
+    std::vector<Result> Completed();
+
+private:
+    struct Job {
+        std::wstring key;
+        Action action;
+    };
+
+    Notify _notify;
+    bool _stop;
+
+    std::deque<Job> _queue;
+    std::unordered_set<std::wstring> _active;
+    std::vector<Result> _completed;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::thread> _threads;
+
+    void Worker();
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "AtomicWriter.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "StringUtils.h"
+
+AtomicWriter::AtomicWriter(unsigned int delay) :
+_delay(delay),
+_pending(false),
+_stop(false),
+_writing(false),
+_lastSuccess(true) {
+    _thread = std::thread(&AtomicWriter::WriterThread, this);
+}
+
+AtomicWriter::~AtomicWriter() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+
+    Flush();
+}
+
+void AtomicWriter::Schedule(const std::wstring &path,
+        const std::string &contents, Callback done) {
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_pending && _next.path != path) {
+            /* A different file is waiting; don't lose its contents. */
+            WriteNext(lock);
+        }
+
+        _next.path = path;
+        _next.contents = contents;
+        if (done) {
+            _next.callbacks.push_back(done);
+        }
+        _pending = true;
+        _deadline = std::chrono::steady_clock::now() + _delay;
+    }
+    _cv.notify_all();
+}
+
+bool AtomicWriter::Flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return WriteNext(lock);
+}
+
+void AtomicWriter::WriterThread() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        while (_stop == false && _pending == false) {
+            _cv.wait(lock);
+        }
+
+        if (_stop) {
+            /* The destructor flushes anything left over. */
+            return;
+        }
+
+        /* Wait until the contents stop changing for the debounce delay. The
+         * deadline moves each time a write is scheduled. */
+        while (_stop == false && _pending
+                && std::chrono::steady_clock::now() < _deadline) {
+            _cv.wait_until(lock, _deadline);
+        }
+
+        if (_stop || _pending == false) {
+            continue;
+        }
+
+        WriteNext(lock);
+    }
+}
+
+bool AtomicWriter::WriteNext(std::unique_lock<std::mutex> &lock) {
+    bool waited = _writing;
+    while (_writing) {
+        _cv.wait(lock);
+    }
+
+    bool success = (waited == false) || _lastSuccess;
+    if (_pending == false) {
+        return success;
+    }
+
+    Pending pending = _next;
+    _next = Pending();
+    _pending = false;
+    _writing = true;
+
+    lock.unlock();
+    bool written = Write(pending.path, pending.contents);
+    for (Callback &callback : pending.callbacks) {
+        callback(written);
+    }
+    lock.lock();
+
+    _writing = false;
+    _lastSuccess = written;
+    _cv.notify_all();
+    return success && written;
+}
+
+bool AtomicWriter::Write(const std::wstring &path,
+        const std::string &contents) {
+
+    std::wstring temp = path + L".tmp";
+
+#ifdef _WIN32
+    FILE *stream = NULL;
+    if (_wfopen_s(&stream, temp.c_str(), L"wb") != 0 || stream == NULL) {
+        return false;
+    }
+#else
+    std::string u8Temp = StringUtils::Narrow(temp);
+    std::string u8Path = StringUtils::Narrow(path);
+    FILE *stream = fopen(u8Temp.c_str(), "wb");
+    if (stream == NULL) {
+        return false;
+    }
+#endif
+
+    size_t written = fwrite(contents.data(), 1, contents.size(), stream);
+    bool success = (written == contents.size()) && (fflush(stream) == 0);
+
+    /* Make sure the data is on disk before the rename makes it visible */
+#ifdef _WIN32
+    success = success && (_commit(_fileno(stream)) == 0);
+#else
+    success = success && (fsync(fileno(stream)) == 0);
+#endif
+    success = (fclose(stream) == 0) && success;
+
+#ifdef _WIN32
+    if (success) {
+        success = MoveFileEx(temp.c_str(), path.c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+    }
+    if (success == false) {
+        DeleteFile(temp.c_str());
+    }
+#else
+    if (success) {
+        success = (rename(u8Temp.c_str(), u8Path.c_str()) == 0);
+    }
+    if (success == false) {
+        remove(u8Temp.c_str());
+    }
+#endif
+
+    return success;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Writes files so that a crash (or power loss) mid-write never leaves a
+/// partially-written file behind: the contents are written to a temporary
+/// file, flushed to disk, and then renamed over the original. Readers always
+/// see either the previous file or the new one.
+/// <p>
+/// Writes can also be scheduled on a background thread. Bursts of scheduled
+/// writes within the debounce delay are coalesced into a single write of the
+/// latest contents. Only one write is in flight at a time, so contents are
+/// written in the order they were scheduled.
+/// </summary>
+class AtomicWriter {
+public:
+    /// <summary>
+    /// Called (from the thread that performed the write) when a scheduled
+    /// write has finished. Callbacks must not schedule or flush writes.
+    /// </summary>
+    typedef std::function<void (bool success)> Callback;
+
+    /// <summary>Default debounce delay, in ms.</summary>
+    static const unsigned int DefaultDelay = 250;
+
+    AtomicWriter(unsigned int delay = DefaultDelay);
+
+    /// <summary>
+    /// Writes any pending contents and stops the writer thread.
+    /// </summary>
+    ~AtomicWriter();
+
+    /// <summary>
+    /// Schedules the contents to be written after the debounce delay. If a
+    /// write is already pending, its contents are replaced and the delay is
+    /// restarted; all callbacks are invoked once the write completes.
+    /// </summary>
+    void Schedule(const std::wstring &path, const std::string &contents,
+        Callback done = nullptr);
+
+    /// <summary>
+    /// Waits for a write in progress on the writer thread (and its
+    /// callbacks), then immediately writes any pending contents on the
+    /// calling thread. Returns false if either write failed.
+    /// </summary>
+    bool Flush();
+
+    /// <summary>Atomically replaces the file at path with contents.</summary>
+    static bool Write(const std::wstring &path, const std::string &contents);
+
+private:
+    struct Pending {
+        std::wstring path;
+        std::string contents;
+        std::vector<Callback> callbacks;
+    };
+
+    std::chrono::milliseconds _delay;
+    std::chrono::steady_clock::time_point _deadline;
+    bool _pending;
+    bool _stop;
+    Pending _next;
+
+    /// <summary>
+    /// Set while contents taken from _next are being written and their
+    /// callbacks run. No other contents are taken until it is cleared.
+    /// </summary>
+    bool _writing;
+    bool _lastSuccess;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+
+    void WriterThread();
+
+    /// <summary>
+    /// Waits for the write in progress to finish, then writes the pending
+    /// contents (if any) with the lock released. The lock must be held.
+    /// Returns false if either write failed.
+    /// </summary>
+    bool WriteNext(std::unique_lock<std::mutex> &lock);
+};
\ No newline at end of file
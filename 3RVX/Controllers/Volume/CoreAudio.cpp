@@ -1,6 +1,9 @@
+#define LOG_SUBSYSTEM Audio
+
 #include "CoreAudio.h"
 #include "Functiondiscoverykeys_devpkey.h"
 #include "../../Logger.h"
+#include "../../Trace.h"
 
 // {EC9CB649-7E84-4B42-B367-7FC39BE17806}
 static const GUID G3RVXCoreAudioEvent = { 0xec9cb649, 0x7e84, 0x4b42,
@@ -67,7 +70,7 @@ HRESULT CoreAudio::AttachDevice() {
             _registeredNotifications = SUCCEEDED(hr);
         }
     } else {
-        CLOG(L"Failed to find audio device!");
+        ELOG(L"Failed to find audio device!");
     }
 
     return hr;
@@ -274,6 +277,7 @@ float CoreAudio::Volume() {
 }
 
 void CoreAudio::Volume(float vol) {
+    TRACE_SPAN("CoreAudio::Volume");
     if (vol > 1.0f) {
         vol = 1.0f;
     }
@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM OSD
+
 #include "DisplayManager.h"
 
 #include <d3d9.h>
@@ -0,0 +1,30 @@
+#include "ElementIndex.h"
+
+#include <cstring>
+
+void ElementIndex::Build(tinyxml2::XMLElement *parent) {
+    _elements.clear();
+    if (parent == NULL) {
+        return;
+    }
+
+    tinyxml2::XMLElement *elem = parent->FirstChildElement();
+    for (; elem != NULL; elem = elem->NextSiblingElement()) {
+        if (Find(elem->Name()) == NULL) {
+            _elements.push_back(std::make_pair(elem->Name(), elem));
+        }
+    }
+}
+
+tinyxml2::XMLElement *ElementIndex::Find(const char *name) const {
+    for (const auto &element : _elements) {
+        if (strcmp(element.first, name) == 0) {
+            return element.second;
+        }
+    }
+    return NULL;
+}
+
+size_t ElementIndex::Size() const {
+    return _elements.size();
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "TinyXml2/tinyxml2.h"
+
+/// <summary>
+/// Index of an element's children by name, such as the OSDs and sliders of
+/// a skin. These lists hold a handful of elements, so they are scanned in
+/// order and the names are compared in place (they point into the
+/// document); this is faster than hashing and doesn't allocate a key for
+/// each lookup. The index is valid as long as the document it was built
+/// from.
+/// </summary>
+class ElementIndex {
+public:
+    /// <summary>
+    /// Indexes the child elements of the given parent, which may be NULL.
+    /// Only the first element with a given name is used.
+    /// </summary>
+    void Build(tinyxml2::XMLElement *parent);
+
+    /// <summary>
+    /// Retrieves the child element with the given name, or NULL if there is
+    /// no such element.
+    /// </summary>
+    tinyxml2::XMLElement *Find(const char *name) const;
+
+    size_t Size() const;
+
+private:
+    std::vector<std::pair<const char *, tinyxml2::XMLElement *>> _elements;
+};
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "HookLatency.h"
+
+#include <sstream>
+
+HookLatency::HookLatency(unsigned int budgetUs) {
+    _budget.store(budgetUs);
+    Reset();
+}
+
+bool HookLatency::Record(unsigned long long us) {
+    _buckets[Bucket(us)].fetch_add(1, std::memory_order_relaxed);
+    _samples.fetch_add(1, std::memory_order_relaxed);
+
+    unsigned long long max = _max.load(std::memory_order_relaxed);
+    while (us > max
+        && _max.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+        /* Another thread may have raised the max; loop until we win or
+         * the current max is larger than this sample. */
+    }
+
+    if (us > _budget.load(std::memory_order_relaxed)) {
+        _exceeded.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void HookLatency::Reset() {
+    for (int i = 0; i < Buckets; ++i) {
+        _buckets[i].store(0);
+    }
+    _samples.store(0);
+    _exceeded.store(0);
+    _max.store(0);
+}
+
+unsigned int HookLatency::Budget() const {
+    return _budget.load();
+}
+
+void HookLatency::Budget(unsigned int budgetUs) {
+    _budget.store(budgetUs);
+}
+
+unsigned int HookLatency::Samples() const {
+    return _samples.load();
+}
+
+unsigned int HookLatency::Exceeded() const {
+    return _exceeded.load();
+}
+
+unsigned long long HookLatency::Max() const {
+    return _max.load();
+}
+
+unsigned int HookLatency::Count(int bucket) const {
+    if (bucket < 0 || bucket >= Buckets) {
+        return 0;
+    }
+    return _buckets[bucket].load();
+}
+
+unsigned long long HookLatency::Percentile(double p) const {
+    unsigned int samples = Samples();
+    if (samples == 0) {
+        return 0;
+    }
+
+    unsigned long long target = (unsigned long long) (p * samples + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+
+    unsigned long long seen = 0;
+    for (int i = 0; i < Buckets; ++i) {
+        seen += Count(i);
+        if (seen >= target) {
+            return BucketLimit(i);
+        }
+    }
+
+    return BucketLimit(Buckets - 1);
+}
+
+unsigned long long HookLatency::BucketLimit(int bucket) {
+    return 1ULL << bucket;
+}
+
+int HookLatency::Bucket(unsigned long long us) {
+    int bucket = 0;
+    while (us > 0 && bucket < Buckets - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+unsigned int HookLatency::BudgetFor(unsigned int timeoutMs) {
+    return timeoutMs * 1000 / BudgetDivisor;
+}
+
+std::wstring HookLatency::ToString() const {
+    std::wstringstream ss;
+    ss << L"Events: " << Samples();
+    ss << L"; over budget (" << Budget() << L" us): " << Exceeded();
+    ss << L"; max: " << Max() << L" us" << std::endl;
+    ss << L"p50: <" << Percentile(0.50) << L" us; ";
+    ss << L"p99: <" << Percentile(0.99) << L" us";
+
+    for (int i = 0; i < Buckets; ++i) {
+        unsigned int count = Count(i);
+        if (count == 0) {
+            continue;
+        }
+        ss << std::endl << L"  < " << BucketLimit(i) << L" us: " << count;
+    }
+
+    return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+/// <summary>
+/// Records how long the low-level input hooks take to process each event.
+/// Windows silently removes low-level hooks that exceed the
+/// LowLevelHooksTimeout, so the hooks time themselves and report here.
+/// <p>
+/// Samples are stored in a histogram of power-of-two microsecond buckets.
+/// Recording a sample only performs atomic increments, so it is safe to call
+/// from the hook thread while another thread reads or logs the statistics.
+/// </summary>
+class HookLatency {
+public:
+    HookLatency(unsigned int budgetUs = DefaultBudget);
+
+    /// <summary>
+    /// Records a single hook event that took the given number of microseconds
+    /// to process. Returns true if the event exceeded the latency budget.
+    /// </summary>
+    bool Record(unsigned long long us);
+
+    /// <summary>Clears all recorded samples.</summary>
+    void Reset();
+
+    /// <summary>Retrieves the latency budget, in microseconds.</summary>
+    unsigned int Budget() const;
+    /// <summary>Sets the latency budget, in microseconds.</summary>
+    void Budget(unsigned int budgetUs);
+
+    /// <summary>Number of events recorded.</summary>
+    unsigned int Samples() const;
+    /// <summary>Number of events that exceeded the latency budget.</summary>
+    unsigned int Exceeded() const;
+    /// <summary>Longest event recorded, in microseconds.</summary>
+    unsigned long long Max() const;
+    /// <summary>Number of events recorded in the given bucket.</summary>
+    unsigned int Count(int bucket) const;
+
+    /// <summary>
+    /// Estimates the given percentile (0 - 1.0) from the histogram. The value
+    /// returned is the upper limit of the bucket the percentile falls in.
+    /// </summary>
+    unsigned long long Percentile(double p) const;
+
+    /// <summary>
+    /// Retrieves the exclusive upper limit (in microseconds) of the given
+    /// bucket. Bucket 0 holds samples below 1 us, bucket 1 holds samples
+    /// below 2 us, bucket 2 below 4 us, and so on.
+    /// </summary>
+    static unsigned long long BucketLimit(int bucket);
+
+    /// <summary>
+    /// Computes the latency budget (in microseconds) for the given hook
+    /// timeout (in ms). The budget is a fraction of the timeout, so events
+    /// that come close to getting the hook removed are counted and can
+    /// trigger a re-hook before Windows gives up on the hook entirely.
+    /// </summary>
+    static unsigned int BudgetFor(unsigned int timeoutMs);
+
+    /// <summary>
+    /// Retrieves the histogram as a multi-line string suitable for logging.
+    /// Empty buckets are omitted.
+    /// </summary>
+    std::wstring ToString() const;
+
+public:
+    static const int Buckets = 24;
+
+    /// <summary>
+    /// LowLevelHooksTimeout used by Windows when none is configured, in ms.
+    /// </summary>
+    static const unsigned int DefaultTimeout = 300;
+
+    /// <summary>The budget is 1/BudgetDivisor of the hook timeout.</summary>
+    static const unsigned int BudgetDivisor = 4;
+
+    static const unsigned int DefaultBudget
+        = DefaultTimeout * 1000 / BudgetDivisor;
+
+private:
+    std::atomic<unsigned int> _buckets[Buckets];
+    std::atomic<unsigned int> _samples;
+    std::atomic<unsigned int> _exceeded;
+    std::atomic<unsigned long long> _max;
+    std::atomic<unsigned int> _budget;
+
+    static int Bucket(unsigned long long us);
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "HotkeyAction.h"
+
+#include <cwctype>
+
+HotkeyAction::HotkeyAction() :
+keyCombination(0),
+action((HotkeyInfo::HotkeyActions) -1) {
+    volume.type = HotkeyInfo::NoArgs;
+    volume.units = 0;
+    volume.amount = 0.0f;
+}
+
+HotkeyAction::HotkeyAction(HotkeyInfo &hki) :
+keyCombination(hki.keyCombination),
+action((HotkeyInfo::HotkeyActions) hki.action) {
+    volume.type = HotkeyInfo::NoArgs;
+    volume.units = 0;
+    volume.amount = 0.0f;
+
+    switch (action) {
+    case HotkeyInfo::IncreaseVolume:
+    case HotkeyInfo::DecreaseVolume:
+    case HotkeyInfo::SetVolume:
+        CompileVolume(hki);
+        break;
+
+    case HotkeyInfo::EjectDrive:
+        CompileEject(hki);
+        break;
+
+    case HotkeyInfo::MediaKey:
+        CompileMediaKey(hki);
+        break;
+
+    case HotkeyInfo::VirtualKey:
+        CompileVirtualKey(hki);
+        break;
+
+    case HotkeyInfo::Run:
+        if (hki.HasArgs()) {
+            target = hki.args[0];
+        }
+        break;
+
+    default:
+        /* No arguments */
+        break;
+    }
+}
+
+void HotkeyAction::CompileVolume(HotkeyInfo &hki) {
+    HotkeyInfo::VolumeKeyArgTypes type = HotkeyInfo::VolumeArgType(hki);
+    int sign = (action == HotkeyInfo::DecreaseVolume) ? -1 : 1;
+
+    if (type == HotkeyInfo::Percentage) {
+        volume.type = HotkeyInfo::Percentage;
+        volume.amount = sign * (float) hki.ArgToDouble(0) / 100.0f;
+        return;
+    }
+
+    if (type == HotkeyInfo::NoArgs && action == HotkeyInfo::SetVolume) {
+        /* Nothing to set the volume to */
+        return;
+    }
+
+    volume.type = HotkeyInfo::Units;
+    if (type == HotkeyInfo::Units) {
+        volume.units = sign * hki.ArgToInt(0);
+    } else {
+        /* Increment/decrement by one unit by default */
+        volume.units = sign;
+    }
+}
+
+void HotkeyAction::CompileMediaKey(HotkeyInfo &hki) {
+    vk = 0;
+    if (hki.args.size() != 1) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < HotkeyInfo::MediaKeyNames.size(); ++i) {
+        if (HotkeyInfo::MediaKeyNames[i] == hki.args[0]) {
+            vk = HotkeyInfo::MediaKeyVKs[i];
+            return;
+        }
+    }
+}
+
+void HotkeyAction::CompileVirtualKey(HotkeyInfo &hki) {
+    vk = 0;
+    if (hki.args.size() != 1) {
+        return;
+    }
+
+    vk = (unsigned short) hki.HexArgToInt(0);
+}
+
+void HotkeyAction::CompileEject(HotkeyInfo &hki) {
+    drive = 0;
+    if (hki.HasArgs() == false || hki.args[0].empty()) {
+        return;
+    }
+
+    wchar_t letter = (wchar_t) std::towupper(hki.args[0][0]);
+    if (letter >= L'A' && letter <= L'Z') {
+        drive = letter;
+    }
+}
+
+bool HotkeyAction::Valid() const {
+    switch (action) {
+    case HotkeyInfo::MediaKey:
+    case HotkeyInfo::VirtualKey:
+        return vk != 0;
+
+    case HotkeyInfo::EjectDrive:
+        return drive != 0;
+
+    case HotkeyInfo::Run:
+        return target.empty() == false;
+
+    default:
+        break;
+    }
+
+    return action >= 0 && action <= HotkeyInfo::RecordTrace;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+
+#include "HotkeyInfo.h"
+
+/// <summary>
+/// A hotkey action that has been compiled from its HotkeyInfo representation.
+/// HotkeyInfo stores its arguments as strings so they can be edited and
+/// persisted; this class parses and validates them once (when the hotkeys are
+/// loaded) so that dispatching a hotkey does no string parsing or lookups.
+/// <p>
+/// Only the fields relevant to the action are populated.
+/// </summary>
+class HotkeyAction {
+public:
+    HotkeyAction();
+
+    /// <summary>Compiles the given hotkey into its typed action.</summary>
+    HotkeyAction(HotkeyInfo &hki);
+
+    int keyCombination;
+    HotkeyInfo::HotkeyActions action;
+
+    struct VolumeArgs {
+        /// <summary>
+        /// Units or Percentage; NoArgs is only used by SetVolume hotkeys that
+        /// have no target level.
+        /// </summary>
+        HotkeyInfo::VolumeKeyArgTypes type;
+
+        /// <summary>
+        /// Volume units to change by (negative for DecreaseVolume), or the
+        /// number of units to set the volume to.
+        /// </summary>
+        int units;
+
+        /// <summary>
+        /// Volume amount (0 - 1.0) to change by (negative for DecreaseVolume)
+        /// or to set the volume to.
+        /// </summary>
+        float amount;
+    };
+
+    union {
+        /// <summary>IncreaseVolume, DecreaseVolume, SetVolume</summary>
+        VolumeArgs volume;
+
+        /// <summary>
+        /// MediaKey, VirtualKey: virtual key code to simulate; 0 if invalid.
+        /// </summary>
+        unsigned short vk;
+
+        /// <summary>EjectDrive: drive letter (A - Z); 0 if invalid.</summary>
+        wchar_t drive;
+    };
+
+    /// <summary>Run: the file, folder, or URL to open.</summary>
+    std::wstring target;
+
+    bool Valid() const;
+
+private:
+    void CompileVolume(HotkeyInfo &hki);
+    void CompileMediaKey(HotkeyInfo &hki);
+    void CompileVirtualKey(HotkeyInfo &hki);
+    void CompileEject(HotkeyInfo &hki);
+};
\ No newline at end of file
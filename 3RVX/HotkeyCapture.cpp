@@ -0,0 +1,58 @@
+#include "HotkeyCapture.h"
+
+HotkeyCapture::HotkeyCapture() {
+    Reset();
+}
+
+void HotkeyCapture::Reset() {
+    _keyCombination = 0;
+    _sequence.clear();
+    _holdTime = 0;
+    _lastKeys = 0;
+    _pressTime = 0;
+}
+
+bool HotkeyCapture::KeyDown(int keys, unsigned int time) {
+    if (keys == _lastKeys) {
+        /* Auto-repeat: the key is being held down. Holding the last key of
+         * the sequence makes this a press-and-hold hotkey. */
+        if (time - _pressTime >= HoldCaptureTime) {
+            _holdTime = HotkeyMatcher::DefaultHoldTime;
+            return true;
+        }
+        return false;
+    }
+
+    if (_keyCombination == 0) {
+        _keyCombination = keys;
+    } else {
+        _sequence.push_back(keys);
+    }
+    _lastKeys = keys;
+    _pressTime = time;
+    return false;
+}
+
+void HotkeyCapture::KeyUp(unsigned int vk) {
+    if ((unsigned int) (_lastKeys & 0xFF) == vk) {
+        _lastKeys = 0;
+    }
+}
+
+void HotkeyCapture::Mouse(int keys) {
+    if (_keyCombination == 0) {
+        _keyCombination = keys;
+    }
+}
+
+int HotkeyCapture::KeyCombination() const {
+    return _keyCombination;
+}
+
+std::vector<int> HotkeyCapture::Sequence() const {
+    return _sequence;
+}
+
+unsigned int HotkeyCapture::HoldTime() const {
+    return _holdTime;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include "HotkeyMatcher.h"
+
+/// <summary>
+/// Decides what hotkey the user entered in the hotkey prompt. Combinations
+/// pressed in quick succession form a multi-key sequence, and holding the
+/// last combination down well past the hold time makes it a press-and-hold
+/// hotkey. Like HotkeyMatcher, this has no Win32 dependencies; KeyGrabber
+/// feeds it the events from its hook.
+/// </summary>
+class HotkeyCapture {
+public:
+    /// <summary>
+    /// How long (in ms) a key must be held to capture a press-and-hold
+    /// hotkey. This is longer than the hold time itself so that a slow press
+    /// isn't mistaken for a hold.
+    /// </summary>
+    static const unsigned int HoldCaptureTime
+        = 3 * HotkeyMatcher::DefaultHoldTime;
+
+    HotkeyCapture();
+
+    void Reset();
+
+    /// <summary>
+    /// Processes a key press (the combination with the modifiers held down)
+    /// at the given time, in ms. Auto-repeat presses the same combination
+    /// again. Returns true if the capture is finished.
+    /// </summary>
+    bool KeyDown(int keys, unsigned int time);
+
+    /// <summary>Processes the release of a (non-modifier) key.</summary>
+    void KeyUp(unsigned int vk);
+
+    /// <summary>
+    /// Records a mouse combination, which can't be part of a sequence; it is
+    /// ignored if a key combination was already captured. The capture is
+    /// finished.
+    /// </summary>
+    void Mouse(int keys);
+
+    int KeyCombination() const;
+    std::vector<int> Sequence() const;
+    unsigned int HoldTime() const;
+
+private:
+    int _keyCombination;
+    std::vector<int> _sequence;
+    unsigned int _holdTime;
+
+    /* The last combination pressed, while it is being held down */
+    int _lastKeys;
+    unsigned int _pressTime;
+};
\ No newline at end of file
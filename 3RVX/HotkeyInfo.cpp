@@ -1,9 +1,15 @@
+#define LOG_SUBSYSTEM Hotkeys
+
 #include "HotkeyInfo.h"
 
 #include <exception>
+#include <sstream>
 #include <string>
 
+#ifdef _WIN32
 #include "HotkeyManager.h"
+#endif
+#include "HotkeyMatcher.h"
 #include "Logger.h"
 
 std::vector<std::wstring> HotkeyInfo::ActionNames = {
@@ -19,6 +25,7 @@ std::vector<std::wstring> HotkeyInfo::ActionNames = {
     L"Run",
     L"Open Settings Dialog",
     L"Exit 3RVX",
+    L"Start/Stop Trace",
 };
 
 std::vector<std::wstring> HotkeyInfo::MediaKeyNames = {
@@ -28,15 +35,17 @@ std::vector<std::wstring> HotkeyInfo::MediaKeyNames = {
     L"Previous",
 };
 
+/* VK_MEDIA_PLAY_PAUSE, VK_MEDIA_STOP, VK_MEDIA_NEXT_TRACK, and
+ * VK_MEDIA_PREV_TRACK; the values are spelled out so this file doesn't
+ * depend on the Windows headers. */
 std::vector<unsigned short> HotkeyInfo::MediaKeyVKs = {
-    VK_MEDIA_PLAY_PAUSE,
-    VK_MEDIA_STOP,
-    VK_MEDIA_NEXT_TRACK,
-    VK_MEDIA_PREV_TRACK,
+    0xB3,
+    0xB2,
+    0xB0,
+    0xB1,
 };
 
-HotkeyInfo::HotkeyInfo() :
-_cache(false) {
+HotkeyInfo::HotkeyInfo() {
 
 }
 
@@ -55,56 +64,35 @@ HotkeyInfo::VolumeKeyArgTypes HotkeyInfo::VolumeArgType(HotkeyInfo &hki) {
 }
 
 int HotkeyInfo::ArgToInt(unsigned int argIdx) {
-    if (_cache && _intArgs.count(argIdx) > 0) {
-        return _intArgs[argIdx];
-    }
-
     int i;
     try {
         i = std::stoi(args[argIdx]);
-    } catch (std::exception e) {
+    } catch (const std::exception &) {
         i = 0;
     }
 
-    if (_cache) {
-        _intArgs[argIdx] = i;
-    }
     return i;
 }
 
 double HotkeyInfo::ArgToDouble(unsigned int argIdx) {
-    if (_cache && _doubleArgs.count(argIdx) > 0) {
-        return _doubleArgs[argIdx];
-    }
-
     double d;
     try {
         d = std::stod(args[argIdx]);
-    } catch (std::exception e) {
+    } catch (const std::exception &) {
         d = 0;
     }
 
-    if (_cache) {
-        _doubleArgs[argIdx] = d;
-    }
     return d;
 }
 
 int HotkeyInfo::HexArgToInt(unsigned int argIdx) {
-    if (_cache && _intArgs.count(argIdx) > 0) {
-        return _intArgs[argIdx];
-    }
-
     int i;
     try {
         i = std::stoi(args[argIdx], nullptr, 16);
-    } catch (std::exception e) {
+    } catch (const std::exception &) {
         i = 0;
     }
 
-    if (_cache) {
-        _intArgs[argIdx] = i;
-    }
     return i;
 }
 
@@ -120,6 +108,16 @@ bool HotkeyInfo::HasArg(unsigned int argIdx) {
     return args.size() - 1 >= argIdx;
 }
 
+bool HotkeyInfo::IsSequence() {
+    return sequence.empty() == false || holdTime > 0;
+}
+
+std::vector<int> HotkeyInfo::Steps() {
+    std::vector<int> steps(1, keyCombination);
+    steps.insert(steps.end(), sequence.begin(), sequence.end());
+    return steps;
+}
+
 void HotkeyInfo::AllocateArg(unsigned int argIdx) {
     unsigned int newSize = argIdx + 1;
     if (args.size() >= newSize) {
@@ -128,30 +126,32 @@ void HotkeyInfo::AllocateArg(unsigned int argIdx) {
     args.resize(newSize);
 }
 
-void HotkeyInfo::EnableArgCache() {
-    _cache = true;
-}
-
-void HotkeyInfo::DisableArgCache() {
-    _cache = false;
-}
-
-void HotkeyInfo::ClearArgCache() {
-    _intArgs.clear();
-    _doubleArgs.clear();
-}
-
 bool HotkeyInfo::Valid() {
     if (keyCombination <= 0) {
         LogInvalid(L"No key combination");
         return false;
     }
     
-    if (action < 0 || action > (int) ActionNames.size()) {
+    if (action < 0 || action >= (int) ActionNames.size()) {
         LogInvalid(L"Invalid action");
         return false;
     }
 
+    if (IsSequence()) {
+        for (int step : Steps()) {
+            if (step <= 0) {
+                LogInvalid(L"Invalid key sequence");
+                return false;
+            }
+
+            if (HotkeyMatcher::IsMouseKey(step & 0xFF)
+                    || HotkeyMatcher::IsMouseKey(step)) {
+                LogInvalid(L"Mouse buttons can't be used in key sequences");
+                return false;
+            }
+        }
+    }
+
     switch (action) {
     case HotkeyInfo::IncreaseVolume:
     case HotkeyInfo::DecreaseVolume:
@@ -201,11 +201,24 @@ bool HotkeyInfo::Valid() {
 }
 
 void HotkeyInfo::LogInvalid(std::wstring reason) {
-    CLOG(L"Invalid hotkey: %s\n%s", ToString().c_str(), reason.c_str());
+    WLOG(L"Invalid hotkey: %s\n%s", ToString().c_str(), reason.c_str());
+}
+
+std::wstring HotkeyInfo::KeysToString() {
+    std::wstring str = KeyString(keyCombination);
+    for (int step : sequence) {
+        str += L", " + KeyString(step);
+    }
+
+    if (holdTime > 0) {
+        str += L" (Hold)";
+    }
+
+    return str;
 }
 
 std::wstring HotkeyInfo::ToString() {
-    std::wstring combination = HotkeyManager::HotkeysToString(keyCombination);
+    std::wstring combination = KeysToString();
     std::wstring act = L"(none)";
     if (action >= 0 && (unsigned int) action < ActionNames.size()) {
         act = ActionNames[action];
@@ -217,3 +230,13 @@ std::wstring HotkeyInfo::ToString() {
     return combination + L" -> " + act + L" [ " + argStrs + L"]";
 }
 
+std::wstring HotkeyInfo::KeyString(int combination) {
+#ifdef _WIN32
+    return HotkeyManager::HotkeysToString(combination);
+#else
+    /* Key names come from the keyboard layout, which only Windows has */
+    std::wstringstream ss;
+    ss << L"0x" << std::hex << combination;
+    return ss.str();
+#endif
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <string>
 #include <vector>
 
 class HotkeyInfo {
@@ -18,6 +18,7 @@ public:
         Run,
         Settings,
         Exit,
+        RecordTrace,
     };
     static std::vector<std::wstring> ActionNames;
 
@@ -46,15 +47,36 @@ public:
     int action = -1;
     std::vector<std::wstring> args;
 
+    /// <summary>
+    /// Key combinations that must follow keyCombination (in order) to
+    /// complete a multi-key sequence. Empty for single-combination hotkeys.
+    /// </summary>
+    std::vector<int> sequence;
+
+    /// <summary>
+    /// If nonzero, the final key combination must be held down for this
+    /// many milliseconds to trigger the hotkey.
+    /// </summary>
+    unsigned int holdTime = 0;
+
+    /// <summary>
+    /// Determines whether this hotkey must be matched by the keyboard hook
+    /// (a multi-key sequence or press-and-hold hotkey).
+    /// </summary>
+    bool IsSequence();
+
+    /// <summary>Retrieves all the key combinations, in order.</summary>
+    std::vector<int> Steps();
+
     /// <summary>
     /// Retrieves the argument at the given index and converts it to an integer.
-    /// Subsequent calls that specify the same index will be cached.
+    /// Arguments are parsed on each call; hotkeys that will be dispatched
+    /// should be compiled to a HotkeyAction instead.
     /// </summary>
     int ArgToInt(unsigned int argIdx);
 
     /// <summary>
     /// Retrieves the argument at the given index and converts it to a double.
-    /// Subsequent calls that specify the same index will be cached.
     /// </summary>
     double ArgToDouble(unsigned int argIdx);
 
@@ -68,18 +90,17 @@ public:
     bool HasArg(unsigned int argIdx);
     void AllocateArg(unsigned int argIdx);
 
-    void EnableArgCache();
-    void DisableArgCache();
-    void ClearArgCache();
-
     bool Valid();
 
+    std::wstring KeysToString();
     std::wstring ToString();
 
 private:
-    bool _cache;
-    std::map<int, int> _intArgs;
-    std::map<int, double> _doubleArgs;
-
     void LogInvalid(std::wstring reason);
+
+    /// <summary>
+    /// Retrieves the name of a key combination (HotkeyManager::HotkeysToString
+    /// on Windows).
+    /// </summary>
+    static std::wstring KeyString(int combination);
 };
\ No newline at end of file
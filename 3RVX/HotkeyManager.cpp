@@ -1,7 +1,11 @@
+#define LOG_SUBSYSTEM Hotkeys
+
 #include "HotkeyManager.h"
 
+#include "3RVX.h"
 #include "Logger.h"
 #include "SyntheticKeyboard.h"
+#include "Trace.h"
 
 HotkeyManager *HotkeyManager::instance = NULL;
 
@@ -20,8 +24,15 @@ HotkeyManager *HotkeyManager::Instance(HWND notifyWnd) {
 }
 
 HotkeyManager::HotkeyManager() :
-_fixWin(false) {
-
+_fixWin(false),
+_nextSequence(HKM_SEQUENCE_BASE),
+_rehookPending(false),
+_replayPending(false) {
+    QueryPerformanceFrequency(&_perfFreq);
+
+    unsigned int budget = HookLatency::BudgetFor(HookTimeout());
+    _keyLatency.Budget(budget);
+    _mouseLatency.Budget(budget);
 }
 
 HotkeyManager::~HotkeyManager() {
@@ -33,9 +44,10 @@ HotkeyManager::~HotkeyManager() {
             break;
         }
     }
-    _hookCombinations.clear();
+    _hookCombinations.Clear();
 
     Unhook();
+    LogLatency();
 }
 
 void HotkeyManager::Shutdown() {
@@ -59,6 +71,42 @@ bool HotkeyManager::Unhook() {
     return unMouse && unKey;
 }
 
+bool HotkeyManager::Rehook() {
+    CLOG(L"Re-installing input hooks");
+    LogLatency();
+    _rehookPending = false;
+    Unhook();
+    return Hook();
+}
+
+const HookLatency &HotkeyManager::KeyboardLatency() {
+    return _keyLatency;
+}
+
+const HookLatency &HotkeyManager::MouseLatency() {
+    return _mouseLatency;
+}
+
+void HotkeyManager::LogLatency() {
+    CLOG(L"Keyboard hook latency:\n%s", _keyLatency.ToString().c_str());
+    CLOG(L"Mouse hook latency:\n%s", _mouseLatency.ToString().c_str());
+}
+
+void HotkeyManager::RecordLatency(HookLatency &latency, LARGE_INTEGER &start) {
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&end);
+    unsigned long long us = (end.QuadPart - start.QuadPart) * 1000000
+        / _perfFreq.QuadPart;
+
+    if (latency.Record(us) && _rehookPending == false) {
+        /* We may have been removed from the hook chain. The hook can't be
+         * re-installed from within the hook procedure, so ask the notification
+         * window to do it. */
+        _rehookPending = true;
+        PostMessage(_notifyWnd, WM_3RVX_CONTROL, MSG_REHOOK, NULL);
+    }
+}
+
 void HotkeyManager::Register(int keyCombination) {
     if (_keyCombinations.count(keyCombination) > 0) {
         CLOG(L"Hotkey combination [%d] already registered", keyCombination);
@@ -80,13 +128,22 @@ void HotkeyManager::Register(int keyCombination) {
         return;
     }
 
+    if (_hookCombinations.IsPrefix(keyCombination)) {
+        /* This combination also begins a sequence, so the hook will see it
+         * before Windows does. */
+        CLOG(L"Hotkey [%d] begins a sequence; placing in hook list",
+            keyCombination);
+        _hookCombinations.Add(keyCombination);
+        return;
+    }
+
     /* keyboard-only hotkeys; use WinAPI */
     int mods = (0xF0000 & keyCombination) >> 16;
     if (!RegisterHotKey(_notifyWnd, keyCombination, mods, vk)) {
-        CLOG(L"Failed to register hotkey [%d]\n"
+        WLOG(L"Failed to register hotkey [%d]\n"
             L"Mods: %d, VK: %d\n"
             L"Placing in hook list", keyCombination, mods, vk);
-        _hookCombinations.insert(keyCombination);
+        _hookCombinations.Add(keyCombination);
         return;
     }
 
@@ -103,64 +160,146 @@ bool HotkeyManager::Unregister(int keyCombination) {
     }
 
     _keyCombinations.erase(keyCombination);
+    if (_hookCombinations.Contains(keyCombination)) {
+        /* Handled by the hook; it was never registered with Windows (or was
+         * unregistered when a sequence started with it). */
+        _hookCombinations.Remove(keyCombination);
+        return true;
+    }
+
     if ((keyCombination >> 20) == 0) {
         /* This hotkey isn't mouse-based; unregister with Windows */
         if (!UnregisterHotKey(_notifyWnd, keyCombination)) {
-            CLOG(L"Failed to unregister hotkey: %d", keyCombination);
+            WLOG(L"Failed to unregister hotkey: %d", keyCombination);
             return false;
         }
     }
     return true;
 }
 
+int HotkeyManager::RegisterSequence(const std::vector<int> &steps,
+        unsigned int holdTime) {
+
+    if (steps.empty()) {
+        return 0;
+    }
+
+    for (int keys : steps) {
+        if (IsMouseKey(keys & 0xFF) || IsMouseKey(keys)) {
+            CLOG(L"Mouse-based combinations can't be used in sequences");
+            return 0;
+        }
+    }
+
+    int first = steps[0];
+    if (_keyCombinations.count(first) > 0
+            && _hookCombinations.Contains(first) == false) {
+        /* The first step was registered with Windows; move it to the hook so
+         * it doesn't prevent the rest of the sequence from being seen. */
+        UnregisterHotKey(_notifyWnd, first);
+        _hookCombinations.Add(first);
+    }
+
+    int binding = _nextSequence++;
+    _hookCombinations.Add(steps, binding, holdTime);
+    CLOG(L"Registered new key sequence [%d]: %d step(s), hold: %d ms",
+        binding, (int) steps.size(), holdTime);
+    return binding;
+}
+
+bool HotkeyManager::UnregisterSequence(int binding) {
+    CLOG(L"Unregistering key sequence: %d", binding);
+
+    if (_hookCombinations.Contains(binding) == false) {
+        QCLOG(L"Key sequence [%d] was not previously registered", binding);
+        return false;
+    }
+
+    _hookCombinations.Remove(binding);
+    return true;
+}
+
+void HotkeyManager::Replay() {
+    _replayPending = false;
+    for (int keys : _hookCombinations.TakeReplay()) {
+        CLOG(L"Replaying swallowed keys: %d", keys);
+        SyntheticKeyboard::SimulateCombination(keys, ReplayTag);
+    }
+}
+
+void HotkeyManager::QueueReplay() {
+    if (_replayPending || _hookCombinations.ReplayPending() == false) {
+        return;
+    }
+
+    /* As with FixWin, input isn't synthesized from inside the hook */
+    _replayPending = true;
+    PostMessage(_notifyWnd, WM_3RVX_CONTROL, MSG_REPLAY, NULL);
+}
+
 LRESULT CALLBACK
 HotkeyManager::KeyProc(int nCode, WPARAM wParam, LPARAM lParam) {
+    TRACE_SPAN("HotkeyManager::KeyProc");
     if (nCode >= 0) {
+        KBDLLHOOKSTRUCT *kbInfo = (KBDLLHOOKSTRUCT *) lParam;
+
+        if (kbInfo->dwExtraInfo == ReplayTag) {
+            /* Keys we swallowed and are now sending on (see Replay) */
+            return CallNextHookEx(NULL, nCode, wParam, lParam);
+        }
+
         if (wParam == WM_KEYUP) {
-            KBDLLHOOKSTRUCT *kbInfo = (KBDLLHOOKSTRUCT *) lParam;
             if ((kbInfo->vkCode == VK_LWIN || kbInfo->vkCode == VK_RWIN)
                 && _fixWin) {
                 /* WIN+Mouse combination used; we need to prevent the
                  * system from only seeing a WIN keypress (and usually
-                 * popping up the start menu).  We simulate WIN+VK_NONAME. */
-                SyntheticKeyboard::SimulateKeypress(VK_NONAME, false);
+                 * popping up the start menu). Synthesizing input from inside
+                 * the hook could push us past the hook timeout, so we eat
+                 * the WIN release and let the notification window simulate
+                 * WIN+VK_NONAME and then release WIN (see FixWin). */
                 _fixWin = false;
-                return CallNextHookEx(NULL, nCode, wParam, lParam);
+                PostMessage(_notifyWnd, WM_3RVX_CONTROL,
+                    MSG_FIXWIN, kbInfo->vkCode);
+                return (LRESULT) 1;
             }
         }
 
-        if (_hookCombinations.size() <= 0) {
+        if (_hookCombinations.Empty()) {
             return CallNextHookEx(NULL, nCode, wParam, lParam);
         }
 
         if (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN) {
-            KBDLLHOOKSTRUCT *kbInfo = (KBDLLHOOKSTRUCT *) lParam;
-
             DWORD vk = kbInfo->vkCode;
             int mods = HotkeyManager::IsModifier(vk);
 
-            if (mods) {
-                _modifiers |= mods;
-                return CallNextHookEx(NULL, nCode, wParam, lParam);
-            } else {
-                /* Is this an extended key? */
-                int ext = (kbInfo->flags & 0x1) << EXT_OFFSET;
-                int keys = _modifiers | ext | vk;
-                if (_hookCombinations.count(keys) > 0) {
-                    SendMessage(_notifyWnd, WM_HOTKEY,
-                        keys, _modifiers >> MOD_OFFSET);
-                    return (LRESULT) 1;
-                }
+            /* Is this an extended key? */
+            bool ext = (kbInfo->flags & 0x1) > 0;
+            int binding = _hookCombinations.KeyDown(
+                vk, ext, mods, kbInfo->time);
+            QueueReplay();
+            if (binding > 0) {
+                /* Queue the hotkey for the notification window rather than
+                 * processing it synchronously; the hook returns immediately */
+                PostMessage(_notifyWnd, WM_HOTKEY,
+                    binding, _hookCombinations.Modifiers() >> MOD_OFFSET);
+                return (LRESULT) 1;
+            }
+
+            if (binding == HotkeyMatcher::Consumed) {
+                /* Part of a sequence or a key being held */
+                return (LRESULT) 1;
             }
         }
 
         if (wParam == WM_KEYUP || wParam == WM_SYSKEYUP) {
-            KBDLLHOOKSTRUCT *kbInfo = (KBDLLHOOKSTRUCT *) lParam;
             int m = HotkeyManager::IsModifier(kbInfo->vkCode);
-            if (m) {
-                _modifiers ^= m;
+            int binding = _hookCombinations.KeyUp(
+                kbInfo->vkCode, m, kbInfo->time);
+            QueueReplay();
+            if (binding > 0) {
+                PostMessage(_notifyWnd, WM_HOTKEY,
+                    binding, _hookCombinations.Modifiers() >> MOD_OFFSET);
             }
-            return CallNextHookEx(NULL, nCode, wParam, lParam);
         }
     }
 
@@ -234,12 +373,20 @@ HotkeyManager::MouseProc(int nCode, WPARAM wParam, LPARAM lParam) {
 
 LRESULT CALLBACK
 HotkeyManager::LowLevelMouseProc(int nCode, WPARAM wParam, LPARAM lParam) {
-    return HotkeyManager::instance->MouseProc(nCode, wParam, lParam);
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+    LRESULT result = instance->MouseProc(nCode, wParam, lParam);
+    instance->RecordLatency(instance->_mouseLatency, start);
+    return result;
 }
 
 LRESULT CALLBACK
 HotkeyManager::LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam) {
-    return HotkeyManager::instance->KeyProc(nCode, wParam, lParam);
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+    LRESULT result = instance->KeyProc(nCode, wParam, lParam);
+    instance->RecordLatency(instance->_keyLatency, start);
+    return result;
 }
 
 int HotkeyManager::IsModifier(int vk) {
@@ -268,16 +415,7 @@ int HotkeyManager::IsModifier(int vk) {
 }
 
 bool HotkeyManager::IsMouseKey(int vk) {
-    if (vk < 0x07 && vk != VK_CANCEL) {
-        return true;
-    }
-
-    if (vk & (0xF << MOUSE_OFFSET)) {
-        /* Has wheel or xbutton flags */
-        return true;
-    }
-
-    return false;
+    return HotkeyMatcher::IsMouseKey(vk);
 }
 
 int HotkeyManager::Modifiers() {
@@ -384,4 +522,22 @@ std::wstring HotkeyManager::VKToString(unsigned int vk, bool extendedKey) {
     wchar_t buf[256] = {};
     GetKeyNameText(scanCode, buf, 256);
     return std::wstring(buf);
+}
+
+void HotkeyManager::FixWin(unsigned short winKey) {
+    SyntheticKeyboard::SimulateKeypress(VK_NONAME, false);
+    SyntheticKeyboard::SimulateKeyUp(winKey);
+}
+
+unsigned int HotkeyManager::HookTimeout() {
+    DWORD timeout = 0;
+    DWORD size = sizeof(DWORD);
+    LONG res = RegGetValue(HKEY_CURRENT_USER, L"Control Panel\\Desktop",
+        L"LowLevelHooksTimeout", RRF_RT_REG_DWORD, NULL, &timeout, &size);
+
+    if (res != ERROR_SUCCESS || timeout == 0) {
+        return HookLatency::DefaultTimeout;
+    }
+
+    return timeout;
 }
\ No newline at end of file
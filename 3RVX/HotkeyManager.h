@@ -17,10 +17,10 @@
 
 #include <Windows.h>
 #include <unordered_set>
+#include <vector>
 
-#define EXT_OFFSET 8
-#define MOD_OFFSET 16
-#define MOUSE_OFFSET 20
+#include "HookLatency.h"
+#include "HotkeyMatcher.h"
 
 #define HKM_MOD_ALT (MOD_ALT << MOD_OFFSET)
 #define HKM_MOD_CTRL (MOD_CONTROL << MOD_OFFSET)
@@ -32,6 +32,10 @@
 #define HKM_MOUSE_XB1 (0x3 << MOUSE_OFFSET)
 #define HKM_MOUSE_XB2 (0x4 << MOUSE_OFFSET)
 
+/* Identifiers for sequence and press-and-hold bindings start above the 24-bit
+ * key combination range so they can share the WM_HOTKEY id space. */
+#define HKM_SEQUENCE_BASE (0x1 << 24)
+
 class HotkeyManager {  
 public:
     static HotkeyManager *Instance();
@@ -40,8 +44,38 @@ public:
     void Register(int keyCombination);
     bool Unregister(int keyCombination);
 
+    /// <summary>
+    /// Registers a sequence of keyboard combinations, optionally requiring
+    /// the last one to be held down for holdTime ms. Sequences are matched by
+    /// the keyboard hook. Returns the identifier that will be posted with
+    /// WM_HOTKEY when the sequence is completed, or 0 on failure.
+    /// </summary>
+    int RegisterSequence(const std::vector<int> &steps,
+        unsigned int holdTime = 0);
+    bool UnregisterSequence(int binding);
+
     void Shutdown();
 
+    /// <summary>
+    /// Removes and re-installs the low-level hooks. Windows silently removes
+    /// hooks that exceed the LowLevelHooksTimeout, so this is called whenever
+    /// a hook event runs over its latency budget.
+    /// </summary>
+    bool Rehook();
+
+    const HookLatency &KeyboardLatency();
+    const HookLatency &MouseLatency();
+
+    /// <summary>Writes hook latency statistics to the log.</summary>
+    void LogLatency();
+
+    /// <summary>
+    /// Sends on the keys the hook swallowed for a sequence or press-and-hold
+    /// hotkey that was then abandoned. Called by the notification window
+    /// when the hook posts MSG_REPLAY.
+    /// </summary>
+    void Replay();
+
 public:
     static int IsModifier(int vk);
     static bool IsMouseKey(int vk);
@@ -54,6 +88,18 @@ public:
     static std::wstring MouseString(int combination);
     static std::wstring VKToString(unsigned int vk, bool extendedKey = false);
 
+    /// <summary>
+    /// Completes a WIN+Mouse hotkey after the hook has swallowed the WIN key
+    /// release: simulates WIN+VK_NONAME so the system doesn't treat the
+    /// combination as a lone WIN press, and then releases the WIN key.
+    /// </summary>
+    static void FixWin(unsigned short winKey);
+
+    /// <summary>
+    /// Retrieves the LowLevelHooksTimeout from the registry, in milliseconds.
+    /// </summary>
+    static unsigned int HookTimeout();
+
 private:
     HotkeyManager();
     ~HotkeyManager();
@@ -61,12 +107,23 @@ private:
     HWND _notifyWnd;
     int _fixWin;
     std::unordered_set<int> _keyCombinations;
-    std::unordered_set<int> _hookCombinations;
-    int _modifiers;
+    HotkeyMatcher _hookCombinations;
+    int _nextSequence;
 
     HHOOK _keyHook;
     HHOOK _mouseHook;
 
+    HookLatency _keyLatency;
+    HookLatency _mouseLatency;
+    LARGE_INTEGER _perfFreq;
+    bool _rehookPending;
+    bool _replayPending;
+
+    /// <summary>
+    /// Identifies input synthesized by Replay() so the hook lets it through.
+    /// </summary>
+    static const ULONG_PTR ReplayTag = 0x33525658;
+
     bool Hook();
     bool Unhook();
 
@@ -78,5 +135,13 @@ private:
     static LRESULT CALLBACK 
         LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam);
 
+    void RecordLatency(HookLatency &latency, LARGE_INTEGER &start);
+
+    /// <summary>
+    /// Asks the notification window to call Replay() if the matcher has
+    /// swallowed keys waiting to be sent on.
+    /// </summary>
+    void QueueReplay();
+
     static HotkeyManager *instance;
 };
\ No newline at end of file
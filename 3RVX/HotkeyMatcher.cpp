@@ -0,0 +1,284 @@
+#include "HotkeyMatcher.h"
+
+HotkeyMatcher::Node::Node() :
+binding(0),
+holdBinding(0),
+holdTime(0) {
+
+}
+
+HotkeyMatcher::HotkeyMatcher() :
+_modifiers(0),
+_timeout(DefaultTimeout) {
+    Clear();
+}
+
+void HotkeyMatcher::Add(int combination) {
+    std::vector<int> steps(1, combination);
+    Add(steps, combination);
+}
+
+void HotkeyMatcher::Add(const std::vector<int> &steps, int binding,
+        unsigned int holdTime) {
+
+    if (steps.empty() || binding <= 0) {
+        return;
+    }
+
+    Binding b = { steps, binding, holdTime };
+    _bindings.push_back(b);
+    Insert(b);
+    Reset();
+}
+
+void HotkeyMatcher::Remove(int binding) {
+    bool found = false;
+    for (auto it = _bindings.begin(); it != _bindings.end(); ) {
+        if (it->id == binding) {
+            it = _bindings.erase(it);
+            found = true;
+        } else {
+            ++it;
+        }
+    }
+
+    if (found == false) {
+        return;
+    }
+
+    /* Nodes that led only to the removed binding must go too; otherwise the
+     * first step of a removed sequence would still be swallowed. */
+    Rebuild();
+    Reset();
+}
+
+void HotkeyMatcher::Clear() {
+    _nodes.assign(1, Node());
+    _bindings.clear();
+    _modifiers = 0;
+    Reset();
+}
+
+bool HotkeyMatcher::Empty() const {
+    return _bindings.empty();
+}
+
+bool HotkeyMatcher::Contains(int binding) const {
+    for (const Binding &b : _bindings) {
+        if (b.id == binding) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HotkeyMatcher::IsPrefix(int combination) const {
+    return Next(0, combination) != 0;
+}
+
+void HotkeyMatcher::Reset() {
+    _swallowed.clear();
+    _replay.clear();
+    _state = 0;
+    _stepTime = 0;
+    _holdNode = -1;
+    _holdKeys = 0;
+    _holdStart = 0;
+    _holdFired = false;
+}
+
+unsigned int HotkeyMatcher::Timeout() const {
+    return _timeout;
+}
+
+void HotkeyMatcher::Timeout(unsigned int ms) {
+    _timeout = ms;
+}
+
+int HotkeyMatcher::KeyDown(unsigned int vk, bool extended, int modifier,
+        unsigned int time) {
+
+    if (modifier) {
+        _modifiers |= modifier;
+        return 0;
+    }
+
+    int ext = (extended ? 0x1 : 0x0) << EXT_OFFSET;
+    int keys = _modifiers | ext | (int) vk;
+
+    if (_holdNode >= 0) {
+        if (keys == _holdKeys) {
+            /* Auto-repeat from the key being held down */
+            const Node &held = _nodes[_holdNode];
+            if (_holdFired == false && time - _holdStart >= held.holdTime) {
+                _holdFired = true;
+                _swallowed.clear();
+                return held.holdBinding;
+            }
+            return Consumed;
+        }
+
+        /* Another key was pressed; the hold is abandoned. */
+        if (_holdFired == false) {
+            _swallowed.push_back(_holdKeys);
+            Abandon();
+        }
+        _holdNode = -1;
+    }
+
+    /* Timestamps are unsigned so the subtraction handles wraparound. */
+    if (_state != 0 && time - _stepTime > _timeout) {
+        Abandon();
+    }
+
+    int next = Next(_state, keys);
+    if (next == 0 && _state != 0) {
+        /* The sequence was broken, but this key may start another one. */
+        Abandon();
+        next = Next(0, keys);
+    }
+
+    if (next == 0) {
+        if (_replay.empty() == false) {
+            /* Keys swallowed by an abandoned sequence are waiting to be sent
+             * again; this one has to follow them. */
+            _replay.push_back(keys);
+            return Consumed;
+        }
+        return 0;
+    }
+
+    const Node &node = _nodes[next];
+    if (node.holdBinding > 0) {
+        /* Wait for auto-repeat (hold) or the key release (tap) */
+        _state = 0;
+        _holdNode = next;
+        _holdKeys = keys;
+        _holdStart = time;
+        _holdFired = false;
+        return Consumed;
+    }
+
+    if (node.next.empty()) {
+        _state = 0;
+        _swallowed.clear();
+        return node.binding;
+    }
+
+    /* Part of a longer sequence. A binding that is also a prefix of another
+     * sequence completes immediately; the sequence carries on from here. */
+    _state = next;
+    _stepTime = time;
+    if (node.binding > 0) {
+        _swallowed.clear();
+        return node.binding;
+    }
+
+    _swallowed.push_back(keys);
+    return Consumed;
+}
+
+int HotkeyMatcher::KeyUp(unsigned int vk, int modifier, unsigned int time) {
+    if (modifier) {
+        _modifiers &= ~modifier;
+        return 0;
+    }
+
+    if (_holdNode < 0 || (unsigned int) (_holdKeys & 0xFF) != vk) {
+        return 0;
+    }
+
+    const Node &held = _nodes[_holdNode];
+    _holdNode = -1;
+    if (_holdFired) {
+        return Consumed;
+    }
+
+    _swallowed.push_back(_holdKeys);
+    if (time - _holdStart >= held.holdTime) {
+        /* Held long enough, but released before an auto-repeat arrived */
+        _swallowed.clear();
+        return held.holdBinding;
+    }
+
+    if (held.binding > 0) {
+        /* Released early: this was a tap */
+        _swallowed.clear();
+        return held.binding;
+    }
+
+    /* A tap of a key that only has a press-and-hold binding; it was
+     * swallowed while waiting, so it has to be sent on. */
+    Abandon();
+    return Consumed;
+}
+
+bool HotkeyMatcher::ReplayPending() const {
+    return _replay.empty() == false;
+}
+
+std::vector<int> HotkeyMatcher::TakeReplay() {
+    std::vector<int> replay;
+    replay.swap(_replay);
+    return replay;
+}
+
+int HotkeyMatcher::Modifiers() const {
+    return _modifiers;
+}
+
+bool HotkeyMatcher::IsMouseKey(int vk) {
+    /* Mouse buttons are VK 0x01 - 0x06, except VK_CANCEL (0x03) */
+    if (vk < 0x07 && vk != 0x03) {
+        return true;
+    }
+
+    if (vk & (0xF << MOUSE_OFFSET)) {
+        /* Has wheel or xbutton flags */
+        return true;
+    }
+
+    return false;
+}
+
+void HotkeyMatcher::Abandon() {
+    _replay.insert(_replay.end(), _swallowed.begin(), _swallowed.end());
+    _swallowed.clear();
+    _state = 0;
+}
+
+void HotkeyMatcher::Insert(const Binding &binding) {
+    int node = 0;
+    for (int keys : binding.steps) {
+        int next = Next(node, keys);
+        if (next == 0) {
+            next = (int) _nodes.size();
+            _nodes.push_back(Node());
+            _nodes[node].next[keys] = next;
+        }
+        node = next;
+    }
+
+    if (binding.holdTime > 0) {
+        _nodes[node].holdBinding = binding.id;
+        _nodes[node].holdTime = binding.holdTime;
+    } else {
+        _nodes[node].binding = binding.id;
+    }
+}
+
+void HotkeyMatcher::Rebuild() {
+    _nodes.assign(1, Node());
+    for (const Binding &binding : _bindings) {
+        Insert(binding);
+    }
+}
+
+int HotkeyMatcher::Next(int node, int keys) const {
+    const std::unordered_map<int, int> &next = _nodes[node].next;
+    auto it = next.find(keys);
+    if (it == next.end()) {
+        return 0;
+    }
+    return it->second;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+/* See HotkeyManager.h for a description of the key storage format. */
+#define EXT_OFFSET 8
+
+/* glibc's <sys/timex.h> (included by <thread> and others) defines an
+ * unrelated MOD_OFFSET for adjtimex(). */
+#undef MOD_OFFSET
+#define MOD_OFFSET 16
+#define MOUSE_OFFSET 20
+
+/// <summary>
+/// Matches keyboard events against the hotkeys that must be handled by the
+/// low-level keyboard hook (rather than RegisterHotKey): combinations that
+/// couldn't be registered with Windows, multi-key sequences (Win+V, then Up),
+/// and press-and-hold variants.
+/// <p>
+/// Bindings are compiled into a trie of key combinations. The matcher keeps
+/// its position in the trie between events, so each event costs a single
+/// lookup regardless of how many bindings exist. If the next step of a
+/// sequence doesn't arrive within the timeout, the matcher returns to the
+/// root.
+/// <p>
+/// This class contains the decision logic of the keyboard hook with no
+/// dependencies on the Win32 API, so it can be driven by synthetic event
+/// streams. The hook procedure translates each event and hands it off here.
+/// </summary>
+class HotkeyMatcher {
+public:
+    /// <summary>
+    /// Returned when an event didn't complete a binding but is part of one
+    /// (a sequence prefix or a key being held) and should be swallowed.
+    /// </summary>
+    static const int Consumed = -1;
+
+    /// <summary>Default time allowed between sequence steps, in ms.</summary>
+    static const unsigned int DefaultTimeout = 1000;
+
+    /// <summary>Default press-and-hold duration, in ms.</summary>
+    static const unsigned int DefaultHoldTime = 500;
+
+    HotkeyMatcher();
+
+    /// <summary>
+    /// Adds a single key combination. The combination is also its binding
+    /// identifier.
+    /// </summary>
+    void Add(int combination);
+
+    /// <summary>
+    /// Adds a sequence of key combinations. When the last step is matched,
+    /// the given binding identifier (which must be positive) is returned. If
+    /// holdTime is nonzero, the last step must be held down for at least
+    /// holdTime ms instead.
+    /// </summary>
+    void Add(const std::vector<int> &steps, int binding,
+        unsigned int holdTime = 0);
+
+    void Remove(int binding);
+    void Clear();
+    bool Empty() const;
+    bool Contains(int binding) const;
+
+    /// <summary>
+    /// Determines whether the given combination begins any binding.
+    /// </summary>
+    bool IsPrefix(int combination) const;
+
+    /// <summary>
+    /// Abandons any partially-matched sequence or hold, discarding the keys
+    /// it swallowed.
+    /// </summary>
+    void Reset();
+
+    unsigned int Timeout() const;
+    void Timeout(unsigned int ms);
+
+    /// <summary>
+    /// Processes a key press that occurred at the given time (in ms). If the
+    /// key is a modifier, the modifier flag (HKM_MOD_*) should be provided so
+    /// the modifier state can be tracked. Returns the identifier of the
+    /// completed binding, Consumed, or 0 if the event isn't part of any
+    /// binding.
+    /// </summary>
+    int KeyDown(unsigned int vk, bool extended, int modifier = 0,
+        unsigned int time = 0);
+
+    /// <summary>
+    /// Processes a key release. Returns the identifier of a binding that
+    /// completes when the key is released (a key with a press-and-hold
+    /// variant that was released early, or held long enough without
+    /// auto-repeat), Consumed if the key was being held, or 0.
+    /// </summary>
+    int KeyUp(unsigned int vk, int modifier = 0, unsigned int time = 0);
+
+    /// <summary>Retrieves the modifiers currently held down.</summary>
+    int Modifiers() const;
+
+    /// <summary>
+    /// Determines whether keys swallowed by a sequence or hold that was then
+    /// abandoned are waiting to be sent on (see TakeReplay).
+    /// </summary>
+    bool ReplayPending() const;
+
+    /// <summary>
+    /// Retrieves the key combinations that were swallowed by an abandoned
+    /// sequence or hold, followed by any keys that were pressed before they
+    /// could be sent on, in the order they were pressed. The caller should
+    /// synthesize them (marked so the hook ignores them). The list is
+    /// cleared.
+    /// </summary>
+    std::vector<int> TakeReplay();
+
+    /// <summary>
+    /// Determines whether a virtual key code (or a combination's HKM_MOUSE_*
+    /// flags) refers to a mouse button or the wheel.
+    /// </summary>
+    static bool IsMouseKey(int vk);
+
+private:
+    struct Node {
+        Node();
+
+        /// <summary>Maps key combinations to child node indexes.</summary>
+        std::unordered_map<int, int> next;
+
+        /// <summary>
+        /// Binding completed by reaching this node (or tapping its key, if it
+        /// also has a press-and-hold binding).
+        /// </summary>
+        int binding;
+
+        /// <summary>Binding completed by holding this node's key.</summary>
+        int holdBinding;
+        unsigned int holdTime;
+    };
+
+    /// <summary>A binding as it was added.</summary>
+    struct Binding {
+        std::vector<int> steps;
+        int id;
+        unsigned int holdTime;
+    };
+
+    /// <summary>Trie nodes; the root is always at index 0.</summary>
+    std::vector<Node> _nodes;
+
+    /// <summary>
+    /// Bindings in the order they were added; the trie is rebuilt from these
+    /// when a binding is removed.
+    /// </summary>
+    std::vector<Binding> _bindings;
+    int _modifiers;
+    unsigned int _timeout;
+
+    /* Sequence state */
+    int _state;
+    unsigned int _stepTime;
+
+    /* Press-and-hold state */
+    int _holdNode;
+    int _holdKeys;
+    unsigned int _holdStart;
+    bool _holdFired;
+
+    /// <summary>
+    /// Keys swallowed by the sequence or hold in progress. If it is abandoned
+    /// they move to _replay, since nothing else will ever see them.
+    /// </summary>
+    std::vector<int> _swallowed;
+    std::vector<int> _replay;
+
+    /// <summary>
+    /// Returns to the root, queuing the swallowed keys to be sent on.
+    /// </summary>
+    void Abandon();
+    void Insert(const Binding &binding);
+    void Rebuild();
+    int Next(int node, int keys) const;
+};
\ No newline at end of file
@@ -1,10 +1,10 @@
 #pragma once
 
-class HotkeyInfo;
+class HotkeyAction;
 
 /// <summary>
 /// Interface for classes that are able to handle and process hotkey events.
 /// </summary>
 class HotkeyProcessor {
-    virtual void ProcessHotkeys(HotkeyInfo &hki) = 0;
+    virtual void ProcessHotkeys(HotkeyAction &hka) = 0;
 };
\ No newline at end of file
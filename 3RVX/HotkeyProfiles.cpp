@@ -0,0 +1,124 @@
+#include "HotkeyProfiles.h"
+
+#include <cwctype>
+#include <set>
+
+HotkeyProfiles::HotkeyProfiles(ProcessSource *source) :
+_source(source),
+_effective(1),
+_names(1),
+_active(0) {
+
+}
+
+void HotkeyProfiles::Load(const std::vector<HotkeyInfo> &global,
+        const std::vector<HotkeyProfile> &profiles) {
+
+    _effective.assign(1, global);
+    _names.assign(1, L"");
+    _processes.clear();
+    _windows.clear();
+    _active = 0;
+
+    for (const HotkeyProfile &profile : profiles) {
+        std::wstring name = ProcessName(profile.process);
+        if (name.empty() || _processes.count(name) > 0) {
+            continue;
+        }
+
+        _processes[name] = (int) _effective.size();
+        _effective.push_back(Merge(global, profile));
+        _names.push_back(name);
+    }
+}
+
+bool HotkeyProfiles::Empty() const {
+    return _processes.empty();
+}
+
+bool HotkeyProfiles::Foreground(void *window) {
+    if (Empty()) {
+        return false;
+    }
+
+    int profile = Resolve(window);
+    if (profile == _active) {
+        return false;
+    }
+
+    _active = profile;
+    return true;
+}
+
+const std::vector<HotkeyInfo> &HotkeyProfiles::Active() const {
+    return _effective[_active];
+}
+
+std::wstring HotkeyProfiles::ActiveProfile() const {
+    return _names[_active];
+}
+
+int HotkeyProfiles::Resolve(void *window) {
+    unsigned long pid = _source->ProcessId(window);
+    if (pid == 0) {
+        /* The window is already gone */
+        return 0;
+    }
+
+    std::pair<void *, unsigned long> key(window, pid);
+    auto it = _windows.find(key);
+    if (it != _windows.end()) {
+        return it->second;
+    }
+
+    int profile = 0;
+    std::wstring name = ProcessName(_source->ProcessPath(pid));
+    auto proc = _processes.find(name);
+    if (proc != _processes.end()) {
+        profile = proc->second;
+    }
+
+    if (_windows.size() >= MaxCachedWindows) {
+        _windows.clear();
+    }
+    _windows[key] = profile;
+    return profile;
+}
+
+std::wstring HotkeyProfiles::ProcessName(const std::wstring &path) {
+    size_t sep = path.find_last_of(L"\\/");
+    std::wstring name = (sep == std::wstring::npos)
+        ? path : path.substr(sep + 1);
+
+    for (wchar_t &c : name) {
+        c = (wchar_t) std::towlower(c);
+    }
+    return name;
+}
+
+std::vector<int> HotkeyProfiles::Keys(HotkeyInfo hki) {
+    std::vector<int> keys = hki.Steps();
+    keys.push_back((int) hki.holdTime);
+    return keys;
+}
+
+std::vector<HotkeyInfo> HotkeyProfiles::Merge(
+        const std::vector<HotkeyInfo> &global, const HotkeyProfile &profile) {
+
+    std::set<std::vector<int>> replaced;
+    for (const HotkeyInfo &hki : profile.disabled) {
+        replaced.insert(Keys(hki));
+    }
+    for (const HotkeyInfo &hki : profile.hotkeys) {
+        replaced.insert(Keys(hki));
+    }
+
+    std::vector<HotkeyInfo> merged;
+    for (const HotkeyInfo &hki : global) {
+        if (replaced.count(Keys(hki)) == 0) {
+            merged.push_back(hki);
+        }
+    }
+    merged.insert(merged.end(), profile.hotkeys.begin(), profile.hotkeys.end());
+    return merged;
+}
\ No newline at end of file
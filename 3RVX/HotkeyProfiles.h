@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HotkeyInfo.h"
+#include "ProcessSource.h"
+
+/// <summary>
+/// Hotkey overrides that apply while a particular program is in the
+/// foreground.
+/// </summary>
+struct HotkeyProfile {
+    /// <summary>Executable name the profile applies to (vlc.exe).</summary>
+    std::wstring process;
+
+    /// <summary>
+    /// Hotkeys that are added to the global hotkeys, replacing any global
+    /// hotkey with the same keys.
+    /// </summary>
+    std::vector<HotkeyInfo> hotkeys;
+
+    /// <summary>
+    /// Global hotkeys (identified by their keys) that are disabled while the
+    /// profile is active. Disabled keys are passed through to the program.
+    /// </summary>
+    std::vector<HotkeyInfo> disabled;
+};
+
+/// <summary>
+/// Resolves the set of hotkeys in effect for the foreground program.
+/// <p>
+/// The effective hotkeys for each profile are merged once, when the profiles
+/// are loaded, and the profile for each foreground window is cached. This
+/// class is driven by foreground change events rather than input events, so
+/// the keyboard and mouse hooks never consult it. Windows are mapped to their
+/// executables through a ProcessSource, which keeps this class free of the
+/// Win32 API.
+/// </summary>
+class HotkeyProfiles {
+public:
+    /// <summary>
+    /// The window cache is flushed after this many entries so windows that
+    /// have been destroyed don't accumulate.
+    /// </summary>
+    static const unsigned int MaxCachedWindows = 256;
+
+    /// <summary>
+    /// Creates the profiles. The process source is not owned, and must
+    /// outlive this object.
+    /// </summary>
+    HotkeyProfiles(ProcessSource *source);
+
+    void Load(const std::vector<HotkeyInfo> &global,
+        const std::vector<HotkeyProfile> &profiles);
+
+    /// <summary>Determines whether any profiles have been loaded.</summary>
+    bool Empty() const;
+
+    /// <summary>
+    /// Updates the active profile when the foreground window changes.
+    /// Returns true if a different set of hotkeys is now in effect.
+    /// </summary>
+    bool Foreground(void *window);
+
+    /// <summary>
+    /// Retrieves the hotkeys in effect for the active profile.
+    /// </summary>
+    const std::vector<HotkeyInfo> &Active() const;
+
+    /// <summary>
+    /// Retrieves the process name of the active profile, or an empty string
+    /// if only the global hotkeys are in effect.
+    /// </summary>
+    std::wstring ActiveProfile() const;
+
+    /// <summary>
+    /// Converts an executable path to the (lowercase) file name used to
+    /// identify profiles.
+    /// </summary>
+    static std::wstring ProcessName(const std::wstring &path);
+
+private:
+    ProcessSource *_source;
+
+    /// <summary>
+    /// Effective hotkeys; index 0 holds the global hotkeys, followed by one
+    /// entry per profile.
+    /// </summary>
+    std::vector<std::vector<HotkeyInfo>> _effective;
+    std::vector<std::wstring> _names;
+    std::unordered_map<std::wstring, int> _processes;
+
+    /// <summary>
+    /// Profile for each window, keyed by the window and its process. Window
+    /// handles are reused, but not by the same process.
+    /// </summary>
+    std::map<std::pair<void *, unsigned long>, int> _windows;
+    int _active;
+
+    int Resolve(void *window);
+
+    static std::vector<int> Keys(HotkeyInfo hki);
+    static std::vector<HotkeyInfo> Merge(const std::vector<HotkeyInfo> &global,
+        const HotkeyProfile &profile);
+};
\ No newline at end of file
@@ -1,48 +1,64 @@
+#define LOG_SUBSYSTEM Language
+
 #include "LanguageTranslator.h"
 
+#include <Windows.h>
 #include <sstream>
 
 #include "Logger.h"
 #include "StringUtils.h"
+#include "Trace.h"
 
-LanguageTranslator::LanguageTranslator() {
+LanguageTranslator::LanguageTranslator() :
+_loaded(false) {
 
 }
 
-LanguageTranslator::LanguageTranslator(std::wstring langFileName) {
+LanguageTranslator::LanguageTranslator(std::wstring langFileName) :
+_loaded(false) {
     CLOG(L"Loading language XML: %s", langFileName.c_str());
 
     FILE *fp;
     _wfopen_s(&fp, langFileName.c_str(), L"rb");
     if (fp == NULL) {
-        CLOG(L"Failed to open file!");
+        ELOG(L"Failed to open file!");
         return;
     }
 
-    tinyxml2::XMLError result = _xml.LoadFile(fp);
-    if (result != tinyxml2::XMLError::XML_SUCCESS) {
-        CLOG(L"Failed to read language file!");
+    bool read = _reader.Load(fp);
+    fclose(fp);
+    if (read == false) {
+        ELOG(L"Failed to read language file!");
         return;
     }
 
-    _root = _xml.GetDocument()->FirstChildElement("translation");
-    if (_root == NULL) {
+    if (_reader.Next() != XMLReader::StartElement
+            || _reader.IsElement("translation") == false) {
         return;
     }
+    _loaded = true;
+
+    /* Find the <language> header */
+    XMLReader::Event e;
+    while ((e = _reader.Next()) != XMLReader::End && e != XMLReader::Error) {
+        if (e != XMLReader::StartElement) {
+            continue;
+        }
 
-    /*
-    _author = StringUtils::Widen(_root->Attribute("author", ""));
-    */
+        if (_reader.IsElement("language")) {
+            break;
+        }
+        _reader.Skip();
+    }
 
-    tinyxml2::XMLElement *trans = _root->FirstChildElement("language");
-    if (trans == NULL) {
+    if (e != XMLReader::StartElement) {
         CLOG(L"No <language> tag.");
         return;
     }
 
     CLOG(L"Loading translation header");
-    _name = StringUtils::Widen(trans->Attribute("name"));
-    _id = StringUtils::Widen(trans->Attribute("id"));
+    _name = StringUtils::Widen(_reader.Attribute("name"));
+    _id = StringUtils::Widen(_reader.Attribute("id"));
 
     if (_name == L"" || _id == L"") {
         CLOG(L"whoops");
@@ -50,7 +66,7 @@ LanguageTranslator::LanguageTranslator(std::wstring langFileName) {
 
     QCLOG(L"Language name: %s", _name.c_str());
     QCLOG(L"Locale identifier: %s", _id.c_str());
-    const char *regions = trans->Attribute("regions");
+    const char *regions = _reader.Attribute("regions");
     if (regions != NULL) {
         std::string region;
         std::istringstream ss(regions);
@@ -60,38 +76,59 @@ LanguageTranslator::LanguageTranslator(std::wstring langFileName) {
             QCLOG(L"Region: %s", regionStr.c_str());
         }
     }
+
+    _reader.Skip();
 }
 
 void LanguageTranslator::LoadTranslations() {
-    if (_root == NULL) {
+    TRACE_SPAN("LanguageTranslator::LoadTranslations");
+    if (_loaded == false) {
         return;
     }
 
-    tinyxml2::XMLElement *string = _root->FirstChildElement("string");
-    for (; string != NULL; string = string->NextSiblingElement()) {
+    XMLReader::Event e;
+    while ((e = _reader.Next()) != XMLReader::End && e != XMLReader::Error) {
+        if (e != XMLReader::StartElement) {
+            continue;
+        }
+
+        if (_reader.IsElement("string") == false) {
+            _reader.Skip();
+            continue;
+        }
+
         const char *originalText = NULL;
         const char *translatedText = NULL;
 
-        tinyxml2::XMLElement *orig = string->FirstChildElement("original");
-        if (orig) {
-            originalText = orig->GetText();
-        }
-        tinyxml2::XMLElement *trans = string->FirstChildElement("translation");
-        if (trans) {
-            translatedText = trans->GetText();
+        /* The text is unescaped in place, so these remain valid until the
+         * reader is destroyed. */
+        while ((e = _reader.Next()) == XMLReader::StartElement
+                || e == XMLReader::Text) {
+
+            if (e == XMLReader::Text) {
+                continue;
+            }
+
+            if (_reader.IsElement("original")) {
+                originalText = _reader.ElementText();
+            } else if (_reader.IsElement("translation")) {
+                translatedText = _reader.ElementText();
+            } else {
+                _reader.Skip();
+            }
         }
 
         if (originalText && translatedText) {
+            /* The translation is moved into the table */
             std::wstring origStr = StringUtils::Widen(originalText);
-            std::wstring transStr = StringUtils::Widen(translatedText);
+            if (_translations.Add(origStr,
+                    StringUtils::Widen(translatedText)) == false) {
 
-            if (_translations.find(origStr) != _translations.end()) {
-                CLOG(L"WARNING: Duplicate translation found!");
-                QCLOG(L"[%s] -> [%s]", origStr.c_str(), transStr.c_str());
+                WLOG(L"Duplicate translation found!");
+                QCLOG(L"[%s] -> [%s]", origStr.c_str(),
+                    StringUtils::Widen(translatedText).c_str());
                 return;
             }
-
-            _translations[origStr] = transStr;
         }
     }
 }
@@ -101,12 +138,13 @@ const std::wstring &LanguageTranslator::Translate(const std::wstring &str) {
         return str;
     }
 
-    if (_translations.find(str) == _translations.end()) {
+    int handle = _translations.Find(str);
+    if (handle == TranslationTable::NotFound) {
         /* If the translation isn't found, return the original string. */
         CLOG(L"No translation found: [%s]", str.c_str());
         return str;
     }
-    return _translations[str];
+    return _translations.Translation(handle);
 }
 
 const std::wstring LanguageTranslator::TranslateAndReplace(
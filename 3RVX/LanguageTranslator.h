@@ -1,16 +1,24 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-#include "TinyXml2\tinyxml2.h"
+#include "TranslationTable.h"
+#include "XMLReader.h"
 
 class LanguageTranslator {
 public:
     LanguageTranslator();
+    /// <summary>
+    /// Reads the language header (name, identifier, and regions) from the
+    /// given file. The file is read in a single pass; the header must
+    /// precede the translated strings.
+    /// </summary>
     LanguageTranslator(std::wstring langFileName);
 
+    /// <summary>
+    /// Reads the translated strings that follow the header.
+    /// </summary>
     void LoadTranslations();
 
     /// <summary>
@@ -36,9 +44,9 @@ public:
     static std::vector<std::wstring> CurrentLocale();
 
 private:
-    tinyxml2::XMLDocument _xml;
-    tinyxml2::XMLElement *_root;
-    std::unordered_map<std::wstring, std::wstring> _translations;
+    XMLReader _reader;
+    bool _loaded;
+    TranslationTable _translations;
 
     std::wstring _author;
     std::wstring _name;
@@ -0,0 +1,84 @@
+#include "Launcher.h"
+
+#include "3RVX.h"
+#include "ActionExecutor.h"
+#include "Error.h"
+#include "Logger.h"
+
+ActionExecutor *Launcher::executor = NULL;
+
+void Launcher::Start(HWND notifyWnd) {
+    Stop();
+
+    executor = new ActionExecutor([notifyWnd]() {
+        PostMessage(notifyWnd, WM_3RVX_CONTROL, MSG_LAUNCHED, NULL);
+    });
+}
+
+void Launcher::Stop() {
+    delete executor;
+    executor = NULL;
+}
+
+bool Launcher::Open(std::wstring target) {
+    CLOG(L"Opening: %s", target.c_str());
+
+    if (executor == NULL) {
+        bool success = Execute(target);
+        if (success == false) {
+            Error::ErrorMessage(GENERR_NOTFOUND, target);
+        }
+        return success;
+    }
+
+    bool queued = executor->Submit(target, [target]() {
+        /* ShellExecuteEx may use COM, which must be initialized on each
+         * thread that calls it. */
+        HRESULT hr = CoInitializeEx(NULL,
+            COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+        bool success = Execute(target);
+        if (SUCCEEDED(hr)) {
+            CoUninitialize();
+        }
+        return success;
+    });
+
+    if (queued == false) {
+        QCLOG(L"Already launching; ignoring");
+    }
+    return queued;
+}
+
+void Launcher::Completed() {
+    if (executor == NULL) {
+        return;
+    }
+
+    std::vector<ActionExecutor::Result> results = executor->Completed();
+    for (ActionExecutor::Result &result : results) {
+        CLOG(L"Launched %s: %s", result.key.c_str(),
+            result.success ? L"OK" : L"FAILED");
+        if (result.success == false) {
+            Error::ErrorMessage(GENERR_NOTFOUND, result.key);
+        }
+    }
+}
+
+bool Launcher::Execute(std::wstring target) {
+    /* The launch must finish before this returns: worker threads uninitialize
+     * COM right afterward and don't pump messages, so the shell can't
+     * complete it asynchronously. Failures are reported by Completed()
+     * instead of the shell's error dialog. */
+    SHELLEXECUTEINFO sei = { 0 };
+    sei.cbSize = sizeof(SHELLEXECUTEINFO);
+    sei.fMask = SEE_MASK_NOASYNC | SEE_MASK_FLAG_NO_UI;
+    sei.lpVerb = L"open";
+    sei.lpFile = target.c_str();
+    sei.nShow = SW_SHOWNORMAL;
+
+    if (ShellExecuteEx(&sei) == FALSE) {
+        ELOG(L"ShellExecuteEx failed: %d", GetLastError());
+        return false;
+    }
+    return (INT_PTR) sei.hInstApp > 32;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Windows.h>
+#include <string>
+
+class ActionExecutor;
+
+/// <summary>
+/// Opens programs, documents, and URLs (via ShellExecuteEx) without blocking
+/// the calling thread. The shell can take hundreds of milliseconds to
+/// return, so launches are handed off to an ActionExecutor. When a launch
+/// finishes, MSG_LAUNCHED is posted to the notification window, which
+/// should call Completed() to report any failures.
+/// <p>
+/// If the launcher hasn't been started, launches are performed synchronously.
+/// </summary>
+class Launcher {
+public:
+    static void Start(HWND notifyWnd);
+    static void Stop();
+
+    /// <summary>
+    /// Opens the given file, folder, program, or URL. Returns false if the
+    /// target is already being launched (or a synchronous launch failed).
+    /// </summary>
+    static bool Open(std::wstring target);
+
+    /// <summary>
+    /// Reports the results of finished launches. Must be called from the
+    /// thread that owns the notification window.
+    /// </summary>
+    static void Completed();
+
+private:
+    static ActionExecutor *executor;
+
+    static bool Execute(std::wstring target);
+};
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "LogQueue.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cwchar>
+#include <string>
+
+LogQueue::LogQueue(unsigned int capacity) :
+_enqueue(0),
+_dequeue(0),
+_dropped(0) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    _cells.reset(new Cell[size]);
+    _mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::Push(int level, const wchar_t *function, int line,
+        const wchar_t *format, va_list args) {
+
+    /* Each cell's sequence number tells producers whether it is free for
+     * the current lap around the ring (sequence == position) and tells the
+     * consumer whether it has been filled (sequence == position + 1). */
+    Cell *cell;
+    size_t pos = _enqueue.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_cells[pos & _mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t) seq - (ptrdiff_t) pos;
+        if (diff == 0) {
+            if (_enqueue.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Full */
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = _enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    Format(cell->record, level, function, line, format, args);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogQueue::Pop(Record &record) {
+    Cell *cell;
+    size_t pos = _dequeue.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_cells[pos & _mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t) seq - (ptrdiff_t) (pos + 1);
+        if (diff == 0) {
+            if (_dequeue.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Empty */
+            return false;
+        } else {
+            pos = _dequeue.load(std::memory_order_relaxed);
+        }
+    }
+
+    record = cell->record;
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+unsigned int LogQueue::Dropped() {
+    return _dropped.exchange(0);
+}
+
+void LogQueue::Format(Record &record, int level, const wchar_t *function,
+        int line, const wchar_t *format, va_list args) {
+
+    record.time = Now();
+    record.level = level;
+    record.function = function;
+    record.line = line;
+
+#ifdef _MSC_VER
+    _vsnwprintf_s(record.text, TextLength, _TRUNCATE, format, args);
+#else
+    std::wstring portable = PortableFormat(format);
+    if (vswprintf(record.text, TextLength, portable.c_str(), args) < 0) {
+        /* Truncated */
+        record.text[TextLength - 1] = L'\0';
+    }
+#endif
+}
+
+#ifndef _MSC_VER
+std::wstring LogQueue::PortableFormat(const wchar_t *format) {
+    /* Log messages are written for the Microsoft CRT, where %s and %c in a
+     * wide format string are wide and %S and %C are narrow. Elsewhere, %s
+     * and %c are narrow and the wide versions need an 'l' length. */
+    std::wstring portable;
+    for (const wchar_t *c = format; *c != L'\0'; ++c) {
+        portable += *c;
+        if (*c != L'%') {
+            continue;
+        }
+
+        if (*(c + 1) == L'%') {
+            portable += *++c;
+            continue;
+        }
+
+        /* Flags, width, precision, and length */
+        const wchar_t *modifiers = L"-+ #0123456789.*hlLjzt";
+        while (*(c + 1) != L'\0' && wcschr(modifiers, *(c + 1)) != NULL) {
+            portable += *++c;
+        }
+
+        switch (*(c + 1)) {
+        case L's':
+        case L'c':
+            portable += L'l';
+            portable += *++c;
+            break;
+
+        case L'S':
+            portable += L's';
+            ++c;
+            break;
+
+        case L'C':
+            portable += L'c';
+            ++c;
+            break;
+        }
+    }
+    return portable;
+}
+#endif
+
+unsigned long long LogQueue::Now() {
+    using namespace std::chrono;
+
+    /* Shared by every queue and by records that are written directly, so
+     * all entries are on the same clock. */
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <memory>
+#include <string>
+
+/// <summary>
+/// Bounded, lock-free queue of formatted log records.
+/// <p>
+/// Any number of threads can push records while a single writer thread pops
+/// and outputs them, so logging never blocks the caller on console or file
+/// I/O. Records are fixed-size and stored in a ring that is allocated up
+/// front. When the ring is full, new records are dropped (and counted)
+/// rather than waiting for the writer.
+/// <p>
+/// Messages are formatted by the caller: the arguments to a log call are
+/// often temporaries (c_str() of a local string) that would not survive
+/// until the writer gets to them.
+/// </summary>
+class LogQueue {
+public:
+    static const int TextLength = 512;
+    static const unsigned int DefaultCapacity = 512;
+
+    struct Record {
+        /// <summary>
+        /// Milliseconds since the first record was formatted.
+        /// </summary>
+        unsigned long long time;
+        int level;
+
+        /// <summary>
+        /// Function (a string literal) and line that logged the record;
+        /// function is NULL for records that should be printed without a
+        /// header.
+        /// </summary>
+        const wchar_t *function;
+        int line;
+
+        wchar_t text[TextLength];
+    };
+
+    /// <summary>
+    /// Creates a queue. The capacity is rounded up to a power of two.
+    /// </summary>
+    LogQueue(unsigned int capacity = DefaultCapacity);
+
+    /// <summary>
+    /// Formats a message and adds it to the queue. Returns false if the
+    /// queue is full; the message is dropped.
+    /// </summary>
+    bool Push(int level, const wchar_t *function, int line,
+        const wchar_t *format, va_list args);
+
+    /// <summary>
+    /// Removes the oldest record from the queue. Returns false if the queue
+    /// is empty.
+    /// </summary>
+    bool Pop(Record &record);
+
+    /// <summary>
+    /// Retrieves the number of records that have been dropped since the last
+    /// call to this method.
+    /// </summary>
+    unsigned int Dropped();
+
+    /// <summary>
+    /// Formats and timestamps a message into a record.
+    /// </summary>
+    static void Format(Record &record, int level, const wchar_t *function,
+        int line, const wchar_t *format, va_list args);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+    std::atomic<size_t> _enqueue;
+    std::atomic<size_t> _dequeue;
+    std::atomic<unsigned int> _dropped;
+
+    /// <summary>
+    /// Retrieves the milliseconds elapsed since the first call.
+    /// </summary>
+    static unsigned long long Now();
+
+#ifndef _MSC_VER
+    /// <summary>
+    /// Converts a format string that uses the Microsoft conventions for
+    /// string arguments to the standard ones.
+    /// </summary>
+    static std::wstring PortableFormat(const wchar_t *format);
+#endif
+};
\ No newline at end of file
@@ -1,12 +1,177 @@
 #include "Logger.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <cwctype>
+#include <mutex>
 #include <string>
+#include <thread>
+
+#include "LogQueue.h"
+
+#ifdef _WIN32
+#define FOREGROUND_WHITE (FOREGROUND_RED \
+    | FOREGROUND_GREEN \
+    | FOREGROUND_BLUE)
+#endif
+
+const wchar_t *Logger::SubsystemNames[SubsystemCount] = {
+    L"general",
+    L"audio",
+    L"hotkeys",
+    L"language",
+    L"meters",
+    L"osd",
+    L"settings",
+    L"skin",
+    L"updates",
+};
+
+const wchar_t *Logger::LevelNames[LevelCount] = {
+    L"debug",
+    L"info",
+    L"warning",
+    L"error",
+    L"none",
+};
+
+namespace {
+
+std::atomic<int> threshold(Logger::Debug);
+
+/* Bit mask of enabled subsystems */
+std::atomic<unsigned int> subsystems(~0U);
+
+/* Minimum level logged by each subsystem: the threshold for enabled
+ * subsystems, or None for disabled ones. Zero-initialized (Debug) so log
+ * sites that run during static initialization are not lost. */
+std::atomic<int> levels[Logger::SubsystemCount];
+
+void UpdateLevels() {
+    unsigned int mask = subsystems.load();
+    for (int i = 0; i < Logger::SubsystemCount; ++i) {
+        bool enabled = (mask & (1U << i)) != 0;
+        levels[i].store(enabled ? threshold.load() : (int) Logger::None);
+    }
+}
+
+std::wstring Trim(const std::wstring &str) {
+    size_t start = 0;
+    size_t end = str.size();
+    while (start < end && iswspace(str[start])) {
+        ++start;
+    }
+    while (end > start && iswspace(str[end - 1])) {
+        --end;
+    }
+    return str.substr(start, end - start);
+}
+
+bool EqualsIgnoreCase(const std::wstring &a, const wchar_t *b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i] != L'\0'; ++i) {
+        if (towlower(a[i]) != towlower(b[i])) {
+            return false;
+        }
+    }
+    return i == a.size() && b[i] == L'\0';
+}
+
+LogQueue *queue;
+std::atomic<bool> running(false);
+
+/* Number of threads between checking 'running' and finishing a Push() */
+std::atomic<int> pushing(0);
+std::mutex wakeMutex;
+std::condition_variable wake;
+
+void Write(const LogQueue::Record &record) {
+    std::wstring prefix = Logger::Prefix(record.time, record.level);
+    wprintf(L"%ls ", prefix.c_str());
+    if (record.function != NULL) {
+#ifdef _WIN32
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        SetConsoleTextAttribute(console,
+            FOREGROUND_RED | FOREGROUND_INTENSITY);
+#endif
+        wprintf(L"[%ls:%d] ", record.function, record.line);
+#ifdef _WIN32
+        SetConsoleTextAttribute(console, FOREGROUND_WHITE);
+#endif
+    }
+    wprintf(L"%ls\n", record.text);
+}
+
+#if ENABLE_3RVX_LOG != 0
+std::thread *writer;
+
+void Drain() {
+    LogQueue::Record record;
+    while (queue->Pop(record)) {
+        Write(record);
+    }
+
+    unsigned int dropped = queue->Dropped();
+    if (dropped > 0) {
+        wprintf(L"(%u log entries dropped)\n", dropped);
+    }
+
+    /* Log files are no longer unbuffered, so flush whenever the queue has
+     * been drained. */
+    fflush(stdout);
+}
+
+void WriterProc() {
+    while (true) {
+        bool stopping = (running.load() == false);
+        Drain();
+        if (stopping) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
+/// <summary>
+/// Writes any queued entries and stops the writer thread. This is also
+/// registered with atexit() so entries aren't lost if the program exits
+/// without calling Logger::Stop().
+/// </summary>
+void StopWriter() {
+    if (running.exchange(false) == false) {
+        return;
+    }
+
+    wake.notify_one();
+    writer->join();
+
+    /* A thread that saw 'running' before it was cleared may still be in the
+     * middle of a Push(). Once those finish, every other thread writes its
+     * entries directly, so one last drain picks up the stragglers. */
+    while (pushing.load() > 0) {
+        std::this_thread::yield();
+    }
+    Drain();
+
+    /* The queue and thread object are not freed; the program is exiting. */
+}
+#endif
+
+}
 
 void Logger::Start() {
+#ifdef _WIN32
 #ifdef ENABLE_3RVX_LOGTOFILE
-    /* Disable buffering */
-    setvbuf(stdout, NULL, _IONBF, 0);
-    setvbuf(stderr, NULL, _IONBF, 0);
-
     FILE *out, *err;
     _wfreopen_s(&out, L"3RVX_Log.txt", L"w", stdout);
     _wfreopen_s(&err, L"3RVX_Log.txt", L"w", stderr);
@@ -19,11 +184,24 @@ void Logger::Start() {
     freopen_s(&err, "CONOUT$", "w", stderr);
 #endif
 #endif
+#endif
+
+#if ENABLE_3RVX_LOG != 0
+    queue = new LogQueue();
+    running = true;
+    writer = new std::thread(&WriterProc);
+    atexit(&StopWriter);
+#endif
 }
 
 void Logger::Stop() {
-#ifdef ENABLE_3RVX_LOGTOFILE
+#if ENABLE_3RVX_LOG != 0
     CLOG(L"Logger stopped.");
+    StopWriter();
+#endif
+
+#ifdef _WIN32
+#ifdef ENABLE_3RVX_LOGTOFILE
     fclose(stdout);
     fclose(stderr);
 #else
@@ -31,4 +209,103 @@ void Logger::Stop() {
     FreeConsole();
 #endif
 #endif
+#endif
+}
+
+void Logger::Level(Levels level) {
+    threshold.store(level);
+    UpdateLevels();
+}
+
+bool Logger::Level(const std::wstring &name) {
+    std::wstring level = Trim(name);
+    if (level.empty()) {
+        Level(Debug);
+        return true;
+    }
+
+    for (int i = 0; i < LevelCount; ++i) {
+        if (EqualsIgnoreCase(level, LevelNames[i])) {
+            Level((Levels) i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::EnableSubsystems(const std::wstring &names) {
+    unsigned int mask = 0;
+    bool listed = false;
+
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(L',', start);
+        if (end == std::wstring::npos) {
+            end = names.size();
+        }
+
+        std::wstring name = Trim(names.substr(start, end - start));
+        start = end + 1;
+        if (name.empty()) {
+            continue;
+        }
+
+        listed = true;
+        if (EqualsIgnoreCase(name, L"all")) {
+            mask = ~0U;
+            continue;
+        }
+
+        for (int i = 0; i < SubsystemCount; ++i) {
+            if (EqualsIgnoreCase(name, SubsystemNames[i])) {
+                mask |= (1U << i);
+                break;
+            }
+        }
+    }
+
+    subsystems.store(listed ? mask : ~0U);
+    UpdateLevels();
+}
+
+bool Logger::Enabled(Subsystems subsystem, Levels level) {
+    return level >= levels[subsystem].load(std::memory_order_relaxed);
+}
+
+void Logger::Log(Levels level, const wchar_t *function, int line,
+        const wchar_t *format, ...) {
+
+    va_list args;
+    va_start(args, format);
+
+    /* Paired with StopWriter(): either it waits for this Push() to finish,
+     * or this thread sees that the writer has stopped. */
+    pushing.fetch_add(1);
+    if (running.load()) {
+        if (queue->Push(level, function, line, format, args)) {
+            wake.notify_one();
+        }
+        pushing.fetch_sub(1);
+    } else {
+        pushing.fetch_sub(1);
+        LogQueue::Record record;
+        LogQueue::Format(record, level, function, line, format, args);
+        Write(record);
+    }
+    va_end(args);
+}
+
+std::wstring Logger::Prefix(unsigned long long milliseconds, int level) {
+    static const wchar_t *labels[LevelCount] = {
+        L"DEBUG", L"INFO", L"WARN", L"ERROR", L"NONE",
+    };
+    const wchar_t *label = L"?";
+    if (level >= 0 && level < LevelCount) {
+        label = labels[level];
+    }
+
+    wchar_t prefix[64];
+    swprintf(prefix, 64, L"%7llu.%03llu %-5ls",
+        milliseconds / 1000, milliseconds % 1000, label);
+    return prefix;
 }
\ No newline at end of file
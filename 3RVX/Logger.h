@@ -8,14 +8,24 @@ Controlling The Logger
     define (/D) FORCE_3RVX_LOG
 - To log to a file instead of the console:
     define (/D) ENABLE_3RVX_LOGTOFILE
+- Each source file logs as part of a subsystem. To choose the subsystem,
+  define LOG_SUBSYSTEM before including any headers:
+    #define LOG_SUBSYSTEM Hotkeys
+  Files that don't define it log as part of the General subsystem.
+- To log only some subsystems, list them in Settings.xml:
+    <logging>hotkeys, osd</logging>
+- Log sites use CLOG for informational entries; DLOG, WLOG, and ELOG log
+  debug output, warnings, and errors. To log only warnings and errors:
+    <logLevel>warning</logLevel>
+- Each entry is printed with the seconds since the first entry was logged
+  and its level.
 
 */
 
 #pragma once
 
-#include <Windows.h>
-#include <Wincon.h>
-#include <tchar.h>
+#include <cstddef>
+#include <string>
 
 #ifdef _DEBUG
     #define ENABLE_3RVX_LOG 1
@@ -27,36 +37,120 @@ Controlling The Logger
     #endif
 #endif
 
-#define FOREGROUND_WHITE (FOREGROUND_RED \
-    | FOREGROUND_GREEN \
-    | FOREGROUND_BLUE)
-
-#define COLORIZE \
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), \
-        FOREGROUND_RED | FOREGROUND_INTENSITY);
+#ifndef LOG_SUBSYSTEM
+    #define LOG_SUBSYSTEM General
+#endif
 
-#define DECOLORIZE \
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), \
-        FOREGROUND_WHITE);
+/* Other compilers don't provide a wide function name literal, so entries are
+ * labeled with the file name instead. */
+#ifdef _MSC_VER
+    #define LOG_FUNCTION __FUNCTIONW__
+#else
+    #define LOG_FUNCTION L"" __FILE__
+#endif
 
-#define CLOG(fmt, ...) \
+/* The format arguments are only evaluated if the log site's subsystem and
+ * level are enabled. When logging is disabled at compile time, the condition
+ * is constant and the whole statement is removed. */
+#define LOG_AT(level, function, line, fmt, ...) \
 do { \
-    if (ENABLE_3RVX_LOG) { \
-        COLORIZE \
-        wprintf(L"[%s:%d]\n", __FUNCTIONW__, __LINE__); \
-        DECOLORIZE \
-        wprintf(fmt L"\n", __VA_ARGS__); \
+    if (ENABLE_3RVX_LOG \
+            && Logger::Enabled(Logger::LOG_SUBSYSTEM, level)) { \
+        Logger::Log(level, function, line, fmt, ##__VA_ARGS__); \
     } \
 } while (0)
 
+#define DLOG(fmt, ...) \
+    LOG_AT(Logger::Debug, LOG_FUNCTION, __LINE__, fmt, ##__VA_ARGS__)
+#define CLOG(fmt, ...) \
+    LOG_AT(Logger::Info, LOG_FUNCTION, __LINE__, fmt, ##__VA_ARGS__)
+#define WLOG(fmt, ...) \
+    LOG_AT(Logger::Warning, LOG_FUNCTION, __LINE__, fmt, ##__VA_ARGS__)
+#define ELOG(fmt, ...) \
+    LOG_AT(Logger::Error, LOG_FUNCTION, __LINE__, fmt, ##__VA_ARGS__)
+
+/* Logs without the function and line */
 #define QCLOG(fmt, ...) \
-if (ENABLE_3RVX_LOG) { wprintf(fmt L"\n", __VA_ARGS__); }
+    LOG_AT(Logger::Info, NULL, 0, fmt, ##__VA_ARGS__)
 
+/// <summary>
+/// Log entries are formatted on the calling thread and handed off to a
+/// background thread that writes them to the console or log file, so logging
+/// from the UI thread doesn't wait on console I/O. Entries logged before
+/// Start() or after Stop() are written immediately.
+/// </summary>
 class Logger {
 public:
+    enum Levels {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        None,
+        LevelCount
+    };
+
+    enum Subsystems {
+        General,
+        Audio,
+        Hotkeys,
+        Language,
+        Meters,
+        OSD,
+        Settings,
+        Skin,
+        Updates,
+        SubsystemCount
+    };
+
+    /// <summary>
+    /// Subsystem names, as used in the settings file (lowercase).
+    /// </summary>
+    static const wchar_t *SubsystemNames[SubsystemCount];
+
+    /// <summary>
+    /// Level names, as used in the settings file (lowercase).
+    /// </summary>
+    static const wchar_t *LevelNames[LevelCount];
+
     static void Start();
     static void Stop();
 
+    /// <summary>
+    /// Entries below the given level are discarded before their arguments
+    /// are evaluated.
+    /// </summary>
+    static void Level(Levels level);
+
+    /// <summary>
+    /// Sets the level by name (ignoring case). An empty name restores the
+    /// default, Debug. Returns false and leaves the level unchanged if the
+    /// name isn't recognized.
+    /// </summary>
+    static bool Level(const std::wstring &name);
+
+    /// <summary>
+    /// Enables logging for the subsystems in a comma-separated list of
+    /// subsystem names and disables the rest. An empty list (or "all")
+    /// enables every subsystem. Unknown names are ignored.
+    /// </summary>
+    static void EnableSubsystems(const std::wstring &names);
+
+    /// <summary>
+    /// Determines whether entries at the given level are being logged for a
+    /// subsystem. This is a single relaxed atomic load, so it can be checked
+    /// at every log site.
+    /// </summary>
+    static bool Enabled(Subsystems subsystem, Levels level);
+
+    static void Log(Levels level, const wchar_t *function, int line,
+        const wchar_t *format, ...);
+
+    /// <summary>
+    /// Formats the start of a log line: the time in seconds and the level.
+    /// </summary>
+    static std::wstring Prefix(unsigned long long milliseconds, int level);
+
 private:
     static FILE *in, *out, *err;
 };
\ No newline at end of file
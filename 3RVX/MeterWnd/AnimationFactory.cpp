@@ -1,5 +1,7 @@
 #include "AnimationFactory.h"
 
+#include "Animations\FadeOut.h"
+
 Animation *AnimationFactory::Create(
         AnimationTypes::HideAnimation anim, int speed) {
 
@@ -1,9 +1,8 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
-#include "FadeOut.h"
-
 class AnimationTypes {
 public:
     enum HideAnimation {
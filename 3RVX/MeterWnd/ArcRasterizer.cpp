@@ -0,0 +1,128 @@
+#include "ArcRasterizer.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+const float Pi = 3.14159265f;
+
+/// <summary>
+/// Converts a signed distance from an edge (positive inside) to the
+/// coverage of a one-pixel box centered at that distance.
+/// </summary>
+float Coverage(float distance) {
+    float c = distance + 0.5f;
+    if (c <= 0.0f) {
+        return 0.0f;
+    }
+    if (c >= 1.0f) {
+        return 1.0f;
+    }
+    return c;
+}
+
+}
+
+ArcRasterizer::ArcRasterizer(int size, float thickness,
+        float start, float sweep) :
+_size(size < 1 ? 1 : size),
+_thickness(thickness),
+_start(start),
+_sweep(sweep) {
+
+}
+
+int ArcRasterizer::Size() const {
+    return _size;
+}
+
+void ArcRasterizer::Rasterize(float fraction, unsigned char *coverage) const {
+    memset(coverage, 0, _size * _size);
+
+    float sweep = _sweep * fraction;
+    if (sweep <= 0.0f) {
+        return;
+    }
+    bool full = (sweep >= 360.0f);
+
+    /* Inward normals of the start and end edges. Up is -y, so an angle a
+     * (clockwise from the top) points along (sin a, -cos a). */
+    float a0 = _start * Pi / 180.0f;
+    float a1 = (_start + sweep) * Pi / 180.0f;
+    float startX = cos(a0);
+    float startY = sin(a0);
+    float endX = -cos(a1);
+    float endY = -sin(a1);
+
+    /* Segments up to a half circle are the intersection of the two
+     * half-planes; larger segments are their union. */
+    bool convex = (sweep <= 180.0f);
+
+    float center = _size / 2.0f;
+    float outer = center;
+    float inner = center - _thickness;
+    if (inner < 0.0f) {
+        inner = 0.0f;
+    }
+
+    float outerSpan = outer + 0.5f;
+    float innerSpan = inner - 0.5f;
+
+    for (int y = 0; y < _size; ++y) {
+        float py = y + 0.5f - center;
+        if (py * py >= outerSpan * outerSpan) {
+            continue;
+        }
+
+        float half = sqrt(outerSpan * outerSpan - py * py);
+        int x0 = (int) floor(center - half);
+        int x1 = (int) ceil(center + half);
+        if (x0 < 0) {
+            x0 = 0;
+        }
+        if (x1 > _size) {
+            x1 = _size;
+        }
+
+        /* Pixels entirely inside the inner circle are empty */
+        int skip0 = x1;
+        int skip1 = x1;
+        if (innerSpan > 0.0f && py * py < innerSpan * innerSpan) {
+            float h = sqrt(innerSpan * innerSpan - py * py);
+            skip0 = (int) ceil(center - h);
+            skip1 = (int) floor(center + h);
+        }
+
+        unsigned char *row = coverage + y * _size;
+        for (int x = x0; x < x1; ++x) {
+            if (x == skip0 && skip1 > skip0) {
+                x = skip1 - 1;
+                continue;
+            }
+
+            float px = x + 0.5f - center;
+            float d = sqrt(px * px + py * py);
+            float radial = Coverage(outer - d);
+            if (inner > 0.0f) {
+                radial *= Coverage(d - inner);
+            }
+            if (radial <= 0.0f) {
+                continue;
+            }
+
+            float angular = 1.0f;
+            if (full == false) {
+                float ds = px * startX + py * startY;
+                float de = px * endX + py * endY;
+                if (convex) {
+                    angular = Coverage(ds < de ? ds : de);
+                } else {
+                    angular = Coverage(ds > de ? ds : de);
+                }
+            }
+
+            row[x] = (unsigned char) (radial * angular * 255.0f + 0.5f);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+/// <summary>
+/// Rasterizes anti-aliased arcs (ring segments) into an 8-bit coverage mask.
+/// Each scanline is clipped to the span covered by the outer circle, and the
+/// span inside the inner circle is skipped; the remaining pixels get their
+/// coverage from their distance to the circles and to the edges of the
+/// segment.
+/// <p>
+/// Angles are in degrees, measured clockwise from the top of the circle.
+/// </summary>
+class ArcRasterizer {
+public:
+    /// <summary>
+    /// Creates a rasterizer for an arc in a square of the given size. A
+    /// thickness of half the size (or more) produces a pie segment.
+    /// </summary>
+    ArcRasterizer(int size, float thickness, float start, float sweep);
+
+    int Size() const;
+
+    /// <summary>
+    /// Renders the arc filled to the given fraction (0 - 1.0) of its sweep.
+    /// The coverage buffer must hold Size() * Size() bytes.
+    /// </summary>
+    void Rasterize(float fraction, unsigned char *coverage) const;
+
+private:
+    int _size;
+    float _thickness;
+    float _start;
+    float _sweep;
+};
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <VersionHelpers.h>
 
 #include "..\Error.h"
+#include "..\Trace.h"
 
 LayeredWnd::LayeredWnd(LPCWSTR className, LPCWSTR title, HINSTANCE hInstance,
     Gdiplus::Bitmap *bitmap, DWORD exStyles) :
@@ -58,6 +59,7 @@ LayeredWnd::~LayeredWnd() {
 }
 
 void LayeredWnd::UpdateWindow(RECT *dirtyRect) {
+    TRACE_SPAN("LayeredWnd::UpdateWindow");
     BLENDFUNCTION bFunc;
     bFunc.AlphaFormat = AC_SRC_ALPHA;
     bFunc.BlendFlags = 0;
@@ -1,12 +1,13 @@
+#define LOG_SUBSYSTEM Meters
+
 #include "Meter.h"
-#include <math.h>
 #include <sstream>
 
 Meter::Meter(std::wstring bitmapName, int x, int y, int units) :
 _value(0.0f),
 _drawnValue(-1.0f),
 _units(units),
-_drawnUnits(-1) {
+_drawnState(-1) {
     _rect.X = x;
     _rect.Y = y;
 
@@ -25,7 +26,7 @@ _bitmap(NULL),
 _value(0.0f),
 _drawnValue(-1.0f),
 _units(units),
-_drawnUnits(-1) {
+_drawnState(-1) {
     _rect.X = x;
     _rect.Y = y;
 }
@@ -46,7 +47,7 @@ void Meter::Value(float value) {
 }
 
 void Meter::UpdateDrawnValues() {
-    _drawnUnits = CalcUnits();
+    _drawnState = DrawState();
     _drawnValue = _value;
 }
 
@@ -61,7 +62,7 @@ bool Meter::Dirty() {
     }
 
     /* Not dirty if the change in value won't affect the meter graphically */
-    if (CalcUnits() == _drawnUnits) {
+    if (DrawState() == _drawnState) {
         return false;
     }
 
@@ -69,7 +70,52 @@ bool Meter::Dirty() {
 }
 
 int Meter::CalcUnits() {
-    return (int) ceil(_value * _units - 0.00001f);
+    return MeterLayout::Units(_value, _units);
+}
+
+int Meter::DrawState() {
+    return CalcUnits();
+}
+
+MeterLayout::Rect Meter::ImageRect() const {
+    MeterLayout::Rect image = { _rect.X, _rect.Y, _rect.Width, _rect.Height };
+    if (_bitmap != NULL) {
+        image.width = (int) _bitmap->GetWidth();
+        image.height = (int) _bitmap->GetHeight();
+    }
+    return image;
+}
+
+Gdiplus::Rect Meter::GdiRect(const MeterLayout::Rect &rect) {
+    return Gdiplus::Rect(rect.x, rect.y, rect.width, rect.height);
+}
+
+void Meter::DrawSmooth(Gdiplus::Graphics *graphics,
+        const MeterLayout::SmoothBlit &blit) {
+
+    const MeterLayout::Rect &src = blit.full.src;
+    graphics->DrawImage(_bitmap, GdiRect(blit.full.dest),
+        src.x, src.y, src.width, src.height, Gdiplus::UnitPixel);
+
+    if (blit.coverage == 0) {
+        return;
+    }
+
+    /* The edge pixels are drawn with their alpha scaled by coverage */
+    Gdiplus::ColorMatrix alpha = {
+        1, 0, 0, 0, 0,
+        0, 1, 0, 0, 0,
+        0, 0, 1, 0, 0,
+        0, 0, 0, blit.coverage / 255.0f, 0,
+        0, 0, 0, 0, 1,
+    };
+    Gdiplus::ImageAttributes attributes;
+    attributes.SetColorMatrix(&alpha);
+
+    const MeterLayout::Rect &edge = blit.edge.src;
+    graphics->DrawImage(_bitmap, GdiRect(blit.edge.dest),
+        edge.x, edge.y, edge.width, edge.height, Gdiplus::UnitPixel,
+        &attributes);
 }
 
 std::wstring Meter::ToString() {
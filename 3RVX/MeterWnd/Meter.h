@@ -6,12 +6,13 @@
 #include <string>
 
 #include "../Logger.h"
+#include "MeterLayout.h"
 
 class Meter {
 public:
     Meter(std::wstring bitmapName, int x, int y, int units);
     Meter(int x, int y, int units);
-    ~Meter();
+    virtual ~Meter();
 
     /// <summary>
     /// Draws the current meter state onto the specified buffer.
@@ -37,6 +38,13 @@ public:
     /// </summary>
     virtual int CalcUnits();
 
+    /// <summary>
+    /// Retrieves a number identifying what the meter draws for its current
+    /// value. The meter is dirty when this differs from the state it was
+    /// last drawn in; by default, the state is the number of units.
+    /// </summary>
+    virtual int DrawState();
+
     /// <summary>
     /// Retrieves the current meter state as a string. This includes
     /// information such as the maximum number of units supported by
@@ -56,8 +64,20 @@ protected:
     /// </summary>
     void UpdateDrawnValues();
 
+    /// <summary>Retrieves the meter bitmap's position and size.</summary>
+    MeterLayout::Rect ImageRect() const;
+
+    static Gdiplus::Rect GdiRect(const MeterLayout::Rect &rect);
+
+    /// <summary>
+    /// Draws a smooth bar from the meter bitmap, blending its leading edge
+    /// by the edge coverage.
+    /// </summary>
+    void DrawSmooth(Gdiplus::Graphics *graphics,
+        const MeterLayout::SmoothBlit &blit);
+
 private:
-    int _drawnUnits;
+    int _drawnState;
     float _value;
     float _drawnValue;
 };
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "MeterLayout.h"
+
+#include <math.h>
+
+int MeterLayout::Units(float value, int units) {
+    return (int) ceil(value * units - 0.00001f);
+}
+
+int MeterLayout::Percent(int units, int drawnUnits) {
+    return (drawnUnits * 100 + units / 2) / units;
+}
+
+MeterLayout::Blit MeterLayout::HorizontalBar(const Rect &image,
+        int units, int drawnUnits, bool reversed) {
+
+    int pixelsPerUnit = image.width / units;
+    int width = pixelsPerUnit * drawnUnits;
+    if (reversed) {
+        width = image.width - width;
+    }
+
+    Blit blit = {
+        { 0, 0, width, image.height },
+        { image.x, image.y, width, image.height },
+    };
+    return blit;
+}
+
+MeterLayout::Blit MeterLayout::VerticalBar(const Rect &image,
+        int units, int drawnUnits) {
+
+    int pixelsPerUnit = image.height / units;
+    int height = pixelsPerUnit * drawnUnits;
+    int yOffset = image.y + image.height - height;
+
+    Blit blit = {
+        { 0, 0, image.width, height },
+        { image.x, yOffset, image.width, height },
+    };
+    return blit;
+}
+
+MeterLayout::SmoothBlit MeterLayout::SmoothHorizontalBar(const Rect &image,
+        float value) {
+
+    int pixels, coverage;
+    Split(value, image.width, pixels, coverage);
+    int edge = (coverage > 0) ? 1 : 0;
+
+    SmoothBlit blit = {
+        {
+            { 0, 0, pixels, image.height },
+            { image.x, image.y, pixels, image.height },
+        },
+        {
+            { pixels, 0, edge, image.height },
+            { image.x + pixels, image.y, edge, image.height },
+        },
+        coverage,
+    };
+    return blit;
+}
+
+MeterLayout::SmoothBlit MeterLayout::SmoothVerticalBar(const Rect &image,
+        float value) {
+
+    int pixels, coverage;
+    Split(value, image.height, pixels, coverage);
+    int edge = (coverage > 0) ? 1 : 0;
+    int top = image.height - pixels;
+
+    SmoothBlit blit = {
+        {
+            { 0, top, image.width, pixels },
+            { image.x, image.y + top, image.width, pixels },
+        },
+        {
+            { 0, top - edge, image.width, edge },
+            { image.x, image.y + top - edge, image.width, edge },
+        },
+        coverage,
+    };
+    return blit;
+}
+
+int MeterLayout::SmoothState(float value, int length) {
+    int pixels, coverage;
+    Split(value, length, pixels, coverage);
+    return pixels * 256 + coverage;
+}
+
+void MeterLayout::Split(float value, int length,
+        int &pixels, int &coverage) {
+
+    float covered = value * length;
+    pixels = (int) floor(covered);
+    coverage = (int) floor((covered - pixels) * 255.0f + 0.5f);
+    if (coverage == 255) {
+        pixels++;
+        coverage = 0;
+    }
+
+    if (pixels >= length) {
+        pixels = length;
+        coverage = 0;
+    } else if (pixels < 0) {
+        pixels = 0;
+        coverage = 0;
+    }
+}
+
+MeterLayout::Blit MeterLayout::Bitstrip(const Rect &image,
+        int units, int drawnUnits) {
+
+    int frameHeight = image.height / units;
+    int stripY = (drawnUnits - 1) * frameHeight;
+    if (drawnUnits == 0) {
+        /* The mute OSD should be shown here, but we'll do something sane
+         * rather than go negative. */
+        stripY = 0;
+    }
+
+    Blit blit = {
+        { 0, stripY, image.width, frameHeight },
+        { image.x, image.y, image.width, frameHeight },
+    };
+    return blit;
+}
+
+int MeterLayout::NumberStrip(const Rect &image, int units, int drawnUnits,
+        Alignment align, Blit *blits) {
+
+    int perc = Percent(units, drawnUnits);
+    int digits[MaxDigits] = {
+        perc % 10,
+        (perc / 10) % 10,
+        perc / 100,
+    };
+
+    int chars = 1;
+    if (digits[2] > 0) {
+        chars = 3;
+    } else if (digits[1] > 0) {
+        chars = 2;
+    }
+
+    /* Digits are placed right to left from the position of the last one.
+     * Skins are laid out for these offsets: 'center' right-aligns the
+     * number in the three-digit space, and 'right' centers it. */
+    int charWidth = image.width;
+    int charHeight = image.height / 10;
+    int drawX = charWidth * 2;
+    if (align == Near) {
+        drawX = (chars - 1) * charWidth;
+    } else if (align == Far) {
+        drawX = (charWidth * 2) - ((3 - chars) * (charWidth / 2));
+    }
+
+    for (int i = 0, x = drawX; i < chars; ++i, x -= charWidth) {
+        Blit blit = {
+            { 0, digits[i] * charHeight, charWidth, charHeight },
+            { image.x + x, image.y, charWidth, charHeight },
+        };
+        blits[i] = blit;
+    }
+
+    return chars;
+}
+
+MeterLayout::Rect MeterLayout::HorizontalTile(const Rect &tile,
+        int units, int drawnUnits, bool reversed) {
+
+    int width = tile.width * drawnUnits;
+    int xShift = 0;
+    if (reversed) {
+        xShift = tile.width * units - width;
+    }
+
+    Rect fill = { tile.x + xShift, tile.y, width, tile.height };
+    return fill;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+/// <summary>
+/// Computes where the bitmap meters draw for a given number of units. The
+/// calculations do not depend on GDI+, so the same geometry the meters use
+/// can be produced without rendering (SkinLint prints it for every bundled
+/// skin) and compared before and after changes to the draw path.
+/// </summary>
+class MeterLayout {
+public:
+    enum Alignment {
+        Near,
+        Center,
+        Far
+    };
+
+    /// <summary>Most digits a NumberStrip draws (for 100%).</summary>
+    static const int MaxDigits = 3;
+
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    /// <summary>
+    /// A copy from a region of the meter bitmap to a region of the OSD.
+    /// </summary>
+    struct Blit {
+        Rect src;
+        Rect dest;
+    };
+
+    /// <summary>
+    /// A bar drawn with sub-pixel precision. The fully covered pixels are
+    /// copied with 'full', and the partially covered column (or row) at the
+    /// leading edge is copied with 'edge' and blended by 'coverage' (0 -
+    /// 255). The edge is empty when coverage is zero.
+    /// </summary>
+    struct SmoothBlit {
+        Blit full;
+        Blit edge;
+        int coverage;
+    };
+
+    /// <summary>
+    /// Converts a meter value (0 - 1.0) to the number of units displayed.
+    /// Any nonzero value shows at least one unit.
+    /// </summary>
+    static int Units(float value, int units);
+
+    /// <summary>
+    /// Converts a number of units to the percentage displayed for it,
+    /// rounded to the nearest whole percent.
+    /// </summary>
+    static int Percent(int units, int drawnUnits);
+
+    /// <summary>
+    /// Layout for a bar that grows to the right; 'image' is the meter bitmap
+    /// placed at its (x, y) position on the OSD.
+    /// </summary>
+    static Blit HorizontalBar(const Rect &image, int units, int drawnUnits,
+        bool reversed);
+
+    /// <summary>Layout for a bar that grows upward.</summary>
+    static Blit VerticalBar(const Rect &image, int units, int drawnUnits);
+
+    /// <summary>
+    /// Layout for a bar that grows to the right in proportion to the value,
+    /// rather than in whole units.
+    /// </summary>
+    static SmoothBlit SmoothHorizontalBar(const Rect &image, float value);
+
+    /// <summary>
+    /// Layout for a bar that grows upward in proportion to the value. The
+    /// image is revealed from the bottom.
+    /// </summary>
+    static SmoothBlit SmoothVerticalBar(const Rect &image, float value);
+
+    /// <summary>
+    /// Identifies the pixels a smooth bar of the given length draws at the
+    /// given value; if two values produce the same state, the bar looks the
+    /// same at both and does not need to be redrawn.
+    /// </summary>
+    static int SmoothState(float value, int length);
+
+    /// <summary>
+    /// Layout for a strip of equally-sized frames stacked vertically, one
+    /// per unit.
+    /// </summary>
+    static Blit Bitstrip(const Rect &image, int units, int drawnUnits);
+
+    /// <summary>
+    /// Layout for a percentage drawn from a strip of ten digit images (0 at
+    /// the top) in a space three digits wide. Fills 'blits' (which must hold
+    /// MaxDigits entries) with one blit per digit, least significant first,
+    /// and returns the number of digits.
+    /// </summary>
+    static int NumberStrip(const Rect &image, int units, int drawnUnits,
+        Alignment align, Blit *blits);
+
+    /// <summary>
+    /// Retrieves the area filled with the repeated tile; the texture is
+    /// anchored at the tile position rather than copied from a source rect.
+    /// </summary>
+    static Rect HorizontalTile(const Rect &tile, int units, int drawnUnits,
+        bool reversed);
+
+private:
+    /// <summary>
+    /// Splits the covered length of a smooth bar into whole pixels and the
+    /// coverage of the next pixel.
+    /// </summary>
+    static void Split(float value, int length, int &pixels, int &coverage);
+};
\ No newline at end of file
@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Meters
+
 #include "MeterWnd.h"
 #include <dwmapi.h>
 #pragma comment(lib, "dwmapi.lib")
@@ -6,6 +8,7 @@
 
 #include "Animation.h"
 #include "AnimationFactory.h"
+#include "../Trace.h"
 
 MeterWnd::MeterWnd(LPCWSTR className, LPCWSTR title, HINSTANCE hInstance) :
 LayeredWnd(className, title, hInstance, NULL, WINDOW_STYLES) {
@@ -22,7 +25,8 @@ MeterWnd::~MeterWnd() {
 }
 
 void MeterWnd::Update() {
-    CLOG(L"Updating meter window");
+    TRACE_SPAN("MeterWnd::Update");
+    DLOG(L"Updating meter window");
     using namespace Gdiplus;
 
     bool dirty = (_composite == NULL);
@@ -35,7 +39,7 @@ void MeterWnd::Update() {
     }
 
     if (dirty) {
-        QCLOG(L"Contents have changed; redrawing");
+        DLOG(L"Contents have changed; redrawing");
 
         if (_composite) {
             delete _composite;
@@ -46,7 +50,8 @@ void MeterWnd::Update() {
         Graphics graphics(_composite);
 
         for (Meter *meter : _meters) {
-            CLOG(L"Drawing meter:\n%s", meter->ToString().c_str());
+            TRACE_SPAN("Meter::Draw");
+            DLOG(L"Drawing meter:\n%s", meter->ToString().c_str());
             meter->Draw(_composite, &graphics);
         }
     }
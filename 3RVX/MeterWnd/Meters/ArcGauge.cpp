@@ -0,0 +1,70 @@
+#include "ArcGauge.h"
+
+ArcGauge::ArcGauge(int x, int y, int size, float thickness,
+        float start, float sweep, int units,
+        std::wstring color, byte transparency) :
+Meter(x, y, units),
+_rasterizer(size, thickness, start, sweep),
+_frames(units + 1, NULL) {
+    _rect.Width = _rasterizer.Size();
+    _rect.Height = _rasterizer.Size();
+
+    unsigned long c = wcstol(color.c_str(), '\0', 16);
+    unsigned long a = transparency << 24;
+    _color = (Gdiplus::ARGB) (c | a);
+}
+
+ArcGauge::~ArcGauge() {
+    for (Gdiplus::Bitmap *frame : _frames) {
+        delete frame;
+    }
+}
+
+void ArcGauge::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
+    int units = CalcUnits();
+    if (units > 0) {
+        graphics->DrawImage(Frame(units), _rect);
+    }
+
+    UpdateDrawnValues();
+}
+
+Gdiplus::Bitmap *ArcGauge::Frame(int units) {
+    if (_frames[units] != NULL) {
+        return _frames[units];
+    }
+
+    int size = _rasterizer.Size();
+    std::vector<unsigned char> coverage(size * size);
+    _rasterizer.Rasterize((float) units / _units, &coverage[0]);
+
+    Gdiplus::Bitmap *frame = new Gdiplus::Bitmap(
+        size, size, PixelFormat32bppPARGB);
+    Gdiplus::Rect rect(0, 0, size, size);
+    Gdiplus::BitmapData data;
+    frame->LockBits(&rect, Gdiplus::ImageLockModeWrite,
+        PixelFormat32bppPARGB, &data);
+
+    unsigned int alpha = (_color >> 24) & 0xFF;
+    unsigned int red = (_color >> 16) & 0xFF;
+    unsigned int green = (_color >> 8) & 0xFF;
+    unsigned int blue = _color & 0xFF;
+
+    for (int y = 0; y < size; ++y) {
+        unsigned char *cov = &coverage[y * size];
+        Gdiplus::ARGB *row = (Gdiplus::ARGB *)
+            ((unsigned char *) data.Scan0 + y * data.Stride);
+        for (int x = 0; x < size; ++x) {
+            /* Premultiplied: each channel is scaled by the pixel alpha */
+            unsigned int a = (alpha * cov[x] + 127) / 255;
+            row[x] = (a << 24)
+                | (((red * a + 127) / 255) << 16)
+                | (((green * a + 127) / 255) << 8)
+                | ((blue * a + 127) / 255);
+        }
+    }
+
+    frame->UnlockBits(&data);
+    _frames[units] = frame;
+    return frame;
+}
\ No newline at end of file
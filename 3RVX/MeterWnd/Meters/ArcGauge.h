@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../Meter.h"
+#include "../ArcRasterizer.h"
+#include <vector>
+
+/// <summary>
+/// A meter drawn as a solid-colored arc (or ring) that fills clockwise as
+/// the value increases. The arc is rasterized rather than loaded from an
+/// image; each unit value is rendered the first time it is shown and kept
+/// for later draws.
+/// </summary>
+class ArcGauge : public Meter {
+public:
+    ArcGauge(int x, int y, int size, float thickness,
+        float start, float sweep, int units,
+        std::wstring color, byte transparency);
+    ~ArcGauge();
+
+    virtual void Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics);
+
+private:
+    ArcRasterizer _rasterizer;
+    Gdiplus::ARGB _color;
+
+    /// <summary>Rendered arcs, indexed by unit value.</summary>
+    std::vector<Gdiplus::Bitmap *> _frames;
+
+    Gdiplus::Bitmap *Frame(int units);
+};
\ No newline at end of file
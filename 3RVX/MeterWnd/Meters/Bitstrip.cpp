@@ -6,17 +6,12 @@ Meter(bitmapName, x, y, units) {
 }
 
 void Bitstrip::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
-    int units = CalcUnits();
-    int stripY = (units - 1) * _rect.Height;
+    MeterLayout::Blit blit = MeterLayout::Bitstrip(
+        ImageRect(), _units, CalcUnits());
 
-    if (units == 0) {
-        /* The mute OSD should be shown here, but we'll do something sane
-         * rather than go negative. */
-        stripY = 0;
-    }
-
-    graphics->DrawImage(_bitmap, _rect,
-        0, stripY, _rect.Width, _rect.Height, Gdiplus::UnitPixel);
+    graphics->DrawImage(_bitmap, GdiRect(blit.dest),
+        blit.src.x, blit.src.y, blit.src.width, blit.src.height,
+        Gdiplus::UnitPixel);
 
     UpdateDrawnValues();
 }
\ No newline at end of file
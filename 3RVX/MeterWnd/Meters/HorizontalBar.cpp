@@ -1,24 +1,34 @@
 #include "HorizontalBar.h"
 
 HorizontalBar::HorizontalBar(std::wstring bitmapName, int x, int y,
-    int units, bool reversed) :
+    int units, bool reversed, bool smooth) :
 Meter(bitmapName, x, y, units),
-_pixelsPerUnit(_rect.Width / _units),
-_reversed(reversed) {
+_reversed(reversed),
+_smooth(smooth) {
 
 }
 
 void HorizontalBar::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
-    int width = _pixelsPerUnit * CalcUnits();
-
-    if (_reversed) {
-        width = _rect.Width - width;
+    if (_smooth) {
+        DrawSmooth(graphics,
+            MeterLayout::SmoothHorizontalBar(ImageRect(), Value()));
+        UpdateDrawnValues();
+        return;
     }
 
-    Gdiplus::Rect drawRect(_rect.X, _rect.Y, width, _rect.Height);
+    MeterLayout::Blit blit = MeterLayout::HorizontalBar(
+        ImageRect(), _units, CalcUnits(), _reversed);
 
-    graphics->DrawImage(_bitmap, drawRect,
-        0, 0, width, _rect.Height, Gdiplus::UnitPixel);
+    graphics->DrawImage(_bitmap, GdiRect(blit.dest),
+        blit.src.x, blit.src.y, blit.src.width, blit.src.height,
+        Gdiplus::UnitPixel);
 
     UpdateDrawnValues();
+}
+
+int HorizontalBar::DrawState() {
+    if (_smooth) {
+        return MeterLayout::SmoothState(Value(), _rect.Width);
+    }
+    return Meter::DrawState();
 }
\ No newline at end of file
@@ -5,11 +5,18 @@
 class HorizontalBar : public Meter {
 public:
     HorizontalBar(std::wstring bitmapName, int x, int y,
-        int units, bool reversed = false);
+        int units, bool reversed = false, bool smooth = false);
 
     virtual void Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics);
 
+    /// <summary>
+    /// In smooth mode, the state is the drawn length in pixels and the
+    /// coverage of the edge pixel, so values that differ by less than the
+    /// smallest visible change do not cause a redraw.
+    /// </summary>
+    virtual int DrawState();
+
 private:
-    int _pixelsPerUnit;
     bool _reversed;
+    bool _smooth;
 };
\ No newline at end of file
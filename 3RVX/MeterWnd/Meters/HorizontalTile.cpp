@@ -8,16 +8,10 @@ HorizontalTile::~HorizontalTile()
 
 void HorizontalTile::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics)
 {
-    int width = _rect.Width * CalcUnits();
+    MeterLayout::Rect fill = MeterLayout::HorizontalTile(
+        ImageRect(), _units, CalcUnits(), _reverse);
 
-    if (_reverse == false) {
-        graphics->FillRectangle(_texture,
-            _rect.X, _rect.Y, width, _rect.Height);
-    } else {
-        int xShift = _rect.Width * Units() - width;
-        graphics->FillRectangle(_texture,
-            _rect.X + xShift, _rect.Y, width, _rect.Height);
-    }
+    graphics->FillRectangle(_texture, GdiRect(fill));
 
     UpdateDrawnValues();
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ArcGauge.h"
 #include "Bitstrip.h"
 #include "HorizontalBar.h"
 #include "HorizontalEndcap.h"
@@ -2,37 +2,35 @@
 
 #include <sstream>
 
-void NumberStrip::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
-    int units = CalcUnits();
-    int perc = units * (100 / _units);
-
-    int digits[] = {
-        perc % 10,
-        (perc / 10) % 10,
-        perc / 100,
-    };
-
-    int chars = 1;
-    if (digits[1] > 0) {
-        chars = 2;
-    } else if (digits[2] > 0) {
-        chars = 3;
+NumberStrip::NumberStrip(std::wstring bitmapName, int x, int y, int units,
+        Gdiplus::StringAlignment align) :
+Meter(bitmapName, x, y, units),
+_align(align),
+_layouts(units + 1) {
+    MeterLayout::Rect image = ImageRect();
+    _rect.Width = image.width * MeterLayout::MaxDigits;
+    _rect.Height = image.height / 10;
+
+    MeterLayout::Alignment layoutAlign = MeterLayout::Center;
+    if (align == Gdiplus::StringAlignmentNear) {
+        layoutAlign = MeterLayout::Near;
+    } else if (align == Gdiplus::StringAlignmentFar) {
+        layoutAlign = MeterLayout::Far;
     }
 
-    int drawX = _charWidth * 2;
-    if (_align == Gdiplus::StringAlignmentNear) {
-        drawX = (chars - 1) * _charWidth;
-    } else if (_align == Gdiplus::StringAlignmentFar) {
-        drawX = (_charWidth * 2) - ((3 - chars) * (_charWidth / 2));
+    for (int i = 0; i <= units; ++i) {
+        Layout &layout = _layouts[i];
+        layout.count = MeterLayout::NumberStrip(
+            image, units, i, layoutAlign, layout.blits);
     }
+}
 
-    for (int i = 0, x = drawX; i < chars; ++i, x -= _charWidth) {
-        int digit = digits[i];
-        QCLOG(L"Drawing digit [%d]; x-offset: %d", digit, _rect.X + x);
-
-        Gdiplus::Rect destRect(_rect.X + x, _rect.Y, _charWidth, _rect.Height);
-        graphics->DrawImage(_bitmap, destRect,
-            0, digit * _rect.Height, _charWidth, _rect.Height,
+void NumberStrip::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
+    const Layout &layout = _layouts[CalcUnits()];
+    for (int i = 0; i < layout.count; ++i) {
+        const MeterLayout::Blit &blit = layout.blits[i];
+        graphics->DrawImage(_bitmap, GdiRect(blit.dest),
+            blit.src.x, blit.src.y, blit.src.width, blit.src.height,
             Gdiplus::UnitPixel, NULL, NULL, NULL);
     }
 
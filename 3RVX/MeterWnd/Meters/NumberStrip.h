@@ -1,26 +1,33 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "../Meter.h"
 
 class NumberStrip : public Meter {
 public:
-
     NumberStrip(std::wstring bitmapName, int x, int y, int units,
-        Gdiplus::StringAlignment align):
-    Meter(bitmapName, x, y, units),
-    _align(align) {
-        _charWidth = _bitmap->GetWidth();
-
-        _rect.Width = _bitmap->GetWidth() * 3;
-        _rect.Height = _bitmap->GetHeight() / 10;
-    }
+        Gdiplus::StringAlignment align);
 
     virtual void Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics);
     virtual std::wstring ToString();
 
 private:
+    /// <summary>
+    /// The digits drawn for one unit value; only the first 'count' blits
+    /// are used.
+    /// </summary>
+    struct Layout {
+        int count;
+        MeterLayout::Blit blits[MeterLayout::MaxDigits];
+    };
+
     Gdiplus::StringAlignment _align;
-    int _charWidth;
+
+    /// <summary>
+    /// Digit layouts for every unit value, computed when the meter is
+    /// created so drawing is only the blits.
+    /// </summary>
+    std::vector<Layout> _layouts;
 };
\ No newline at end of file
@@ -1,47 +1,145 @@
 #include "Text.h"
-#include <algorithm>
+#include <math.h>
 
 Text::Text(int x, int y, int width, int height,
         Gdiplus::Font *font, Gdiplus::StringAlignment align,
         std::wstring color, byte transparency,
         std::wstring formatString) :
 Meter(x, y, 100),
-_font(font->Clone()),
-_formatString(formatString) {
+_align(align),
+_atlas(NULL),
+_layout(formatString),
+_order(_layout.MaxGlyphs()),
+_font(NULL),
+_brush(NULL) {
     _rect.Width = width;
     _rect.Height = height;
 
-    _strFormat.SetAlignment(align);
-
     unsigned long c = wcstol(color.c_str(), '\0', 16);
     unsigned long a = transparency << 24;
-    _fontColor = new Gdiplus::SolidBrush(c | a);
 
-    _replaceIndex = _formatString.find(L"[[PERC]]");
+    if (TextLayout::NeedsShaping(
+            _layout.PrefixText() + _layout.SuffixText())) {
+        _font = font->Clone();
+        _brush = new Gdiplus::SolidBrush((Gdiplus::ARGB) (c | a));
+        _format.SetAlignment(align);
+        return;
+    }
+
+    BuildAtlas(font, (Gdiplus::ARGB) (c | a), _layout.Cells());
 }
 
 Text::~Text()
 {
+    delete _atlas;
     delete _font;
-    delete _fontColor;
+    delete _brush;
+}
+
+void Text::BuildAtlas(Gdiplus::Font *font, Gdiplus::ARGB color,
+        const std::vector<std::wstring> &chars) {
+
+    /* The typographic format measures and draws glyphs without the padding
+     * DrawString normally adds, so advances can simply be summed. */
+    Gdiplus::StringFormat format(Gdiplus::StringFormat::GenericTypographic());
+    format.SetFormatFlags(format.GetFormatFlags()
+        | Gdiplus::StringFormatFlagsMeasureTrailingSpaces);
+
+    Gdiplus::Bitmap scratch(1, 1, PixelFormat32bppPARGB);
+    Gdiplus::Graphics measure(&scratch);
+    measure.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAlias);
+
+    int height = (int) ceil(font->GetHeight(&measure));
+    _pad = (int) ceil(font->GetHeight(&measure) / 4.0f);
+
+    int atlasWidth = 0;
+    for (const std::wstring &ch : chars) {
+        Gdiplus::RectF box;
+        measure.MeasureString(ch.c_str(), (int) ch.size(), font,
+            Gdiplus::PointF(0, 0), &format, &box);
+
+        Glyph glyph;
+        glyph.advance = box.Width;
+        glyph.src.X = atlasWidth;
+        glyph.src.Y = 0;
+        glyph.src.Width = (int) ceil(box.Width) + 2 * _pad;
+        glyph.src.Height = height;
+        _glyphs.push_back(glyph);
+
+        atlasWidth += glyph.src.Width;
+    }
+
+    _atlas = new Gdiplus::Bitmap(
+        (atlasWidth > 0) ? atlasWidth : 1, (height > 0) ? height : 1,
+        PixelFormat32bppPARGB);
+    Gdiplus::Graphics graphics(_atlas);
+    graphics.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAlias);
+    Gdiplus::SolidBrush brush(color);
+
+    for (unsigned int i = 0; i < chars.size(); ++i) {
+        Gdiplus::PointF origin((float) (_glyphs[i].src.X + _pad), 0);
+        graphics.DrawString(chars[i].c_str(), (int) chars[i].size(), font,
+            origin, &format, &brush);
+    }
 }
 
 void Text::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics)
 {
     int units = CalcUnits();
+    int perc = MeterLayout::Percent(_units, units);
+    if (_atlas == NULL) {
+        DrawShaped(graphics, perc);
+        UpdateDrawnValues();
+        return;
+    }
 
-    Gdiplus::RectF layoutRect((float) _rect.X, (float) _rect.Y, 
-        (float) _rect.Width, (float) _rect.Height);
-
-    graphics->SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAlias);
+    int count = _layout.Glyphs(perc, _order.data());
+    float width = 0;
+    for (int i = 0; i < count; ++i) {
+        width += _glyphs[_order[i]].advance;
+    }
 
-    wchar_t perc[4];
-    _itow_s(units * (100 / _units), perc, 10);
-    std::wstring tempstr(_formatString);
-    const wchar_t *str = tempstr.replace(_replaceIndex, 8, perc).c_str();
+    float x = (float) _rect.X;
+    if (_align == Gdiplus::StringAlignmentCenter) {
+        x += (_rect.Width - width) / 2.0f;
+    } else if (_align == Gdiplus::StringAlignmentFar) {
+        x += _rect.Width - width;
+    }
 
-    graphics->DrawString(str, -1, _font, layoutRect, 
-        &_strFormat, _fontColor);
+    for (int i = 0; i < count; ++i) {
+        DrawGlyph(graphics, _order[i], x);
+    }
 
     UpdateDrawnValues();
+}
+
+void Text::DrawGlyph(Gdiplus::Graphics *graphics, int glyph, float &x) {
+    Gdiplus::Rect src = _glyphs[glyph].src;
+    Gdiplus::Rect dest((int) floor(x + 0.5f) - _pad, _rect.Y,
+        src.Width, src.Height);
+
+    /* Like DrawString, text does not extend outside the meter's area */
+    Gdiplus::Rect clipped;
+    if (Gdiplus::Rect::Intersect(clipped, dest, _rect)) {
+        src.X += clipped.X - dest.X;
+        src.Y += clipped.Y - dest.Y;
+        graphics->DrawImage(_atlas, clipped,
+            src.X, src.Y, clipped.Width, clipped.Height, Gdiplus::UnitPixel);
+    }
+
+    x += _glyphs[glyph].advance;
+}
+
+void Text::DrawShaped(Gdiplus::Graphics *graphics, int perc) {
+    std::wstring text(_layout.PrefixText());
+    if (_layout.HasPerc()) {
+        text += std::to_wstring(perc);
+    }
+    text += _layout.SuffixText();
+
+    Gdiplus::RectF layoutRect((float) _rect.X, (float) _rect.Y,
+        (float) _rect.Width, (float) _rect.Height);
+    graphics->SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAlias);
+    graphics->DrawString(text.c_str(), (int) text.size(), _font, layoutRect,
+        &_format, _brush);
 }
\ No newline at end of file
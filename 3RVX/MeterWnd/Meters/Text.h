@@ -1,8 +1,21 @@
 #pragma once
 
 #include "../Meter.h"
+#include "../TextLayout.h"
 #include <string>
+#include <vector>
 
+/// <summary>
+/// Draws the meter value as a percentage, substituted for [[PERC]] in a
+/// format string. Every character the meter can show (the digits plus the
+/// rest of the format string) is rasterized once, when the meter is
+/// created, into a glyph atlas; drawing lays the text out from the cached
+/// advance widths and copies each glyph from the atlas.
+/// <p>
+/// Format strings that need shaping (combining marks, right-to-left or
+/// complex scripts) can't be drawn a character at a time, so they are drawn
+/// with DrawString instead.
+/// </summary>
 class Text : public Meter {
 public:
     Text(int x, int y, int width, int height,
@@ -14,9 +27,42 @@ public:
     virtual void Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics);
 
 protected:
+    struct Glyph {
+        /// <summary>The glyph's cell in the atlas.</summary>
+        Gdiplus::Rect src;
+
+        /// <summary>Distance to the start of the next character.</summary>
+        float advance;
+    };
+
+    Gdiplus::StringAlignment _align;
+
+    /// <summary>The glyph atlas, or NULL if the text needs shaping.</summary>
+    Gdiplus::Bitmap *_atlas;
+    std::vector<Glyph> _glyphs;
+
+    /// <summary>
+    /// Space left on either side of each glyph in the atlas for parts of
+    /// the glyph that extend past its advance (italics, for instance).
+    /// </summary>
+    int _pad;
+
+    /// <summary>
+    /// Maps the text for each percentage to glyphs; the digits are always
+    /// the first ten.
+    /// </summary>
+    TextLayout _layout;
+
+    /// <summary>Glyphs being drawn, sized for the longest text.</summary>
+    std::vector<int> _order;
+
+    /* Used instead of the atlas when the text needs shaping */
     Gdiplus::Font *_font;
-    Gdiplus::SolidBrush *_fontColor;
-    Gdiplus::StringFormat _strFormat;
-    std::wstring _formatString;
-    int _replaceIndex; // index of [[PERC]] string
+    Gdiplus::SolidBrush *_brush;
+    Gdiplus::StringFormat _format;
+
+    void BuildAtlas(Gdiplus::Font *font, Gdiplus::ARGB color,
+        const std::vector<std::wstring> &chars);
+    void DrawGlyph(Gdiplus::Graphics *graphics, int glyph, float &x);
+    void DrawShaped(Gdiplus::Graphics *graphics, int perc);
 };
\ No newline at end of file
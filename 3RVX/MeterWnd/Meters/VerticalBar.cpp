@@ -1,25 +1,34 @@
 #include "VerticalBar.h"
 
 VerticalBar::VerticalBar(std::wstring bitmapName, int x, int y,
-    int units, bool reversed) :
+    int units, bool reversed, bool smooth) :
 Meter(bitmapName, x, y, units),
-_pixelsPerUnit(_rect.Height / _units),
-_reversed(reversed) {
+_reversed(reversed),
+_smooth(smooth) {
 
 }
 
 void VerticalBar::Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics) {
-    int height = _pixelsPerUnit * CalcUnits();
-    int yOffset = _rect.Y + _rect.Height - height;
+    if (_smooth) {
+        DrawSmooth(graphics,
+            MeterLayout::SmoothVerticalBar(ImageRect(), Value()));
+        UpdateDrawnValues();
+        return;
+    }
 
-/*    if (_reversed) {
-        width = _rect.Width - width;
-    }*/
+    MeterLayout::Blit blit = MeterLayout::VerticalBar(
+        ImageRect(), _units, CalcUnits());
 
-    Gdiplus::Rect drawRect(_rect.X, yOffset, _rect.Width, height);
-
-    graphics->DrawImage(_bitmap, drawRect,
-        0, 0, _rect.Width, height, Gdiplus::UnitPixel);
+    graphics->DrawImage(_bitmap, GdiRect(blit.dest),
+        blit.src.x, blit.src.y, blit.src.width, blit.src.height,
+        Gdiplus::UnitPixel);
 
     UpdateDrawnValues();
+}
+
+int VerticalBar::DrawState() {
+    if (_smooth) {
+        return MeterLayout::SmoothState(Value(), _rect.Height);
+    }
+    return Meter::DrawState();
 }
\ No newline at end of file
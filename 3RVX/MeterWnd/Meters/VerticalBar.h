@@ -5,11 +5,17 @@
 class VerticalBar : public Meter {
 public:
     VerticalBar(std::wstring bitmapName, int x, int y,
-        int units, bool reversed = false);
+        int units, bool reversed = false, bool smooth = false);
 
     virtual void Draw(Gdiplus::Bitmap *buffer, Gdiplus::Graphics *graphics);
 
+    /// <summary>
+    /// In smooth mode, tracks the drawn height rather than the units (as
+    /// HorizontalBar does for its width).
+    /// </summary>
+    virtual int DrawState();
+
 private:
-    int _pixelsPerUnit;
     bool _reversed;
+    bool _smooth;
 };
\ No newline at end of file
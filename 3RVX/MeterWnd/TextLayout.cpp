@@ -0,0 +1,142 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+
+namespace {
+
+const wchar_t *PercToken = L"[[PERC]]";
+const int PercTokenLength = 8;
+
+bool IsHighSurrogate(wchar_t ch) {
+    return ch >= 0xD800 && ch <= 0xDBFF;
+}
+
+bool IsLowSurrogate(wchar_t ch) {
+    return ch >= 0xDC00 && ch <= 0xDFFF;
+}
+
+}
+
+TextLayout::TextLayout(const std::wstring &format) :
+_prefixText(format) {
+    size_t replaceIndex = format.find(PercToken);
+    _hasPerc = (replaceIndex != std::wstring::npos);
+    if (_hasPerc) {
+        _prefixText = format.substr(0, replaceIndex);
+        _suffixText = format.substr(replaceIndex + PercTokenLength);
+    }
+
+    for (wchar_t digit = L'0'; digit <= L'9'; ++digit) {
+        _cells.push_back(std::wstring(1, digit));
+    }
+    for (const std::wstring &ch : Characters(_prefixText)) {
+        _prefix.push_back(Cell(ch));
+    }
+    for (const std::wstring &ch : Characters(_suffixText)) {
+        _suffix.push_back(Cell(ch));
+    }
+}
+
+const std::wstring &TextLayout::PrefixText() const {
+    return _prefixText;
+}
+
+const std::wstring &TextLayout::SuffixText() const {
+    return _suffixText;
+}
+
+bool TextLayout::HasPerc() const {
+    return _hasPerc;
+}
+
+const std::vector<std::wstring> &TextLayout::Cells() const {
+    return _cells;
+}
+
+size_t TextLayout::MaxGlyphs() const {
+    return _prefix.size() + (_hasPerc ? MaxDigits : 0) + _suffix.size();
+}
+
+int TextLayout::Glyphs(int perc, int *glyphs) const {
+    int count = 0;
+    for (int glyph : _prefix) {
+        glyphs[count++] = glyph;
+    }
+
+    if (_hasPerc) {
+        /* Digits are collected least significant first, then reversed */
+        int *digits = glyphs + count;
+        int numDigits = 0;
+        do {
+            digits[numDigits++] = perc % 10;
+            perc /= 10;
+        } while (perc > 0 && numDigits < MaxDigits);
+        std::reverse(digits, digits + numDigits);
+        count += numDigits;
+    }
+
+    for (int glyph : _suffix) {
+        glyphs[count++] = glyph;
+    }
+    return count;
+}
+
+int TextLayout::Cell(const std::wstring &ch) {
+    /* Each distinct character gets one cell */
+    auto it = std::find(_cells.begin(), _cells.end(), ch);
+    if (it != _cells.end()) {
+        return (int) (it - _cells.begin());
+    }
+    _cells.push_back(ch);
+    return (int) _cells.size() - 1;
+}
+
+bool TextLayout::NeedsShaping(const std::wstring &text) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned int ch = text[i];
+        if (IsHighSurrogate(text[i]) && i + 1 < text.size()
+                && IsLowSurrogate(text[i + 1])) {
+            ch = 0x10000 + ((ch - 0xD800) << 10) + (text[i + 1] - 0xDC00);
+            ++i;
+        }
+
+        if ((ch >= 0x0300 && ch <= 0x036F)      /* Combining marks */
+            || (ch >= 0x0483 && ch <= 0x0489)
+            || (ch >= 0x0590 && ch <= 0x08FF)   /* Hebrew - Arabic ext. */
+            || (ch >= 0x0900 && ch <= 0x0DFF)   /* Indic */
+            || (ch >= 0x0E00 && ch <= 0x109F)   /* Thai - Myanmar */
+            || (ch >= 0x1100 && ch <= 0x11FF)   /* Hangul Jamo */
+            || (ch >= 0x1780 && ch <= 0x18AF)   /* Khmer, Mongolian */
+            || (ch >= 0x1A00 && ch <= 0x1AFF)
+            || (ch >= 0x1B00 && ch <= 0x1DFF)
+            || (ch >= 0x200C && ch <= 0x200F)   /* Joiners, direction */
+            || (ch >= 0x202A && ch <= 0x202E)
+            || (ch >= 0x2066 && ch <= 0x2069)
+            || (ch >= 0x20D0 && ch <= 0x20FF)
+            || (ch >= 0xA800 && ch <= 0xABFF)
+            || (ch >= 0xD800 && ch <= 0xDFFF)   /* Unpaired surrogates */
+            || (ch >= 0xFB1D && ch <= 0xFDFF)   /* Presentation forms */
+            || (ch >= 0xFE00 && ch <= 0xFE0F)   /* Variation selectors */
+            || (ch >= 0xFE20 && ch <= 0xFE2F)
+            || (ch >= 0xFE70 && ch <= 0xFEFF)
+            || (ch >= 0x1F3FB && ch <= 0x1F3FF) /* Emoji modifiers */
+            || (ch >= 0xE0000)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::wstring> TextLayout::Characters(const std::wstring &text) {
+    std::vector<std::wstring> chars;
+    for (size_t i = 0; i < text.size(); ++i) {
+        size_t length = 1;
+        if (IsHighSurrogate(text[i]) && i + 1 < text.size()
+                && IsLowSurrogate(text[i + 1])) {
+            length = 2;
+        }
+        chars.push_back(text.substr(i, length));
+        i += length - 1;
+    }
+    return chars;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Splits the format string of a Text meter around [[PERC]] and maps each
+/// of its characters to a cell in the meter's glyph atlas. None of this
+/// depends on GDI+, so the text drawn for each percentage can be checked
+/// (and timed) without rendering it.
+/// </summary>
+class TextLayout {
+public:
+    /// <summary>Most digits in a percentage (for 100%).</summary>
+    static const int MaxDigits = 3;
+
+    TextLayout(const std::wstring &format);
+
+    /// <summary>
+    /// Text before and after [[PERC]]. Without [[PERC]], the whole format
+    /// string is the prefix.
+    /// </summary>
+    const std::wstring &PrefixText() const;
+    const std::wstring &SuffixText() const;
+    bool HasPerc() const;
+
+    /// <summary>
+    /// Retrieves the characters that get an atlas cell, in cell order: the
+    /// ten digits, followed by each distinct character of the format string.
+    /// </summary>
+    const std::vector<std::wstring> &Cells() const;
+
+    /// <summary>Most glyphs Glyphs() produces for any percentage.</summary>
+    size_t MaxGlyphs() const;
+
+    /// <summary>
+    /// Fills 'glyphs' (which must hold MaxGlyphs() entries) with the cells
+    /// of the text shown for a percentage, in drawing order, and returns the
+    /// number of glyphs. Nothing is allocated, so this can be called on
+    /// every redraw.
+    /// </summary>
+    int Glyphs(int perc, int *glyphs) const;
+
+    /// <summary>
+    /// Determines whether the text contains characters that can't be drawn
+    /// independently of their neighbors.
+    /// </summary>
+    static bool NeedsShaping(const std::wstring &text);
+
+    /// <summary>
+    /// Splits text into the units that get an atlas cell: single UTF-16
+    /// characters, or surrogate pairs.
+    /// </summary>
+    static std::vector<std::wstring> Characters(const std::wstring &text);
+
+private:
+    std::wstring _prefixText;
+    std::wstring _suffixText;
+    bool _hasPerc;
+
+    std::vector<std::wstring> _cells;
+    std::vector<int> _prefix;
+    std::vector<int> _suffix;
+
+    int Cell(const std::wstring &ch);
+};
\ No newline at end of file
@@ -1,8 +1,10 @@
+#define LOG_SUBSYSTEM OSD
+
 #include "EjectOSD.h"
 
 #include <Dbt.h>
 
-#include "..\HotkeyInfo.h"
+#include "..\HotkeyAction.h"
 #include "..\Monitor.h"
 #include "..\Skin.h"
 #include "..\SkinManager.h"
@@ -25,11 +27,7 @@ _mWnd(L"3RVX-EjectOSD", L"3RVX-EjectOSD") {
     }
 
     _mWnd.Update();
-
-    Settings *settings = Settings::Instance();
-    _mWnd.AlwaysOnTop(settings->AlwaysOnTop());
-    _mWnd.HideAnimation(settings->HideAnim(), settings->HideSpeed());
-    _mWnd.VisibleDuration(settings->HideDelay());
+    ApplyWindowSettings(_mWnd);
 
     UpdateWindowPositions(ActiveMonitors());
 }
@@ -38,14 +36,14 @@ EjectOSD::~EjectOSD() {
 
 }
 
-void EjectOSD::EjectDrive(std::wstring driveLetter) {
-    std::wstring name = L"\\\\.\\" + driveLetter + L":";
+void EjectOSD::EjectDrive(wchar_t driveLetter) {
+    std::wstring name = L"\\\\.\\" + std::wstring(1, driveLetter) + L":";
     CLOG(L"Ejecting %s", name.c_str());
 
     HANDLE dev = CreateFile(name.c_str(),
         GENERIC_READ, FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, NULL);
     if (dev == INVALID_HANDLE_VALUE) {
-        CLOG(L"Failed to get device handle");
+        ELOG(L"Failed to get device handle");
         return;
     }
 
@@ -58,9 +56,9 @@ void EjectOSD::EjectDrive(std::wstring driveLetter) {
         NULL, NULL, NULL, NULL, &bytesReturned, NULL);
 
     if (success) {
-        std::wstring rootPath = driveLetter + L":\\";
+        std::wstring rootPath = std::wstring(1, driveLetter) + L":\\";
         if (GetDriveType(rootPath.c_str()) != DRIVE_CDROM) {
-            int driveBit = (int) pow(2, (driveLetter.at(0) - 65));
+            int driveBit = (int) pow(2, (driveLetter - 65));
             _ignoreDrives |= driveBit;
             CLOG(L"Added drive bit %d to ignore list", driveBit);
         }
@@ -75,19 +73,17 @@ void EjectOSD::Hide() {
     _mWnd.Hide(false);
 }
 
-void EjectOSD::ProcessHotkeys(HotkeyInfo &hki) {
-    switch (hki.action) {
+void EjectOSD::ProcessHotkeys(HotkeyAction &hka) {
+    switch (hka.action) {
     case HotkeyInfo::EjectDrive:
-        if (hki.args.size() > 0) {
-            EjectDrive(hki.args[0]);
+        if (hka.drive != 0) {
+            EjectDrive(hka.drive);
         }
         break;
 
     case HotkeyInfo::EjectLastDisk:
         if (_latestDrive != 0) {
-            wchar_t letter = MaskToDriveLetter(_latestDrive);
-            std::wstring lStr(1, letter);
-            EjectDrive(lStr);
+            EjectDrive(MaskToDriveLetter(_latestDrive));
             _latestDrive = 0;
         }
 
@@ -95,6 +91,10 @@ void EjectOSD::ProcessHotkeys(HotkeyInfo &hki) {
     }
 }
 
+void EjectOSD::UpdateWindowSettings() {
+    ApplyWindowSettings(_mWnd);
+}
+
 void EjectOSD::UpdateWindowPositions(std::vector<Monitor> &monitors) {
     PositionWindow(monitors[0], _mWnd);
 }
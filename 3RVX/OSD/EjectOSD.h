@@ -10,14 +10,15 @@ public:
     ~EjectOSD();
 
     virtual void Hide();
-    virtual void ProcessHotkeys(HotkeyInfo &hki);
+    virtual void ProcessHotkeys(HotkeyAction &hka);
+    virtual void UpdateWindowSettings();
 
 private:
     DWORD _ignoreDrives;
     DWORD _latestDrive;
     MeterWnd _mWnd;
 
-    void EjectDrive(std::wstring driveLetter);
+    void EjectDrive(wchar_t driveLetter);
     virtual void UpdateWindowPositions(std::vector<Monitor> &monitors);
 
     DWORD DriveLetterToMask(wchar_t letter);
@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM OSD
+
 #include "OSD.h"
 
 #include <algorithm>
@@ -5,7 +7,7 @@
 #include "..\3RVX.h"
 #include "..\DisplayManager.h"
 #include "..\Error.h"
-#include "..\HotkeyInfo.h"
+#include "..\HotkeyAction.h"
 #include "..\Monitor.h"
 
 OSD::OSD(LPCWSTR className, HINSTANCE hInstance) :
@@ -55,6 +57,17 @@ void OSD::HideOthers(OSDType except = All) {
     SendMessage(_masterWnd, WM_3RVX_CONTROL, MSG_HIDEOSD, except);
 }
 
+void OSD::ApplyWindowSettings(MeterWnd &mWnd) {
+    Settings *settings = Settings::Instance();
+    mWnd.AlwaysOnTop(settings->AlwaysOnTop());
+    mWnd.HideAnimation(settings->HideAnim(), settings->HideSpeed());
+    mWnd.VisibleDuration(settings->HideDelay());
+}
+
+void OSD::Reposition() {
+    UpdateWindowPositions(ActiveMonitors());
+}
+
 std::vector<Monitor> OSD::ActiveMonitors() {
     std::vector<Monitor> monitors;
     std::wstring monitorStr = Settings::Instance()->Monitor();
@@ -105,22 +118,22 @@ void OSD::PositionWindow(Monitor monitor, LayeredWnd &lWnd) {
 
     /* Edge cases ;-) */
     switch (pos) {
-    case Settings::TopLeft:
+    case Settings::OSDPos::TopLeft:
         lWnd.X(monitor.X() + offset);
         lWnd.Y(monitor.Y() + offset);
         return;
 
-    case Settings::TopRight:
+    case Settings::OSDPos::TopRight:
         lWnd.X(monitor.X() + monitor.Width() - lWnd.Width() - offset);
         lWnd.Y(monitor.Y() + offset);
         return;
 
-    case Settings::BottomLeft:
+    case Settings::OSDPos::BottomLeft:
         lWnd.X(monitor.X() + offset);
         lWnd.Y(monitor.Y() + monitor.Height() - lWnd.Height() - offset);
         return;
 
-    case Settings::BottomRight:
+    case Settings::OSDPos::BottomRight:
         lWnd.X(monitor.X() + monitor.Width() - lWnd.Width() - offset);
         lWnd.Y(monitor.Y() + monitor.Height() - lWnd.Height() - offset);
         return;
@@ -136,19 +149,19 @@ void OSD::PositionWindow(Monitor monitor, LayeredWnd &lWnd) {
     /* We're centered. Now adjust based on top, bottom, left, or right: */
 
     switch (pos) {
-    case Settings::Top:
+    case Settings::OSDPos::Top:
         lWnd.Y(monitor.Y() + offset);
         return;
 
-    case Settings::Bottom:
+    case Settings::OSDPos::Bottom:
         lWnd.Y(monitor.Y() + monitor.Height() - lWnd.Height() - offset);
         return;
 
-    case Settings::Left:
+    case Settings::OSDPos::Left:
         lWnd.X(monitor.X() + offset);
         return;
 
-    case Settings::Right:
+    case Settings::OSDPos::Right:
         lWnd.X(monitor.X() + monitor.Width() - lWnd.Width() - offset);
         return;
     }
@@ -162,7 +175,7 @@ void OSD::CenterWindowY(Monitor monitor, LayeredWnd &lWnd) {
     lWnd.Y(monitor.Y() + monitor.Height() / 2 - lWnd.Height() / 2);
 }
 
-void OSD::ProcessHotkeys(HotkeyInfo &hki) {
+void OSD::ProcessHotkeys(HotkeyAction &hka) {
 
 }
 
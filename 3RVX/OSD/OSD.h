@@ -15,7 +15,18 @@ public:
     ~OSD();
 
     virtual void Hide() = 0;
-    virtual void ProcessHotkeys(HotkeyInfo &hki);
+    virtual void ProcessHotkeys(HotkeyAction &hka);
+
+    /// <summary>
+    /// Applies the current window behavior settings (topmost, hide animation,
+    /// and hide delay) to the existing OSD windows.
+    /// </summary>
+    virtual void UpdateWindowSettings() = 0;
+
+    /// <summary>
+    /// Repositions the OSD windows based on the current position settings.
+    /// </summary>
+    void Reposition();
 
 protected:
     LPCWSTR _className;
@@ -25,6 +36,7 @@ protected:
     HWND _masterWnd;
 
     void HideOthers(OSDType except);
+    void ApplyWindowSettings(MeterWnd &mWnd);
 
     virtual void UpdateWindowPositions(std::vector<Monitor> &monitors) = 0;
     std::vector<Monitor> ActiveMonitors();
@@ -1,21 +1,28 @@
+#define LOG_SUBSYSTEM OSD
+
 #include "VolumeOSD.h"
 
 #include "..\SoundPlayer.h"
 
 #include <string>
 
-#include "..\HotkeyInfo.h"
+#include "..\3RVX.h"
+#include "..\HotkeyAction.h"
 #include "..\LanguageTranslator.h"
+#include "..\Launcher.h"
+#include "..\Logger.h"
 #include "..\MeterWnd\Meters\CallbackMeter.h"
 #include "..\Monitor.h"
 #include "..\Skin.h"
 #include "..\SkinManager.h"
+#include "..\Trace.h"
 #include "..\Slider\VolumeSlider.h"
 #include "..\MeterWnd\LayeredWnd.h"
 
 #define MENU_SETTINGS 0
 #define MENU_MIXER 1
 #define MENU_EXIT 2
+#define MENU_TRACE 3
 #define MENU_DEVICE 0xF000
 
 VolumeOSD::VolumeOSD() :
@@ -57,6 +64,10 @@ _muteWnd(L"3RVX-MuteOSD", L"3RVX-MuteOSD") {
         InsertMenu(_menu, -1, MF_ENABLED, MENU_SETTINGS, _menuSetStr.c_str());
         InsertMenu(_menu, -1, MF_POPUP, UINT(_deviceMenu), _menuDevStr.c_str());
         InsertMenu(_menu, -1, MF_ENABLED, MENU_MIXER, _menuMixerStr.c_str());
+#if ENABLE_3RVX_LOG != 0
+        /* Debugging aid; not translated */
+        InsertMenu(_menu, -1, MF_ENABLED, MENU_TRACE, L"Record Trace");
+#endif
         InsertMenu(_menu, -1, MF_ENABLED, MENU_EXIT, _menuExitStr.c_str());
 
         _menuFlags = TPM_RIGHTBUTTON;
@@ -69,13 +80,8 @@ _muteWnd(L"3RVX-MuteOSD", L"3RVX-MuteOSD") {
         UpdateDeviceMenu();
     }
 
-    _mWnd.AlwaysOnTop(settings->AlwaysOnTop());
-    _mWnd.HideAnimation(settings->HideAnim(), settings->HideSpeed());
-    _mWnd.VisibleDuration(settings->HideDelay());
-
-    _muteWnd.AlwaysOnTop(settings->AlwaysOnTop());
-    _muteWnd.HideAnimation(settings->HideAnim(), settings->HideSpeed());
-    _muteWnd.VisibleDuration(settings->HideDelay());
+    ApplyWindowSettings(_mWnd);
+    ApplyWindowSettings(_muteWnd);
 
     UpdateIcon();
     float v = _volumeCtrl->Volume();
@@ -247,24 +253,22 @@ void VolumeOSD::UnMute() {
     }
 }
 
-void VolumeOSD::ProcessHotkeys(HotkeyInfo &hki) {
-    switch (hki.action) {
+void VolumeOSD::ProcessHotkeys(HotkeyAction &hka) {
+    switch (hka.action) {
     case HotkeyInfo::IncreaseVolume:
     case HotkeyInfo::DecreaseVolume:
         UnMute();
-        ProcessVolumeHotkeys(hki);
+        ProcessVolumeHotkeys(hka);
         break;
 
     case HotkeyInfo::SetVolume: {
-        HotkeyInfo::VolumeKeyArgTypes type = HotkeyInfo::VolumeArgType(hki);
+        HotkeyInfo::VolumeKeyArgTypes type = hka.volume.type;
         if (type == HotkeyInfo::VolumeKeyArgTypes::NoArgs) {
             return;
         } else if (type == HotkeyInfo::VolumeKeyArgTypes::Units) {
-            int numUnits = hki.ArgToInt(0);
-            _volumeCtrl->Volume(numUnits * _defaultIncrement);
+            _volumeCtrl->Volume(hka.volume.units * _defaultIncrement);
         } else if (type == HotkeyInfo::VolumeKeyArgTypes::Percentage) {
-            double perc = hki.ArgToDouble(0);
-            _volumeCtrl->Volume((float) perc);
+            _volumeCtrl->Volume(hka.volume.amount);
         }
     }
 
@@ -287,41 +291,34 @@ void VolumeOSD::ProcessHotkeys(HotkeyInfo &hki) {
     }
 }
 
-void VolumeOSD::ProcessVolumeHotkeys(HotkeyInfo &hki) {
+void VolumeOSD::ProcessVolumeHotkeys(HotkeyAction &hka) {
+    TRACE_SPAN("VolumeOSD::ProcessVolumeHotkeys");
     float currentVol = _volumeCtrl->Volume();
-    HotkeyInfo::VolumeKeyArgTypes type = HotkeyInfo::VolumeArgType(hki);
 
-    if (type == HotkeyInfo::VolumeKeyArgTypes::Percentage) {
-        /* Deal with percentage-based amounts */
-        float amount = ((float) hki.ArgToDouble(0) / 100.0f);
-        if (hki.action == HotkeyInfo::HotkeyActions::DecreaseVolume) {
-            amount = -amount;
-        }
-        _volumeCtrl->Volume(currentVol + amount);
+    if (hka.volume.type == HotkeyInfo::VolumeKeyArgTypes::Percentage) {
+        /* Deal with percentage-based amounts. The amount is negative for
+         * DecreaseVolume hotkeys. */
+        _volumeCtrl->Volume(currentVol + hka.volume.amount);
     } else {
         /* Unit-based amounts */
-        int unitIncrement = 1;
         int currentUnit = _callbackMeter->CalcUnits();
         if (currentVol <= 0.000001f) {
             currentUnit = 0;
         }
 
-        if (hki.action == HotkeyInfo::DecreaseVolume) {
-            unitIncrement = -1;
-        }
-
-        if (type == HotkeyInfo::VolumeKeyArgTypes::Units) {
-            unitIncrement *= hki.ArgToInt(0);
-        }
-
         _volumeCtrl->Volume(
-            (float) (currentUnit + unitIncrement) * _defaultIncrement);
+            (float) (currentUnit + hka.volume.units) * _defaultIncrement);
     }
 
     /* Tell 3RVX that we changed the volume */
     SendMessage(_hWnd, MSG_VOL_CHNG, NULL, (LPARAM) 1);
 }
 
+void VolumeOSD::UpdateWindowSettings() {
+    ApplyWindowSettings(_mWnd);
+    ApplyWindowSettings(_muteWnd);
+}
+
 void VolumeOSD::UpdateWindowPositions(std::vector<Monitor> &monitors) {
     PositionWindow(monitors[0], _mWnd);
     PositionWindow(monitors[0], _muteWnd);
@@ -344,6 +341,7 @@ void VolumeOSD::UpdateVolumeState() {
 LRESULT
 VolumeOSD::WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
     if (message == MSG_VOL_CHNG) {
+        TRACE_SPAN("VolumeOSD::MSG_VOL_CHNG");
         float v = _volumeCtrl->Volume();
         bool muteState = _volumeCtrl->Muted();
 
@@ -407,6 +405,11 @@ VolumeOSD::WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
             POINT p;
             GetCursorPos(&p);
             SetForegroundWindow(hWnd);
+#if ENABLE_3RVX_LOG != 0
+            /* Tracing can also be toggled with a hotkey */
+            CheckMenuItem(_menu, MENU_TRACE,
+                Trace::Active() ? MF_CHECKED : MF_UNCHECKED);
+#endif
             TrackPopupMenuEx(_menu, _menuFlags, p.x, p.y, _hWnd, NULL);
             PostMessage(hWnd, WM_NULL, 0, 0);
         }
@@ -420,8 +423,7 @@ VolumeOSD::WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
 
         case MENU_MIXER: {
             CLOG(L"Menu: Mixer");
-            HINSTANCE code = ShellExecute(NULL, L"open", L"sndvol",
-                NULL, NULL, SW_SHOWNORMAL);
+            Launcher::Open(L"sndvol");
             break;
         }
 
@@ -429,6 +431,12 @@ VolumeOSD::WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
             CLOG(L"Menu: Exit: %d", (int) _masterWnd);
             SendMessage(_masterWnd, WM_CLOSE, NULL, NULL);
             break;
+
+        case MENU_TRACE:
+            SendMessage(_masterWnd, WM_3RVX_CONTROL, MSG_TRACE, NULL);
+            CheckMenuItem(_menu, MENU_TRACE,
+                Trace::Active() ? MF_CHECKED : MF_UNCHECKED);
+            break;
         }
 
         /* Device menu items */
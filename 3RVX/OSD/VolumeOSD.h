@@ -23,7 +23,8 @@ public:
     void Hide();
     void HideIcon();
 
-    virtual void ProcessHotkeys(HotkeyInfo &hki);
+    virtual void ProcessHotkeys(HotkeyAction &hka);
+    virtual void UpdateWindowSettings();
 
 private:
     CoreAudio *_volumeCtrl;
@@ -53,7 +54,7 @@ private:
     void LoadSkin();
     void MeterLevels(float value);
     virtual void MeterChangeCallback(int units);
-    void ProcessVolumeHotkeys(HotkeyInfo &hki);
+    void ProcessVolumeHotkeys(HotkeyAction &hka);
     void UpdateIcon();
     void UpdateIconImage();
     void UpdateIconTip();
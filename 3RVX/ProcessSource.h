@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// Maps windows to the programs that own them. HotkeyProfiles uses this
+/// rather than the Win32 API so it can be driven by a fake foreground
+/// source; WindowProcessSource is the Win32 implementation.
+/// </summary>
+class ProcessSource {
+public:
+    virtual ~ProcessSource() { }
+
+    /// <summary>
+    /// Retrieves the ID of the process that owns a window, or 0 if the window
+    /// no longer exists. This is called on every foreground change, so it
+    /// should be cheap.
+    /// </summary>
+    virtual unsigned long ProcessId(void *window) = 0;
+
+    /// <summary>
+    /// Retrieves the executable path of a process, or an empty string if it
+    /// can't be determined. Only called for windows that aren't cached.
+    /// </summary>
+    virtual std::wstring ProcessPath(unsigned long pid) = 0;
+};
\ No newline at end of file
@@ -1,33 +1,28 @@
+#define LOG_SUBSYSTEM Settings
+
 #include "Settings.h"
 
 #include <ShlObj.h>
 #include <Shlwapi.h>
 #pragma comment(lib, "Shlwapi.lib")
 #include <algorithm>
+#include <sstream>
 
+#include "AtomicWriter.h"
 #include "Error.h"
 #include "HotkeyInfo.h"
+#include "HotkeyProfiles.h"
 #include "LanguageTranslator.h"
+#include "Launcher.h"
 #include "Logger.h"
 #include "Monitor.h"
+#include "SettingsChanges.h"
 #include "Skin.h"
 #include "StringUtils.h"
+#include "Trace.h"
 
-#define XML_AUDIODEV "audioDeviceID"
-#define XML_HIDE_WHENFULL "hideFullscreen"
-#define XML_HIDEANIM "hideAnimation"
-#define XML_HIDETIME "hideDelay"
-#define XML_HIDESPEED "hideSpeed"
-#define XML_LANGUAGE "language"
-#define XML_MONITOR "monitor"
-#define XML_NOTIFYICON "notifyIcon"
-#define XML_ONTOP "onTop"
-#define XML_OSD_OFFSET "osdEdgeOffset"
-#define XML_OSD_POS "osdPosition"
-#define XML_OSD_X "osdX"
-#define XML_OSD_Y "osdY"
-#define XML_SKIN "skin"
-#define XML_SOUNDS "soundEffects"
+#define XML_LOGGING "logging"
+#define XML_LOGLEVEL "logLevel"
 
 const std::wstring Settings::MAIN_APP = L"3RVX.exe";
 const std::wstring Settings::SETTINGS_APP = L"Settings.exe";
@@ -35,25 +30,9 @@ const std::wstring Settings::SETTINGS_FILE = L"Settings.xml";
 const std::wstring Settings::LANG_DIR = L"Languages";
 const std::wstring Settings::SKIN_DIR = L"Skins";
 
-const std::wstring Settings::DefaultLanguage = L"English";
-const std::wstring Settings::DefaultSkin = L"Classic";
-
 std::wstring Settings::_appDir(L"");
 Settings *Settings::instance;
 
-std::vector<std::wstring> Settings::OSDPosNames = {
-    L"Top",
-    L"Left",
-    L"Right",
-    L"Bottom",
-    L"Center",
-    L"Top-left",
-    L"Top-right",
-    L"Bottom-left",
-    L"Bottom-right",
-    L"Custom"
-};
-
 Settings *Settings::Instance() {
     if (instance == NULL) {
         instance = new Settings();
@@ -62,6 +41,7 @@ Settings *Settings::Instance() {
 }
 
 void Settings::Load() {
+    TRACE_SPAN("Settings::Load");
     /* First, clean up (if needed) */
     delete _translator;
     _translator = NULL;
@@ -82,6 +62,8 @@ void Settings::Load() {
         LoadEmptySettings();
         return;
     }
+
+    Deserialize();
 }
 
 void Settings::LoadEmptySettings() {
@@ -89,19 +71,74 @@ void Settings::LoadEmptySettings() {
     _xml.InsertFirstChild(_xml.NewDeclaration());
     _root = _xml.NewElement("settings");
     _xml.GetDocument()->InsertEndChild(_root);
+    Deserialize();
+}
+
+void Settings::Deserialize() {
+    _values.Deserialize(_root);
+
+    /* Not exposed in the settings application; used to limit logging to the
+     * subsystems being debugged and the entries worth reading. */
+    Logger::EnableSubsystems(GetText(XML_LOGGING));
+    std::wstring logLevel = GetText(XML_LOGLEVEL);
+    if (Logger::Level(logLevel) == false) {
+        WLOG(L"Unknown log level: %s", logLevel.c_str());
+    }
+
+    /* Record which settings changed since the previous load so the running
+     * program can update only the affected subsystems. */
+    SettingsChanges::Snapshot snapshot = TakeSnapshot();
+    _changes = SettingsChanges::Diff(_snapshot, snapshot);
+    _snapshot = snapshot;
+}
+
+std::vector<std::string> Settings::Changes() {
+    return _changes;
+}
+
+SettingsChanges::Snapshot Settings::TakeSnapshot() {
+    SettingsChanges::Snapshot snapshot;
+    tinyxml2::XMLElement *elem = _root->FirstChildElement();
+    for (; elem != NULL; elem = elem->NextSiblingElement()) {
+        tinyxml2::XMLPrinter printer;
+        elem->Accept(&printer);
+        snapshot[elem->Name()] += printer.CStr();
+    }
+    return snapshot;
+}
+
+std::string Settings::Serialize() {
+    _values.Serialize(_root);
+
+    tinyxml2::XMLPrinter printer;
+    _xml.Print(&printer);
+    return std::string(printer.CStr(), printer.CStrSize() - 1);
 }
 
 int Settings::Save() {
+    std::string xml = Serialize();
+    CreateSettingsDir();
+    if (AtomicWriter::Write(_file, xml) == false) {
+        ELOG(L"Could not write settings file!");
+        return tinyxml2::XML_ERROR_FILE_COULD_NOT_BE_OPENED;
+    }
+    return tinyxml2::XML_SUCCESS;
+}
+
+void Settings::SaveAsync(AtomicWriter::Callback saved) {
+    std::string xml = Serialize();
     CreateSettingsDir();
-    FILE *stream;
-    errno_t err = _wfopen_s(&stream, _file.c_str(), L"w");
-    if (err != 0 || stream == NULL) {
-        CLOG(L"Could not open settings file for writing!");
-        return 100 + err;
+
+    if (_writer == NULL) {
+        _writer = new AtomicWriter();
+    }
+    _writer->Schedule(_file, xml, saved);
+}
+
+void Settings::Flush() {
+    if (_writer != NULL) {
+        _writer->Flush();
     }
-    tinyxml2::XMLError result = _xml.SaveFile(stream);
-    fclose(stream);
-    return result;
 }
 
 std::wstring Settings::SettingsDir() {
@@ -181,157 +218,113 @@ void Settings::LaunchSettingsApp() {
     std::wstring app = SettingsApp();
 
     CLOG(L"Opening Settings App: %s", app.c_str());
-    int exec = (int) ShellExecute(
-        NULL, L"open", app.c_str(), NULL, NULL, SW_SHOWNORMAL);
-
-    if (exec <= 32) {
-        Error::ErrorMessage(GENERR_NOTFOUND, app);
-    }
+    Launcher::Open(app);
 }
 
 std::wstring Settings::AudioDeviceID() {
-    return GetText(XML_AUDIODEV);
+    return _values.audioDeviceID;
 }
 
 std::wstring Settings::LanguageName() {
-    std::wstring lang = GetText(XML_LANGUAGE);
-
-    if (lang == L"") {
-        return DefaultLanguage;
-    } else {
-        return lang;
-    }
+    return _values.language;
 }
 
 void Settings::LanguageName(std::wstring name) {
-    std::string nName = StringUtils::Narrow(name);
-    SetText(XML_LANGUAGE, nName);
+    _values.language = name;
 }
 
 bool Settings::AlwaysOnTop() {
-    return GetEnabled(XML_ONTOP, DefaultOnTop);
+    return _values.onTop;
 }
 
 void Settings::AlwaysOnTop(bool enable) {
-    SetEnabled(XML_ONTOP, enable);
+    _values.onTop = enable;
 }
 
 bool Settings::HideFullscreen() {
-    return GetEnabled(XML_HIDE_WHENFULL, DefaultHideFullscreen);
+    return _values.hideFullscreen;
 }
 
 void Settings::HideFullscreen(bool enable) {
-    SetEnabled(XML_HIDE_WHENFULL, enable);
+    _values.hideFullscreen = enable;
 }
 
 std::wstring Settings::Monitor() {
-    return GetText(XML_MONITOR);
+    return _values.monitor;
 }
 
 void Settings::Monitor(std::wstring monitorName) {
-    SetText(XML_MONITOR, StringUtils::Narrow(monitorName));
+    _values.monitor = monitorName;
 }
 
 int Settings::OSDEdgeOffset() {
-    if (HasSetting(XML_OSD_OFFSET)) {
-        return GetInt(XML_OSD_OFFSET);
-    } else {
-        return DefaultOSDOffset;
-    }
+    return _values.osdEdgeOffset;
 }
 
 void Settings::OSDEdgeOffset(int offset) {
-    SetInt(XML_OSD_OFFSET, offset);
+    _values.osdEdgeOffset = offset;
 }
 
 Settings::OSDPos Settings::OSDPosition() {
-    std::wstring pos = GetText(XML_OSD_POS);
-    const wchar_t *posStr = pos.c_str();
-
-    for (unsigned int i = 0; i < OSDPosNames.size(); ++i) {
-        if (_wcsicmp(posStr, OSDPosNames[i].c_str()) == 0) {
-            return (Settings::OSDPos) i;
-        }
-    }
-
-    return DefaultOSDPosition;
+    return _values.osdPosition;
 }
 
 void Settings::OSDPosition(OSDPos pos) {
-    std::wstring posStr = OSDPosNames[(int) pos];
-    SetText(XML_OSD_POS, StringUtils::Narrow(posStr));
+    _values.osdPosition = pos;
 }
 
 int Settings::OSDX() {
-    return GetInt(XML_OSD_X);
+    return _values.osdX;
 }
 
 void Settings::OSDX(int x) {
-    SetInt(XML_OSD_X, x);
+    _values.osdX = x;
 }
 
 int Settings::OSDY() {
-    return GetInt(XML_OSD_Y);
+    return _values.osdY;
 }
 
 void Settings::OSDY(int y) {
-    SetInt(XML_OSD_Y, y);
+    _values.osdY = y;
 }
 
 AnimationTypes::HideAnimation Settings::HideAnim() {
-    std::wstring anim = GetText(XML_HIDEANIM);
-    const wchar_t *animStr = anim.c_str();
-
-    std::vector<std::wstring> *names = &AnimationTypes::HideAnimationNames;
-    for (unsigned int i = 0; i < names->size(); ++i) {
-        if (_wcsicmp(animStr, (*names)[i].c_str()) == 0) {
-            return (AnimationTypes::HideAnimation) i;
-        }
-    }
-
-    return DefaultHideAnim;
+    return _values.hideAnim;
 }
 
 void Settings::HideAnim(AnimationTypes::HideAnimation anim) {
-    std::wstring hideStr = AnimationTypes::HideAnimationNames[(int) anim];
-    SetText(XML_HIDEANIM, StringUtils::Narrow(hideStr));
+    _values.hideAnim = anim;
 }
 
 int Settings::HideDelay() {
-    return GetInt(XML_HIDETIME, DefaultHideTime);
+    return _values.hideDelay;
 }
 
 void Settings::HideDelay(int delay) {
-    SetInt(XML_HIDETIME, delay);
+    _values.hideDelay = delay;
 }
 
 int Settings::HideSpeed() {
-    return GetInt(XML_HIDESPEED, DefaultHideSpeed);
+    return _values.hideSpeed;
 }
 
 void Settings::HideSpeed(int speed) {
-    SetInt(XML_HIDESPEED, speed);
+    _values.hideSpeed = speed;
 }
 
 bool Settings::CurrentSkin(std::wstring skinName) {
-    std::string name = StringUtils::Narrow(skinName);
     std::wstring xml = SkinXML(skinName);
     if (PathFileExists(xml.c_str()) == FALSE) {
         return false;
     }
 
-    SetText(XML_SKIN, name);
+    _values.skin = skinName;
     return true;
 }
 
 std::wstring Settings::CurrentSkin() {
-    std::wstring name = GetText("skin");
-
-    if (name == L"") {
-        return DefaultSkin;
-    } else {
-        return name;
-    }
+    return _values.skin;
 }
 
 std::wstring Settings::SkinXML() {
@@ -344,73 +337,138 @@ std::wstring Settings::SkinXML(std::wstring skinName) {
     return skinXML;
 }
 
-std::unordered_map<int, HotkeyInfo> Settings::Hotkeys() {
-    std::unordered_map<int, HotkeyInfo> keyMappings;
+std::vector<HotkeyInfo> Settings::Hotkeys() {
+    if (_root == NULL) {
+        return std::vector<HotkeyInfo>();
+    }
+
+    return ReadHotkeys(_root->FirstChildElement("hotkeys"));
+}
+
+std::vector<HotkeyProfile> Settings::Profiles() {
+    std::vector<HotkeyProfile> profiles;
 
     if (_root == NULL) {
-        return keyMappings;
+        return profiles;
     }
 
-    tinyxml2::XMLElement *hotkeys = _root->FirstChildElement("hotkeys");
-    if (hotkeys == NULL) {
-        return keyMappings;
+    tinyxml2::XMLElement *profilesElem = _root->FirstChildElement("profiles");
+    if (profilesElem == NULL) {
+        return profiles;
     }
 
-    tinyxml2::XMLElement *hotkey = hotkeys->FirstChildElement("hotkey");
-    for (; hotkey != NULL; hotkey = hotkey->NextSiblingElement()) {
-        const char *actionStr = hotkey->Attribute("action");
-        if (actionStr == NULL) {
-            CLOG(L"No action provided for hotkey; skipping");
+    tinyxml2::XMLElement *profile = profilesElem->FirstChildElement("profile");
+    for (; profile != NULL; profile = profile->NextSiblingElement("profile")) {
+        const char *processStr = profile->Attribute("process");
+        if (processStr == NULL) {
+            CLOG(L"No process provided for hotkey profile; skipping");
             continue;
         }
 
-        int action = -1;
-        std::wstring wActionStr = StringUtils::Widen(actionStr);
-        for (unsigned int i = 0; i < HotkeyInfo::ActionNames.size(); ++i) {
-            const wchar_t *currentAction = HotkeyInfo::ActionNames[i].c_str();
-            if (_wcsicmp(wActionStr.c_str(), currentAction) == 0) {
-                action = i;
-                break;
+        HotkeyProfile hkp;
+        hkp.process = StringUtils::Widen(processStr);
+        CLOG(L"Hotkey profile: %s", hkp.process.c_str());
+        hkp.hotkeys = ReadHotkeys(profile);
+
+        tinyxml2::XMLElement *disable = profile->FirstChildElement("disable");
+        for (; disable != NULL;
+                disable = disable->NextSiblingElement("disable")) {
+            HotkeyInfo hki;
+            if (ReadHotkeyKeys(disable, hki)) {
+                hkp.disabled.push_back(hki);
             }
         }
 
-        if (action == -1) {
-            CLOG(L"Hotkey action '%s' not recognized; skipping",
-                wActionStr.c_str());
-            continue;
-        }
+        profiles.push_back(hkp);
+    }
 
-        int combination = -1;
-        hotkey->QueryIntAttribute("combination", &combination);
-        if (combination == -1) {
-            CLOG(L"No key combination provided for hotkey; skipping");
-            continue;
-        }
+    return profiles;
+}
 
-        HotkeyInfo hki;
-        hki.action = action;
-        hki.keyCombination = combination;
-
-        /* Does this hotkey action have any arguments? */
-        tinyxml2::XMLElement *arg = hotkey->FirstChildElement("arg");
-        for (; arg != NULL; arg = arg->NextSiblingElement()) {
-            const char *argStr = arg->GetText();
-            hki.args.push_back(StringUtils::Widen(argStr));
-        }
+std::vector<HotkeyInfo> Settings::ReadHotkeys(tinyxml2::XMLElement *parent) {
+    std::vector<HotkeyInfo> keyMappings;
+
+    if (parent == NULL) {
+        return keyMappings;
+    }
 
-        /* Do a validity check on the finished HKI object */
-        if (hki.Valid() == false) {
+    tinyxml2::XMLElement *hotkey = parent->FirstChildElement("hotkey");
+    for (; hotkey != NULL; hotkey = hotkey->NextSiblingElement("hotkey")) {
+        HotkeyInfo hki;
+        if (ReadHotkey(hotkey, hki) == false) {
             continue;
         }
 
         /* Whew, we made it! */
         CLOG(L"%s", hki.ToString().c_str());
-        keyMappings[combination] = hki;
+        keyMappings.push_back(hki);
     }
 
     return keyMappings;
 }
 
+bool Settings::ReadHotkey(tinyxml2::XMLElement *hotkey, HotkeyInfo &hki) {
+    const char *actionStr = hotkey->Attribute("action");
+    if (actionStr == NULL) {
+        CLOG(L"No action provided for hotkey; skipping");
+        return false;
+    }
+
+    int action = -1;
+    std::wstring wActionStr = StringUtils::Widen(actionStr);
+    for (unsigned int i = 0; i < HotkeyInfo::ActionNames.size(); ++i) {
+        const wchar_t *currentAction = HotkeyInfo::ActionNames[i].c_str();
+        if (_wcsicmp(wActionStr.c_str(), currentAction) == 0) {
+            action = i;
+            break;
+        }
+    }
+
+    if (action == -1) {
+        CLOG(L"Hotkey action '%s' not recognized; skipping",
+            wActionStr.c_str());
+        return false;
+    }
+
+    if (ReadHotkeyKeys(hotkey, hki) == false) {
+        return false;
+    }
+    hki.action = action;
+
+    /* Does this hotkey action have any arguments? */
+    tinyxml2::XMLElement *arg = hotkey->FirstChildElement("arg");
+    for (; arg != NULL; arg = arg->NextSiblingElement()) {
+        const char *argStr = arg->GetText();
+        hki.args.push_back(StringUtils::Widen(argStr));
+    }
+
+    /* Do a validity check on the finished HKI object */
+    return hki.Valid();
+}
+
+bool Settings::ReadHotkeyKeys(tinyxml2::XMLElement *hotkey, HotkeyInfo &hki) {
+    int combination = -1;
+    hotkey->QueryIntAttribute("combination", &combination);
+    if (combination == -1) {
+        CLOG(L"No key combination provided for hotkey; skipping");
+        return false;
+    }
+    hki.keyCombination = combination;
+
+    /* Multi-key sequences list the combinations after the first one */
+    const char *seqStr = hotkey->Attribute("sequence");
+    if (seqStr != NULL) {
+        std::stringstream ss(seqStr);
+        std::string step;
+        while (std::getline(ss, step, ',')) {
+            hki.sequence.push_back(atoi(step.c_str()));
+        }
+    }
+    hotkey->QueryUnsignedAttribute("hold", &hki.holdTime);
+
+    return true;
+}
+
 void Settings::Hotkeys(std::vector<HotkeyInfo> hotkeys) {
     tinyxml2::XMLElement *hkElem = GetOrCreateElement("hotkeys");
     hkElem->DeleteChildren();
@@ -427,6 +485,21 @@ void Settings::Hotkeys(std::vector<HotkeyInfo> hotkeys) {
             HotkeyInfo::ActionNames[hotkey.action]);
         hk->SetAttribute("action", actionStr.c_str());
 
+        if (hotkey.sequence.size() > 0) {
+            std::string seqStr;
+            for (int step : hotkey.sequence) {
+                if (seqStr.empty() == false) {
+                    seqStr += ",";
+                }
+                seqStr += std::to_string(step);
+            }
+            hk->SetAttribute("sequence", seqStr.c_str());
+        }
+
+        if (hotkey.holdTime > 0) {
+            hk->SetAttribute("hold", hotkey.holdTime);
+        }
+
         if (hotkey.args.size() > 0) {
             for (std::wstring arg : hotkey.args) {
                 tinyxml2::XMLElement *argElem = _xml.NewElement("arg");
@@ -456,50 +529,19 @@ LanguageTranslator *Settings::Translator() {
 }
 
 bool Settings::NotifyIconEnabled() {
-    return GetEnabled(XML_NOTIFYICON, DefaultNotifyIcon);
+    return _values.notifyIcon;
 }
 
 void Settings::NotifyIconEnabled(bool enable) {
-    SetEnabled(XML_NOTIFYICON, enable);
+    _values.notifyIcon = enable;
 }
 
 bool Settings::SoundEffectsEnabled() {
-    return GetEnabled(XML_SOUNDS, DefaultSoundsEnabled);
+    return _values.soundEffects;
 }
 
 void Settings::SoundEffectsEnabled(bool enable) {
-    SetEnabled(XML_SOUNDS, enable);
-}
-
-bool Settings::HasSetting(std::string elementName) {
-    if (_root == NULL) {
-        return false;
-    }
-
-    tinyxml2::XMLElement *el = _root->FirstChildElement(elementName.c_str());
-    return (el != NULL);
-}
-
-bool Settings::GetEnabled(std::string elementName, const bool defaultSetting) {
-    if (_root == NULL) {
-        return defaultSetting;
-    }
-
-    tinyxml2::XMLElement *el = _root->FirstChildElement(elementName.c_str());
-    if (el == NULL) {
-        std::wstring elStr = StringUtils::Widen(elementName);
-        CLOG(L"Warning: XML element '%s' not found", elStr.c_str());
-        return defaultSetting;
-    } else {
-        bool val = false;
-        el->QueryBoolText(&val);
-        return val;
-    }
-}
-
-void Settings::SetEnabled(std::string elementName, bool enabled) {
-    tinyxml2::XMLElement *el = GetOrCreateElement(elementName);
-    el->SetText(enabled ? "true" : "false");
+    _values.soundEffects = enable;
 }
 
 std::wstring Settings::GetText(std::string elementName) {
@@ -509,7 +551,7 @@ std::wstring Settings::GetText(std::string elementName) {
 
     tinyxml2::XMLElement *el = _root->FirstChildElement(elementName.c_str());
     if (el == NULL) {
-        CLOG(L"Warning: XML element %s not found",
+        WLOG(L"XML element %s not found",
             StringUtils::Widen(elementName).c_str());
         return L"";
     }
@@ -522,33 +564,6 @@ std::wstring Settings::GetText(std::string elementName) {
     }
 }
 
-void Settings::SetText(std::string elementName, std::string text) {
-    tinyxml2::XMLElement *el = GetOrCreateElement(elementName);
-    el->SetText(text.c_str());
-}
-
-int Settings::GetInt(std::string elementName, const int defaultValue) {
-    if (_root == NULL) {
-        return defaultValue;
-    }
-
-    tinyxml2::XMLElement *el = _root->FirstChildElement(elementName.c_str());
-    if (el == NULL) {
-        std::wstring elStr = StringUtils::Widen(elementName);
-        CLOG(L"Warning: XML element '%s' not found", elStr.c_str());
-        return defaultValue;
-    }
-
-    int val = defaultValue;
-    el->QueryIntText(&val);
-    return val;
-}
-
-void Settings::SetInt(std::string elementName, int value) {
-    tinyxml2::XMLElement *el = GetOrCreateElement(elementName);
-    el->SetText(value);
-}
-
 tinyxml2::XMLElement *Settings::GetOrCreateElement(std::string elementName) {
     tinyxml2::XMLElement *el = _root->FirstChildElement(elementName.c_str());
     if (el == NULL) {
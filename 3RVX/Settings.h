@@ -1,38 +1,51 @@
 #pragma once
 
-#include <unordered_map>
 #include <string>
+#include <vector>
 
+#include "AtomicWriter.h"
+#include "SettingsChanges.h"
+#include "SettingsValues.h"
 #include "TinyXml2\tinyxml2.h"
 #include "MeterWnd\Animations\AnimationTypes.h"
 
 class HotkeyInfo;
+struct HotkeyProfile;
 class LanguageTranslator;
 class Skin;
 
 class Settings {
 public:
-    enum OSDPos {
-        Top,
-        Left,
-        Right,
-        Bottom,
-        Center,
-        TopLeft,
-        TopRight,
-        BottomLeft,
-        BottomRight,
-        Custom
-    };
-    static std::vector<std::wstring> OSDPosNames;
+    typedef SettingsValues::OSDPos OSDPos;
 
 public:
     static Settings *Instance();
 
     void Load();
     void LoadEmptySettings();
+    /// <summary>
+    /// Writes the settings file immediately. The file is replaced atomically,
+    /// so a failed write leaves the previous settings intact.
+    /// </summary>
     int Save();
 
+    /// <summary>
+    /// Writes the settings file on a background thread. Saves made in quick
+    /// succession are combined into a single write; the callback is invoked
+    /// (on the writer thread) once the file has been written.
+    /// </summary>
+    void SaveAsync(AtomicWriter::Callback saved = nullptr);
+
+    /// <summary>Completes any pending background save.</summary>
+    void Flush();
+
+    /// <summary>
+    /// Retrieves the names of the settings that were added, removed, or
+    /// modified by the most recent Load(). The first load reports every
+    /// setting in the file.
+    /// </summary>
+    std::vector<std::string> Changes();
+
     std::wstring AudioDeviceID();
 
     AnimationTypes::HideAnimation HideAnim();
@@ -73,9 +86,16 @@ public:
 
     LanguageTranslator *Translator();
 
-    std::unordered_map<int, HotkeyInfo> Hotkeys();
+    std::vector<HotkeyInfo> Hotkeys();
     void Hotkeys(std::vector<HotkeyInfo> hotkeys);
 
+    /// <summary>
+    /// Retrieves the per-program hotkey profiles. Profiles aren't modified by
+    /// the settings application, so they are preserved when the hotkeys are
+    /// saved.
+    /// </summary>
+    std::vector<HotkeyProfile> Profiles();
+
 public:
     /* Static settings methods */
 
@@ -111,30 +131,49 @@ public:
 
 
 private:
-    Settings() {
+    Settings() :
+    _root(NULL),
+    _translator(NULL),
+    _writer(NULL) {
 
     }
 
     static Settings *instance;
     static std::wstring _appDir;
 
+    /// <summary>
+    /// Typed copy of the settings. Load() deserializes the XML document into
+    /// it once so the getters don't need to search the DOM or convert
+    /// strings, and Save() serializes it back.
+    /// </summary>
+    SettingsValues _values;
+
     std::wstring _file;
     tinyxml2::XMLDocument _xml;
     tinyxml2::XMLElement *_root;
 
     LanguageTranslator *_translator;
+    AtomicWriter *_writer;
 
-    bool HasSetting(std::string elementName);
-    bool GetEnabled(std::string elementName, const bool defaultSetting);
-    void SetEnabled(std::string elementName, bool enabled);
+    SettingsChanges::Snapshot _snapshot;
+    std::vector<std::string> _changes;
 
     std::wstring GetText(std::string elementName);
-    void SetText(std::string elementName, std::string text);
-    int GetInt(std::string elementName, const int defaultValue = 0);
-    void SetInt(std::string elementName, int value);
 
     tinyxml2::XMLElement *GetOrCreateElement(std::string elementName);
 
+    void Deserialize();
+    SettingsChanges::Snapshot TakeSnapshot();
+    /// <summary>
+    /// Updates the XML document from the typed settings and returns the
+    /// serialized document.
+    /// </summary>
+    std::string Serialize();
+
+    std::vector<HotkeyInfo> ReadHotkeys(tinyxml2::XMLElement *parent);
+    bool ReadHotkey(tinyxml2::XMLElement *hotkey, HotkeyInfo &hki);
+    bool ReadHotkeyKeys(tinyxml2::XMLElement *hotkey, HotkeyInfo &hki);
+
 public:
     static const std::wstring MAIN_APP;
     static const std::wstring SETTINGS_APP;
@@ -142,18 +181,4 @@ public:
     static const std::wstring LANG_DIR;
     static const std::wstring SKIN_DIR;
 
-    /* Default settings */
-    static const bool DefaultOnTop = true;
-    static const AnimationTypes::HideAnimation DefaultHideAnim
-        = AnimationTypes::Fade;
-    static const bool DefaultHideFullscreen = false;
-    static const int DefaultHideSpeed = 765;
-    static const int DefaultHideTime = 800;
-    static const std::wstring DefaultLanguage;
-    static const bool DefaultNotifyIcon = true;
-    static const bool DefaultSoundsEnabled = true;
-    static const int DefaultOSDOffset = 140;
-    static const Settings::OSDPos DefaultOSDPosition = OSDPos::Bottom;
-    static const std::wstring DefaultSkin;
-
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "SettingsChanges.h"
+
+const std::map<std::string, int> SettingsChanges::_subsystems = {
+    { "audioDeviceID", OSDs },
+    { "hideAnimation", WindowBehavior },
+    { "hideDelay", WindowBehavior },
+    { "hideFullscreen", None },
+    { "hideSpeed", WindowBehavior },
+    { "hotkeys", Hotkeys },
+    { "language", OSDs },
+    { "logLevel", None },
+    { "logging", None },
+    { "monitor", OSDs },
+    { "notifyIcon", OSDs },
+    { "onTop", WindowBehavior },
+    { "osdEdgeOffset", WindowPosition },
+    { "osdPosition", WindowPosition },
+    { "osdX", WindowPosition },
+    { "osdY", WindowPosition },
+    { "profiles", Hotkeys },
+    { "skin", OSDs },
+    { "soundEffects", OSDs },
+};
+
+std::vector<std::string> SettingsChanges::Diff(
+        const Snapshot &before, const Snapshot &after) {
+
+    std::vector<std::string> changes;
+    auto b = before.begin();
+    auto a = after.begin();
+
+    /* Both snapshots are sorted by name, so they can be merged in a single
+     * pass. */
+    while (b != before.end() || a != after.end()) {
+        if (a == after.end() || (b != before.end() && b->first < a->first)) {
+            changes.push_back(b->first);
+            ++b;
+        } else if (b == before.end() || a->first < b->first) {
+            changes.push_back(a->first);
+            ++a;
+        } else {
+            if (a->second != b->second) {
+                changes.push_back(a->first);
+            }
+            ++a;
+            ++b;
+        }
+    }
+
+    return changes;
+}
+
+int SettingsChanges::Affected(const std::string &setting) {
+    auto it = _subsystems.find(setting);
+    if (it == _subsystems.end()) {
+        return All;
+    }
+    return it->second;
+}
+
+int SettingsChanges::Affected(const std::vector<std::string> &settings) {
+    int affected = None;
+    for (const std::string &setting : settings) {
+        affected |= Affected(setting);
+    }
+    return affected;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Determines which parts of the running program are affected when the
+/// settings file changes.
+/// <p>
+/// Each load of the settings file is reduced to a snapshot that maps the
+/// top-level setting elements to their serialized contents. Comparing two
+/// snapshots yields the names of the settings that were added, removed, or
+/// modified, and those names are mapped to the subsystems that must be
+/// updated. This allows a change such as the hide delay to be applied to the
+/// existing OSD windows instead of reloading the skin and recreating every
+/// window. Settings that aren't recognized affect everything.
+/// </summary>
+class SettingsChanges {
+public:
+    typedef std::map<std::string, std::string> Snapshot;
+
+    enum Subsystems {
+        None = 0x0,
+
+        /// <summary>Topmost flag, hide animation, and hide delay.</summary>
+        WindowBehavior = 0x1,
+
+        /// <summary>OSD position and edge offset.</summary>
+        WindowPosition = 0x2,
+
+        /// <summary>Global hotkeys and per-program profiles.</summary>
+        Hotkeys = 0x4,
+
+        /// <summary>
+        /// Changes that require the OSDs to be recreated: the skin, language,
+        /// monitor, audio device, notification icon, and sound effects.
+        /// </summary>
+        OSDs = 0x8,
+
+        All = WindowBehavior | WindowPosition | Hotkeys | OSDs
+    };
+
+    /// <summary>
+    /// Retrieves the names of the settings that differ between two snapshots.
+    /// The names are returned in sorted order.
+    /// </summary>
+    static std::vector<std::string> Diff(
+        const Snapshot &before, const Snapshot &after);
+
+    /// <summary>Retrieves the subsystems affected by a setting.</summary>
+    static int Affected(const std::string &setting);
+
+    /// <summary>
+    /// Retrieves the subsystems affected by a list of changed settings.
+    /// </summary>
+    static int Affected(const std::vector<std::string> &settings);
+
+private:
+    static const std::map<std::string, int> _subsystems;
+};
\ No newline at end of file
@@ -0,0 +1,243 @@
+#define LOG_SUBSYSTEM Settings
+
+#include "SettingsValues.h"
+
+#include <cwctype>
+
+#include "Logger.h"
+#include "StringUtils.h"
+
+#define XML_AUDIODEV "audioDeviceID"
+#define XML_HIDE_WHENFULL "hideFullscreen"
+#define XML_HIDEANIM "hideAnimation"
+#define XML_HIDETIME "hideDelay"
+#define XML_HIDESPEED "hideSpeed"
+#define XML_LANGUAGE "language"
+#define XML_MONITOR "monitor"
+#define XML_NOTIFYICON "notifyIcon"
+#define XML_ONTOP "onTop"
+#define XML_OSD_OFFSET "osdEdgeOffset"
+#define XML_OSD_POS "osdPosition"
+#define XML_OSD_X "osdX"
+#define XML_OSD_Y "osdY"
+#define XML_SKIN "skin"
+#define XML_SOUNDS "soundEffects"
+
+const std::wstring SettingsValues::DefaultLanguage = L"English";
+const std::wstring SettingsValues::DefaultSkin = L"Classic";
+
+std::vector<std::wstring> SettingsValues::OSDPosNames = {
+    L"Top",
+    L"Left",
+    L"Right",
+    L"Bottom",
+    L"Center",
+    L"Top-left",
+    L"Top-right",
+    L"Bottom-left",
+    L"Bottom-right",
+    L"Custom"
+};
+
+SettingsValues::SettingsValues() :
+language(DefaultLanguage),
+skin(DefaultSkin),
+hideFullscreen(DefaultHideFullscreen),
+notifyIcon(DefaultNotifyIcon),
+onTop(DefaultOnTop),
+soundEffects(DefaultSoundsEnabled),
+hideAnim(DefaultHideAnim),
+hideDelay(DefaultHideTime),
+hideSpeed(DefaultHideSpeed),
+osdEdgeOffset(DefaultOSDOffset),
+osdPosition(DefaultOSDPosition),
+osdX(0),
+osdY(0) {
+
+}
+
+void SettingsValues::Deserialize(const tinyxml2::XMLElement *root) {
+    SettingsValues v;
+
+    v.audioDeviceID = Text(root, XML_AUDIODEV);
+    v.monitor = Text(root, XML_MONITOR);
+
+    std::wstring lang = Text(root, XML_LANGUAGE);
+    if (lang != L"") {
+        v.language = lang;
+    }
+
+    std::wstring skin = Text(root, XML_SKIN);
+    if (skin != L"") {
+        v.skin = skin;
+    }
+
+    v.onTop = Enabled(root, XML_ONTOP, DefaultOnTop);
+    v.hideFullscreen = Enabled(root, XML_HIDE_WHENFULL, DefaultHideFullscreen);
+    v.notifyIcon = Enabled(root, XML_NOTIFYICON, DefaultNotifyIcon);
+    v.soundEffects = Enabled(root, XML_SOUNDS, DefaultSoundsEnabled);
+
+    v.osdEdgeOffset = Int(root, XML_OSD_OFFSET, DefaultOSDOffset);
+    v.osdX = Int(root, XML_OSD_X, 0);
+    v.osdY = Int(root, XML_OSD_Y, 0);
+    v.hideDelay = Int(root, XML_HIDETIME, DefaultHideTime);
+    v.hideSpeed = Int(root, XML_HIDESPEED, DefaultHideSpeed);
+
+    v.osdPosition = (OSDPos) Index(
+        OSDPosNames, Text(root, XML_OSD_POS), DefaultOSDPosition);
+    v.hideAnim = (AnimationTypes::HideAnimation) Index(
+        AnimationTypes::HideAnimationNames, Text(root, XML_HIDEANIM),
+        DefaultHideAnim);
+
+    *this = v;
+}
+
+void SettingsValues::Serialize(tinyxml2::XMLElement *root) const {
+    const SettingsValues d;
+    const SettingsValues &v = *this;
+
+    SerializeText(root, XML_AUDIODEV, v.audioDeviceID, d.audioDeviceID);
+    SerializeText(root, XML_MONITOR, v.monitor, d.monitor);
+    SerializeText(root, XML_LANGUAGE, v.language, d.language);
+    SerializeText(root, XML_SKIN, v.skin, d.skin);
+
+    SerializeEnabled(root, XML_ONTOP, v.onTop, d.onTop);
+    SerializeEnabled(root, XML_HIDE_WHENFULL,
+        v.hideFullscreen, d.hideFullscreen);
+    SerializeEnabled(root, XML_NOTIFYICON, v.notifyIcon, d.notifyIcon);
+    SerializeEnabled(root, XML_SOUNDS, v.soundEffects, d.soundEffects);
+
+    SerializeInt(root, XML_OSD_OFFSET, v.osdEdgeOffset, d.osdEdgeOffset);
+    SerializeInt(root, XML_OSD_X, v.osdX, d.osdX);
+    SerializeInt(root, XML_OSD_Y, v.osdY, d.osdY);
+    SerializeInt(root, XML_HIDETIME, v.hideDelay, d.hideDelay);
+    SerializeInt(root, XML_HIDESPEED, v.hideSpeed, d.hideSpeed);
+
+    SerializeText(root, XML_OSD_POS,
+        OSDPosNames[v.osdPosition], OSDPosNames[d.osdPosition]);
+    SerializeText(root, XML_HIDEANIM,
+        AnimationTypes::HideAnimationNames[v.hideAnim],
+        AnimationTypes::HideAnimationNames[d.hideAnim]);
+}
+
+std::wstring SettingsValues::Text(const tinyxml2::XMLElement *root,
+        const char *elementName) {
+
+    if (root == NULL) {
+        return L"";
+    }
+
+    const tinyxml2::XMLElement *el = root->FirstChildElement(elementName);
+    if (el == NULL) {
+        WLOG(L"XML element %s not found",
+            StringUtils::Widen(elementName).c_str());
+        return L"";
+    }
+
+    const char* str = el->GetText();
+    if (str == NULL) {
+        return L"";
+    } else {
+        return StringUtils::Widen(str);
+    }
+}
+
+bool SettingsValues::Enabled(const tinyxml2::XMLElement *root,
+        const char *elementName, bool defaultValue) {
+
+    if (root == NULL) {
+        return defaultValue;
+    }
+
+    const tinyxml2::XMLElement *el = root->FirstChildElement(elementName);
+    if (el == NULL) {
+        std::wstring elStr = StringUtils::Widen(elementName);
+        WLOG(L"XML element '%s' not found", elStr.c_str());
+        return defaultValue;
+    }
+
+    bool val = false;
+    el->QueryBoolText(&val);
+    return val;
+}
+
+int SettingsValues::Int(const tinyxml2::XMLElement *root,
+        const char *elementName, int defaultValue) {
+
+    if (root == NULL) {
+        return defaultValue;
+    }
+
+    const tinyxml2::XMLElement *el = root->FirstChildElement(elementName);
+    if (el == NULL) {
+        std::wstring elStr = StringUtils::Widen(elementName);
+        WLOG(L"XML element '%s' not found", elStr.c_str());
+        return defaultValue;
+    }
+
+    int val = defaultValue;
+    el->QueryIntText(&val);
+    return val;
+}
+
+int SettingsValues::Index(const std::vector<std::wstring> &names,
+        const std::wstring &name, int defaultIndex) {
+
+    for (unsigned int i = 0; i < names.size(); ++i) {
+        const std::wstring &candidate = names[i];
+        if (candidate.size() != name.size()) {
+            continue;
+        }
+
+        size_t c = 0;
+        while (c < name.size()
+                && towlower(name[c]) == towlower(candidate[c])) {
+            ++c;
+        }
+        if (c == name.size()) {
+            return (int) i;
+        }
+    }
+    return defaultIndex;
+}
+
+void SettingsValues::SerializeText(tinyxml2::XMLElement *root,
+        const char *elementName,
+        const std::wstring &value, const std::wstring &defaultValue) {
+
+    if (value != defaultValue
+            || root->FirstChildElement(elementName) != NULL) {
+        GetOrCreateElement(root, elementName)->SetText(
+            StringUtils::Narrow(value).c_str());
+    }
+}
+
+void SettingsValues::SerializeEnabled(tinyxml2::XMLElement *root,
+        const char *elementName, bool value, bool defaultValue) {
+
+    if (value != defaultValue
+            || root->FirstChildElement(elementName) != NULL) {
+        GetOrCreateElement(root, elementName)->SetText(
+            value ? "true" : "false");
+    }
+}
+
+void SettingsValues::SerializeInt(tinyxml2::XMLElement *root,
+        const char *elementName, int value, int defaultValue) {
+
+    if (value != defaultValue
+            || root->FirstChildElement(elementName) != NULL) {
+        GetOrCreateElement(root, elementName)->SetText(value);
+    }
+}
+
+tinyxml2::XMLElement *SettingsValues::GetOrCreateElement(
+        tinyxml2::XMLElement *root, const char *elementName) {
+
+    tinyxml2::XMLElement *el = root->FirstChildElement(elementName);
+    if (el == NULL) {
+        el = root->GetDocument()->NewElement(elementName);
+        root->InsertEndChild(el);
+    }
+    return el;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MeterWnd/Animations/AnimationTypes.h"
+#include "TinyXml2/tinyxml2.h"
+
+/// <summary>
+/// Typed copy of the settings file. The &lt;settings&gt; element is
+/// deserialized into this struct once (applying defaults for missing or
+/// invalid values) so reading a setting doesn't need to search the DOM or
+/// convert strings, and the struct is serialized back into the same element
+/// when the settings are saved. Elements that aren't represented here, such
+/// as the hotkeys or settings written by a newer version, are left untouched.
+/// </summary>
+struct SettingsValues {
+    enum OSDPos {
+        Top,
+        Left,
+        Right,
+        Bottom,
+        Center,
+        TopLeft,
+        TopRight,
+        BottomLeft,
+        BottomRight,
+        Custom
+    };
+    static std::vector<std::wstring> OSDPosNames;
+
+    /// <summary>Creates a copy of the default settings.</summary>
+    SettingsValues();
+
+    std::wstring audioDeviceID;
+    std::wstring language;
+    std::wstring monitor;
+    std::wstring skin;
+
+    bool hideFullscreen;
+    bool notifyIcon;
+    bool onTop;
+    bool soundEffects;
+
+    AnimationTypes::HideAnimation hideAnim;
+    int hideDelay;
+    int hideSpeed;
+
+    int osdEdgeOffset;
+    OSDPos osdPosition;
+    int osdX;
+    int osdY;
+
+    /// <summary>
+    /// Reads the settings from the children of the given &lt;settings&gt;
+    /// element, which may be NULL. Settings that are missing are reset to
+    /// their defaults.
+    /// </summary>
+    void Deserialize(const tinyxml2::XMLElement *root);
+
+    /// <summary>
+    /// Writes the settings to the children of the given &lt;settings&gt;
+    /// element. Defaults are only written if the element was already present,
+    /// so the file doesn't pin settings the user never changed.
+    /// </summary>
+    void Serialize(tinyxml2::XMLElement *root) const;
+
+    /* Default settings */
+    static const bool DefaultOnTop = true;
+    static const AnimationTypes::HideAnimation DefaultHideAnim
+        = AnimationTypes::Fade;
+    static const bool DefaultHideFullscreen = false;
+    static const int DefaultHideSpeed = 765;
+    static const int DefaultHideTime = 800;
+    static const std::wstring DefaultLanguage;
+    static const bool DefaultNotifyIcon = true;
+    static const bool DefaultSoundsEnabled = true;
+    static const int DefaultOSDOffset = 140;
+    static const OSDPos DefaultOSDPosition = Bottom;
+    static const std::wstring DefaultSkin;
+
+private:
+    static std::wstring Text(const tinyxml2::XMLElement *root,
+        const char *elementName);
+    static bool Enabled(const tinyxml2::XMLElement *root,
+        const char *elementName, bool defaultValue);
+    static int Int(const tinyxml2::XMLElement *root,
+        const char *elementName, int defaultValue);
+
+    /// <summary>
+    /// Retrieves the index of a name in the given list, ignoring case, or
+    /// defaultIndex if the name isn't in the list.
+    /// </summary>
+    static int Index(const std::vector<std::wstring> &names,
+        const std::wstring &name, int defaultIndex);
+
+    static void SerializeText(tinyxml2::XMLElement *root,
+        const char *elementName,
+        const std::wstring &value, const std::wstring &defaultValue);
+    static void SerializeEnabled(tinyxml2::XMLElement *root,
+        const char *elementName, bool value, bool defaultValue);
+    static void SerializeInt(tinyxml2::XMLElement *root,
+        const char *elementName, int value, int defaultValue);
+    static tinyxml2::XMLElement *GetOrCreateElement(
+        tinyxml2::XMLElement *root, const char *elementName);
+};
\ No newline at end of file
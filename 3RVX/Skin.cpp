@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Skin
+
 #include "Skin.h"
 
 #include <algorithm>
@@ -15,6 +17,9 @@
 
 Skin::Skin(std::wstring skinXML) :
 SkinInfo(skinXML) {
+    _osds.Build(_root->FirstChildElement("osds"));
+    _sliders.Build(_root->FirstChildElement("sliders"));
+
     volumeBackground = OSDBgImg("volume");
     volumeMask = OSDMask("volume");
     volumeMeters = OSDMeters("volume");
@@ -123,7 +128,7 @@ Gdiplus::Bitmap *Skin::Image(tinyxml2::XMLElement *element, char *attName) {
     const char *imgFile = element->Attribute(attName);
     if (imgFile == NULL) {
         std::wstring aName = StringUtils::Widen(attName);
-        CLOG(L"Could not find XML attribute: %s", aName.c_str());
+        WLOG(L"Could not find XML attribute: %s", aName.c_str());
         return NULL;
     }
 
@@ -151,7 +156,7 @@ std::vector<HICON> Skin::Iconset(char *osdName) {
 
     const char *loc = set->Attribute("location");
     if (loc == NULL) {
-        CLOG(L"Unknown iconset location");
+        ELOG(L"Unknown iconset location");
         return iconset;
     }
 
@@ -162,7 +167,7 @@ std::vector<HICON> Skin::Iconset(char *osdName) {
     WIN32_FIND_DATA fd = {};
     hFind = FindFirstFile((iconDir + L"*").c_str(), &fd);
     if (hFind == INVALID_HANDLE_VALUE) {
-        CLOG(L"Could not read icon directory");
+        ELOG(L"Could not read icon directory");
         return iconset;
     }
 
@@ -264,7 +269,7 @@ Meter *Skin::LoadMeter(tinyxml2::XMLElement *meterXMLElement) {
     const char *meterType = meterXMLElement->Attribute("type");
     if (meterType == NULL) {
         /* If we dont' know the meter type, we can't proceed. */
-        CLOG(L"Unknown meter type!");
+        ELOG(L"Unknown meter type!");
         return NULL;
     }
 
@@ -290,10 +295,15 @@ Meter *Skin::LoadMeter(tinyxml2::XMLElement *meterXMLElement) {
     bool inverted = false;
     meterXMLElement->QueryBoolAttribute("inverted", &inverted);
 
-    /* Check for meter background image. 'text' is the only meter
-     * that does not require an image. */
+    /* Bars can be drawn in proportion to the value instead of in units */
+    bool smooth = false;
+    meterXMLElement->QueryBoolAttribute("smooth", &smooth);
+
+    /* Check for meter background image. Text and arcs are drawn without
+     * one. */
+    bool drawn = (type == "text" || type == "arc" || type == "ring");
     std::wstring img;
-    if (type != "text") {
+    if (drawn == false) {
         img = ImageName(meterXMLElement);
         if (PathFileExists(img.c_str()) == FALSE) {
             Error::ErrorMessageDie(SKINERR_NOTFOUND, img);
@@ -301,10 +311,40 @@ Meter *Skin::LoadMeter(tinyxml2::XMLElement *meterXMLElement) {
     }
 
     Meter *m = NULL;
-    if (type == "bitstrip") {
+    if (type == "arc" || type == "ring") {
+        /* IntAttribute() returns 0 if the size is missing, which would
+         * draw nothing. */
+        int size = meterXMLElement->IntAttribute("size");
+        if (size <= 0) {
+            Error::ErrorMessage(SKINERR_INVALID_METER,
+                L"Arc size must be positive");
+            return NULL;
+        }
+
+        float thickness = size / 8.0f;
+        meterXMLElement->QueryFloatAttribute("thickness", &thickness);
+
+        /* Rings start at the top and go all the way around; arcs default to
+         * a gauge with a gap at the bottom. */
+        float start = (type == "ring") ? 0.0f : 225.0f;
+        float sweep = (type == "ring") ? 360.0f : 270.0f;
+        meterXMLElement->QueryFloatAttribute("start", &start);
+        meterXMLElement->QueryFloatAttribute("sweep", &sweep);
+
+        const char *arcColor = meterXMLElement->Attribute("color");
+        std::wstring color(L"FFFFFF");
+        if (arcColor != NULL) {
+            color = std::wstring(StringUtils::Widen(arcColor));
+        }
+        int itrans = 255;
+        meterXMLElement->QueryIntAttribute("transparency", &itrans);
+
+        m = new ArcGauge(x, y, size, thickness, start, sweep, units,
+            color, (byte) itrans);
+    } else if (type == "bitstrip") {
         m = new Bitstrip(img, x, y, units);
     } else if (type == "horizontalbar") {
-        m = new HorizontalBar(img, x, y, units);
+        m = new HorizontalBar(img, x, y, units, false, smooth);
     } else if (type == "horizontalendcap") {
         m = new HorizontalEndcap(img, x, y, units);
     } else if (type == "horizontaltile") {
@@ -342,9 +382,9 @@ Meter *Skin::LoadMeter(tinyxml2::XMLElement *meterXMLElement) {
         delete font;
 
     } else if (type == "verticalbar") {
-        m = new VerticalBar(img, x, y, units, inverted);
+        m = new VerticalBar(img, x, y, units, inverted, smooth);
     } else {
-        CLOG(L"Unknown meter type: %s", StringUtils::Widen(type).c_str());
+        ELOG(L"Unknown meter type: %s", StringUtils::Widen(type).c_str());
         return NULL;
     }
 
@@ -466,25 +506,19 @@ SliderKnob *Skin::Knob(char *sliderName) {
 std::wstring Skin::ImageName(tinyxml2::XMLElement *meterXMLElement) {
     const char *imgName = meterXMLElement->Attribute("image");
     if (imgName == NULL) {
-        return NULL;
+        /* Constructing the result from NULL would be undefined, so the
+         * missing attribute is reported here instead. */
+        std::wstring element = StringUtils::Widen(meterXMLElement->Name());
+        Error::ErrorMessageDie(SKINERR_MISSING_XML,
+            L"<" + element + L" image=\"...\">");
     }
     return _skinDir + L"\\" + StringUtils::Widen(imgName);
 }
 
 tinyxml2::XMLElement *Skin::OSDXMLElement(char *osdName) {
-    tinyxml2::XMLHandle xmlHandle(_root);
-    tinyxml2::XMLElement *osd = xmlHandle
-        .FirstChildElement("osds")
-        .FirstChildElement(osdName)
-        .ToElement();
-    return osd;
+    return _osds.Find(osdName);
 }
 
 tinyxml2::XMLElement *Skin::SliderXMLElement(char *sliderName) {
-    tinyxml2::XMLHandle xmlHandle(_root);
-    tinyxml2::XMLElement *controller = xmlHandle
-        .FirstChildElement("sliders")
-        .FirstChildElement(sliderName)
-        .ToElement();
-    return controller;
+    return _sliders.Find(sliderName);
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 #pragma comment(lib, "gdiplus.lib")
 
 #include <list>
+#include <string>
 #include <vector>
 
+#include "ElementIndex.h"
 #include "SkinInfo.h"
 #include "TinyXml2/tinyxml2.h"
 
@@ -43,6 +45,13 @@ public:
     SliderKnob *volumeSliderKnob;
 
 private:
+    /// <summary>
+    /// OSD and slider elements, indexed by name when the skin is loaded so
+    /// each lookup doesn't have to walk the document from the root.
+    /// </summary>
+    ElementIndex _osds;
+    ElementIndex _sliders;
+
     Gdiplus::Bitmap *OSDBgImg(char *osdName);
     Gdiplus::Bitmap *OSDMask(char *osdName);
     std::list<Meter *> OSDMeters(char *osdName);
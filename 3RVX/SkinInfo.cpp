@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Skin
+
 #include "SkinInfo.h"
 
 #include "Error.h"
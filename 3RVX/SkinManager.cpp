@@ -1,6 +1,7 @@
 #include "SkinManager.h"
 
 #include "Skin.h"
+#include "Trace.h"
 
 SkinManager *SkinManager::instance;
 
@@ -16,6 +17,7 @@ SkinManager::~SkinManager() {
 }
 
 void SkinManager::LoadSkin(std::wstring skinXML) {
+    TRACE_SPAN("SkinManager::LoadSkin");
     delete _skin;
     _skin = new Skin(skinXML);
 }
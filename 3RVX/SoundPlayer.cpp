@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Audio
+
 #include "SoundPlayer.h"
 
 #include "Logger.h" // <-- Has to be included here because DirectShow says so...
@@ -18,7 +20,7 @@ SoundPlayer::SoundPlayer(std::wstring filePath) {
         (void **) &_graphBuilder);
 
     if (FAILED(hr)) {
-        CLOG(L"Failed to create GraphBuilder");
+        ELOG(L"Failed to create GraphBuilder");
     }
     
     hr = _graphBuilder->QueryInterface(
@@ -57,7 +59,7 @@ SoundPlayer::~SoundPlayer() {
 
 void SoundPlayer::Play() {
     if (!_ready) {
-        CLOG(L"Error: sound player not ready");
+        ELOG(L"Sound player not ready");
         return;
     }
 
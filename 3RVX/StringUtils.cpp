@@ -1,27 +1,31 @@
 #include "StringUtils.h"
 
+#include <cstring>
+
+#include "UTF8.h"
+
 std::wstring StringUtils::Widen(const char *str) {
     if (str == NULL) {
         return L"";
     }
-    std::string sstr(str);
-    return Widen(sstr);
+    return Widen(str, strlen(str));
 }
 
-std::wstring StringUtils::Widen(const std::string &str) {
-    int size = MultiByteToWideChar(CP_UTF8, 0, &str[0], (int) str.size(),
-        NULL, 0);
-    std::wstring buf(size, 0);
-    MultiByteToWideChar(CP_UTF8, 0, &str[0], (int) str.size(), &buf[0], size);
+std::wstring StringUtils::Widen(const char *str, size_t length) {
+    /* Convert directly into a worst-case sized string and trim it, rather
+     * than measuring the output in a separate pass. */
+    std::wstring buf(UTF8::MaxWideLength(length), L'\0');
+    buf.resize(UTF8::Decode(str, length, &buf[0]));
     return buf;
 }
 
+std::wstring StringUtils::Widen(const std::string &str) {
+    return Widen(str.c_str(), str.size());
+}
+
 std::string StringUtils::Narrow(const std::wstring &str) {
-    int size = WideCharToMultiByte(CP_UTF8, 0, &str[0], (int) str.size(),
-        NULL, 0, NULL, NULL);
-    std::string buf(size, 0);
-    WideCharToMultiByte(CP_UTF8, 0, &str[0], (int) str.size(),
-        &buf[0], size, NULL, NULL);
+    std::string buf(UTF8::MaxNarrowLength(str.size()), '\0');
+    buf.resize(UTF8::Encode(str.c_str(), str.size(), &buf[0]));
     return buf;
 }
 
@@ -1,11 +1,12 @@
 #pragma once
 
-#include <Windows.h>
+#include <cstddef>
 #include <string>
 
 class StringUtils {
 public:
     static std::wstring Widen(const char *str);
+    static std::wstring Widen(const char *str, size_t length);
     static std::wstring Widen(const std::string &str);
     static std::string Narrow(const std::wstring &str);
 
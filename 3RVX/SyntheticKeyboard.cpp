@@ -1,5 +1,8 @@
+#define LOG_SUBSYSTEM Hotkeys
+
 #include "SyntheticKeyboard.h"
 
+#include "HotkeyMatcher.h"
 #include "Logger.h"
 
 void SyntheticKeyboard::SimulateKeypress(
@@ -34,6 +37,58 @@ void SyntheticKeyboard::SimulateKeypress(
     delete[] input;
 }
 
+void SyntheticKeyboard::SimulateKeyUp(unsigned short vk) {
+    INPUT input;
+    PopulateInput(input, vk, true);
+    SendInput(1, &input, sizeof(INPUT));
+}
+
+void SyntheticKeyboard::SimulateCombination(
+        int combination, ULONG_PTR extraInfo) {
+
+    struct ModifierKey {
+        int mod;
+        unsigned short vk;
+    };
+    const ModifierKey modKeys[] = {
+        { MOD_ALT, VK_LMENU },
+        { MOD_CONTROL, VK_LCONTROL },
+        { MOD_SHIFT, VK_LSHIFT },
+        { MOD_WIN, VK_LWIN },
+    };
+
+    int mods = (combination >> MOD_OFFSET) & 0xF;
+    std::vector<unsigned short> pressed;
+    for (const ModifierKey &m : modKeys) {
+        if ((mods & m.mod) && (GetAsyncKeyState(m.vk) & 0x8000) == 0) {
+            pressed.push_back(m.vk);
+        }
+    }
+
+    std::vector<INPUT> input(pressed.size() * 2 + 2);
+    unsigned int currentInput = 0;
+    for (unsigned short vk : pressed) {
+        PopulateInput(input[currentInput++], vk, false);
+    }
+
+    unsigned short vk = combination & 0xFF;
+    PopulateInput(input[currentInput++], vk, false);
+    PopulateInput(input[currentInput++], vk, true);
+    if (combination & (0x1 << EXT_OFFSET)) {
+        input[currentInput - 2].ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
+        input[currentInput - 1].ki.dwFlags |= KEYEVENTF_EXTENDEDKEY;
+    }
+
+    for (auto it = pressed.rbegin(); it != pressed.rend(); ++it) {
+        PopulateInput(input[currentInput++], *it, true);
+    }
+
+    for (INPUT &in : input) {
+        in.ki.dwExtraInfo = extraInfo;
+    }
+    SendInput((UINT) input.size(), &input[0], sizeof(INPUT));
+}
+
 void SyntheticKeyboard::PopulateInput(INPUT &in, unsigned short vk, bool up) {
     in = { 0 };
     in.type = INPUT_KEYBOARD;
@@ -24,6 +24,19 @@ public:
     static void SimulateKeypress(
         unsigned short vk, bool handleModifiers = true);
 
+    /// <summary>
+    /// Simulates releasing the given VK code (key up only).
+    /// </summary>
+    static void SimulateKeyUp(unsigned short vk);
+
+    /// <summary>
+    /// Simulates pressing a key combination (in the HotkeyManager storage
+    /// format). Modifiers in the combination that aren't already down are
+    /// pressed first and released afterward. Each event carries the given
+    /// extra info so hooks can recognize it.
+    /// </summary>
+    static void SimulateCombination(int combination, ULONG_PTR extraInfo);
+
 private:
     /// <summary>
     /// Populates an INPUT struct with a VK code, scan code, appropriate flags,
@@ -30,6 +30,13 @@ distribution.
 #   include <cstddef>
 #endif
 
+#ifdef TINYXML2_SSE2
+#   include <emmintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#endif
+
 static const char LINE_FEED				= (char)0x0a;			// all line endings are normalized to LF
 static const char LF = LINE_FEED;
 static const char CARRIAGE_RETURN		= (char)0x0d;			// CR gets filtered out
@@ -102,7 +109,11 @@ char* StrPair::ParseText( char* p, const char* endTag, int strFlags )
 
     // Inner loop of text parsing.
     while ( *p ) {
-        if ( *p == endChar && strncmp( p, endTag, length ) == 0 ) {
+        p = XMLUtil::FindCharOrEnd( p, endChar );
+        if ( !*p ) {
+            break;
+        }
+        if ( strncmp( p, endTag, length ) == 0 ) {
             Set( start, p, strFlags );
             return p + length;
         }
@@ -252,6 +263,102 @@ const char* StrPair::GetStr()
 
 // --------- XMLUtil ----------- //
 
+#ifdef TINYXML2_SSE2
+
+static inline int FirstSetBit( int mask )
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward( &index, mask );
+    return (int)index;
+#else
+    return __builtin_ctz( mask );
+#endif
+}
+
+// The vector loops read whole aligned 16-byte blocks, so the block holding
+// the terminator is also read past it, possibly beyond the end of the
+// allocation. An aligned block never crosses a page boundary, so this can't
+// fault (optimized strlen()s rely on the same thing), but AddressSanitizer
+// would report it; the scanners are excluded from its instrumentation. Any
+// other use of the bytes past the terminator would be a bug.
+#if defined(__clang__) || defined(__GNUC__)
+#   define TINYXML2_NO_SANITIZE __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && _MSC_VER >= 1928
+#   define TINYXML2_NO_SANITIZE __declspec(no_sanitize_address)
+#else
+#   define TINYXML2_NO_SANITIZE
+#endif
+
+static inline bool IsAligned( const char* p )
+{
+    return ( reinterpret_cast<size_t>(p) & 15 ) == 0;
+}
+
+TINYXML2_NO_SANITIZE
+char* XMLUtil::FindCharOrEnd( char* p, char c )
+{
+    while ( !IsAligned( p ) ) {
+        if ( *p == c || !*p ) {
+            return p;
+        }
+        ++p;
+    }
+
+    const __m128i target = _mm_set1_epi8( c );
+    const __m128i zero = _mm_setzero_si128();
+    for( ;; ) {
+        __m128i v = _mm_load_si128( reinterpret_cast<const __m128i*>(p) );
+        __m128i hits = _mm_or_si128( _mm_cmpeq_epi8( v, target ), _mm_cmpeq_epi8( v, zero ) );
+        int mask = _mm_movemask_epi8( hits );
+        if ( mask ) {
+            return p + FirstSetBit( mask );
+        }
+        p += 16;
+    }
+}
+
+TINYXML2_NO_SANITIZE
+const char* XMLUtil::SkipWhiteSpaceSSE2( const char* p )
+{
+    while ( !IsAligned( p ) ) {
+        if ( !IsWhiteSpace( *p ) ) {
+            return p;
+        }
+        ++p;
+    }
+
+    // Whitespace (in the "C" locale) is ' ' and '\t' through '\r'. Bytes with
+    // the high bit set are never whitespace, matching IsWhiteSpace().
+    const __m128i space = _mm_set1_epi8( ' ' );
+    const __m128i low = _mm_set1_epi8( '\t' );
+    const __m128i high = _mm_set1_epi8( '\r' );
+    for( ;; ) {
+        __m128i v = _mm_load_si128( reinterpret_cast<const __m128i*>(p) );
+        __m128i inRange = _mm_and_si128(
+            _mm_cmpeq_epi8( _mm_max_epu8( v, low ), v ),
+            _mm_cmpeq_epi8( _mm_min_epu8( v, high ), v ) );
+        __m128i ws = _mm_or_si128( inRange, _mm_cmpeq_epi8( v, space ) );
+        int mask = ~_mm_movemask_epi8( ws ) & 0xffff;
+        if ( mask ) {
+            return p + FirstSetBit( mask );
+        }
+        p += 16;
+    }
+}
+
+#else
+
+char* XMLUtil::FindCharOrEnd( char* p, char c )
+{
+    while ( *p && *p != c ) {
+        ++p;
+    }
+    return p;
+}
+
+#endif
+
 const char* XMLUtil::ReadBOM( const char* p, bool* bom )
 {
     *bom = false;
@@ -119,6 +119,15 @@ inline int TIXML_SNPRINTF( char* buffer, size_t size, const char* format, ... )
 #define TIXML_SSCANF   sscanf
 #endif
 
+/* 3RVX: SSE2 scanning for whitespace and delimiters. SSE2 is part of the
+   x64 baseline and the default for 32-bit x86 builds, so no runtime
+   dispatch is needed; define TINYXML2_NO_SIMD to use the scalar scanners.
+*/
+#if !defined(TINYXML2_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) \
+        || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+#   define TINYXML2_SSE2
+#endif
+
 /* Versioning, past 1.0.14:
 	http://semver.org/
 */
@@ -517,10 +526,21 @@ public:
     // Anything in the high order range of UTF-8 is assumed to not be whitespace. This isn't
     // correct, but simple, and usually works.
     static const char* SkipWhiteSpace( const char* p )	{
+#ifdef TINYXML2_SSE2
+        // Most runs are empty or a single space; only go wide for longer ones.
+        if ( !IsWhiteSpace( *p ) ) {
+            return p;
+        }
+        if ( !IsWhiteSpace( *(p+1) ) ) {
+            return p + 1;
+        }
+        return SkipWhiteSpaceSSE2( p + 2 );
+#else
         while( !IsUTF8Continuation(*p) && isspace( *reinterpret_cast<const unsigned char*>(p) ) ) {
             ++p;
         }
         return p;
+#endif
     }
     static char* SkipWhiteSpace( char* p )				{
         return const_cast<char*>( SkipWhiteSpace( const_cast<const char*>(p) ) );
@@ -562,6 +582,14 @@ public:
         return ( p & 0x80 ) != 0;
     }
 
+    // Returns the first occurrence of c in the null-terminated string p, or
+    // the terminator if c doesn't occur.
+    static char* FindCharOrEnd( char* p, char c );
+
+#ifdef TINYXML2_SSE2
+    static const char* SkipWhiteSpaceSSE2( const char* p );
+#endif
+
     static const char* ReadBOM( const char* p, bool* hasBOM );
     // p is the starting location,
     // the UTF-8 value of the entity will be placed in value, and length filled in.
@@ -0,0 +1,207 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+std::atomic<bool> Trace::_active(false);
+
+namespace {
+
+struct Slot {
+    /// <summary>
+    /// Position of the event stored in the slot, plus one. Zero while the
+    /// slot is being written.
+    /// </summary>
+    std::atomic<unsigned long long> sequence;
+    Trace::Event event;
+};
+
+const unsigned long long Mask = Trace::Capacity - 1;
+
+std::mutex control;
+Slot *ring;
+std::atomic<unsigned long long> next(0);
+
+/* Position of the first event in the current session */
+unsigned long long first;
+
+unsigned int ThreadId() {
+    return (unsigned int) std::hash<std::thread::id>()(
+        std::this_thread::get_id());
+}
+
+void WriteString(std::ostream &out, const char *str) {
+    out << '"';
+    for (; *str != '\0'; ++str) {
+        if (*str == '"' || *str == '\\') {
+            out << '\\';
+        }
+        out << *str;
+    }
+    out << '"';
+}
+
+}
+
+void Trace::Start() {
+    std::lock_guard<std::mutex> lock(control);
+    if (ring == NULL) {
+        /* Never freed: spans can still be in flight on other threads when
+         * tracing stops. */
+        ring = new Slot[Capacity];
+        for (unsigned int i = 0; i < Capacity; ++i) {
+            ring[i].sequence.store(0);
+        }
+    }
+    first = next.load();
+    _active.store(true);
+}
+
+void Trace::Stop() {
+    std::lock_guard<std::mutex> lock(control);
+    _active.store(false);
+}
+
+unsigned long long Trace::Now() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::Record(const char *name,
+        unsigned long long start, unsigned long long end) {
+
+    if (ring == NULL) {
+        return;
+    }
+
+    unsigned long long pos = next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = ring[pos & Mask];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.event.name = name;
+    slot.event.thread = ThreadId();
+    slot.event.start = start;
+    slot.event.duration = end - start;
+
+    slot.sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::vector<Trace::Event> Trace::Events() {
+    std::lock_guard<std::mutex> lock(control);
+    std::vector<Event> events;
+    if (ring == NULL) {
+        return events;
+    }
+
+    unsigned long long end = next.load();
+    unsigned long long start = first;
+    if (end - start > Capacity) {
+        start = end - Capacity;
+    }
+
+    for (unsigned long long pos = start; pos < end; ++pos) {
+        Slot &slot = ring[pos & Mask];
+
+        /* The slot may be overwritten while it is copied; the sequence
+         * number is checked before and after to detect this. */
+        unsigned long long seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq != pos + 1) {
+            continue;
+        }
+        Event event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+void Trace::WriteJSON(std::ostream &out) {
+    std::vector<Event> events = Events();
+
+    /* Timestamps are made relative to the first span so they are readable
+     * in the viewer. */
+    unsigned long long base = 0;
+    if (events.empty() == false) {
+        base = events[0].start;
+        for (Event &event : events) {
+            if (event.start < base) {
+                base = event.start;
+            }
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (unsigned int i = 0; i < events.size(); ++i) {
+        const Event &event = events[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "{\"name\":";
+        WriteString(out, event.name);
+        out << ",\"cat\":\"3RVX\",\"ph\":\"X\",\"pid\":1"
+            << ",\"tid\":" << event.thread
+            << ",\"ts\":" << (event.start - base)
+            << ",\"dur\":" << event.duration << "}";
+    }
+    out << "\n]}\n";
+}
+
+std::vector<Trace::Summary> Trace::Summarize() {
+    std::vector<Event> events = Events();
+
+    /* The same name can be used by spans in more than one translation unit
+     * (so the literals may not be merged); names are compared by value. */
+    struct NameLess {
+        bool operator()(const char *a, const char *b) const {
+            return strcmp(a, b) < 0;
+        }
+    };
+
+    std::map<const char *, Summary, NameLess> spans;
+    for (const Event &event : events) {
+        auto it = spans.find(event.name);
+        if (it == spans.end()) {
+            Summary s;
+            s.name = event.name;
+            s.count = 0;
+            s.total = 0;
+            s.min = event.duration;
+            s.max = event.duration;
+            it = spans.insert(std::make_pair(event.name, s)).first;
+        }
+
+        Summary &s = it->second;
+        s.count++;
+        s.total += event.duration;
+        s.min = std::min(s.min, event.duration);
+        s.max = std::max(s.max, event.duration);
+    }
+
+    std::vector<Summary> summaries;
+    for (auto it = spans.begin(); it != spans.end(); ++it) {
+        summaries.push_back(it->second);
+    }
+    return summaries;
+}
+
+void Trace::WriteSummary(std::ostream &out) {
+    out << "name,count,total_us,mean_us,min_us,max_us\n";
+    for (const Summary &s : Summarize()) {
+        out << s.name << ','
+            << s.count << ','
+            << s.total << ','
+            << (s.total / s.count) << ','
+            << s.min << ','
+            << s.max << '\n';
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <vector>
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+
+/// <summary>
+/// Records the time spent in the enclosing scope while tracing is active.
+/// The name must be a string literal.
+/// </summary>
+#define TRACE_SPAN(name) \
+    TraceSpan TRACE_CONCAT(_traceSpan, __LINE__)(name)
+
+/// <summary>
+/// Records timed spans (hotkey dispatch, volume changes, meter redraws) so
+/// the time between a hotkey press and the OSD being updated can be broken
+/// down by stage.
+/// <p>
+/// Spans are stored in a fixed-size ring that overwrites the oldest entries,
+/// and can be exported in the Chrome trace event format (viewable in
+/// chrome://tracing or Perfetto). While tracing is inactive, a span costs a
+/// single relaxed atomic load; the ring is not allocated until tracing is
+/// started for the first time.
+/// </summary>
+class Trace {
+public:
+    struct Event {
+        /// <summary>Name of the span (a string literal).</summary>
+        const char *name;
+        unsigned int thread;
+
+        /// <summary>Start time and duration, in microseconds.</summary>
+        unsigned long long start;
+        unsigned long long duration;
+    };
+
+    /// <summary>Statistics for all of the spans with the same name.</summary>
+    struct Summary {
+        const char *name;
+        unsigned int count;
+
+        /// <summary>Total, shortest, and longest durations (us).</summary>
+        unsigned long long total;
+        unsigned long long min;
+        unsigned long long max;
+    };
+
+    static const unsigned int Capacity = 8192;
+
+    /// <summary>
+    /// Starts recording spans. Spans recorded by any previous session are
+    /// discarded.
+    /// </summary>
+    static void Start();
+    static void Stop();
+
+    static bool Active() {
+        return _active.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Retrieves the current time, in microseconds. Only differences between
+    /// times are meaningful.
+    /// </summary>
+    static unsigned long long Now();
+
+    /// <summary>
+    /// Adds a span to the trace. Safe to call from any thread.
+    /// </summary>
+    static void Record(const char *name,
+        unsigned long long start, unsigned long long end);
+
+    /// <summary>
+    /// Retrieves the spans recorded since tracing was last started, oldest
+    /// first. If more than Capacity spans were recorded, only the most recent
+    /// are returned. Spans being written while this method runs are skipped.
+    /// </summary>
+    static std::vector<Event> Events();
+
+    /// <summary>
+    /// Writes the recorded spans as a Chrome trace event JSON document.
+    /// </summary>
+    static void WriteJSON(std::ostream &out);
+
+    /// <summary>
+    /// Groups the recorded spans by name, sorted by name.
+    /// </summary>
+    static std::vector<Summary> Summarize();
+
+    /// <summary>
+    /// Writes the span statistics as CSV (one line per span name) so timings
+    /// can be compared between builds.
+    /// </summary>
+    static void WriteSummary(std::ostream &out);
+
+private:
+    static std::atomic<bool> _active;
+};
+
+/// <summary>
+/// Records a span covering its own lifetime. Use the TRACE_SPAN macro rather
+/// than creating these directly.
+/// </summary>
+class TraceSpan {
+public:
+    TraceSpan(const char *name) :
+    _name(name),
+    _active(Trace::Active()),
+    _start(0) {
+        if (_active) {
+            _start = Trace::Now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (_active) {
+            Trace::Record(_name, _start, Trace::Now());
+        }
+    }
+
+private:
+    const char *_name;
+    bool _active;
+    unsigned long long _start;
+};
\ No newline at end of file
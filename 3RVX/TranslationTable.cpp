@@ -0,0 +1,99 @@
+#include "TranslationTable.h"
+
+#include <cwchar>
+#include <utility>
+
+TranslationTable::TranslationTable() {
+    Clear();
+}
+
+bool TranslationTable::Add(
+        const std::wstring &original, std::wstring translation) {
+
+    unsigned int hash = Hash(original.c_str(), original.size());
+    int slot = Slot(original.c_str(), original.size(), hash);
+    if (_slots[slot] != NotFound) {
+        return false;
+    }
+
+    Entry entry;
+    entry.hash = hash;
+    entry.offset = _arena.size();
+    entry.length = original.size();
+    _arena.append(original);
+
+    _slots[slot] = (int) _entries.size();
+    _entries.push_back(entry);
+    _translations.push_back(std::move(translation));
+
+    /* Keep the load factor at or below 1/2 */
+    if (_entries.size() * 2 > _slots.size()) {
+        Grow();
+    }
+
+    return true;
+}
+
+int TranslationTable::Find(const std::wstring &original) const {
+    unsigned int hash = Hash(original.c_str(), original.size());
+    return _slots[Slot(original.c_str(), original.size(), hash)];
+}
+
+const std::wstring &TranslationTable::Translation(int handle) const {
+    return _translations[handle];
+}
+
+size_t TranslationTable::Size() const {
+    return _entries.size();
+}
+
+void TranslationTable::Clear() {
+    _arena.clear();
+    _entries.clear();
+    _translations.clear();
+    _slots.assign(16, (int) NotFound);
+}
+
+int TranslationTable::Slot(
+        const wchar_t *str, size_t length, unsigned int hash) const {
+
+    size_t mask = _slots.size() - 1;
+    size_t slot = hash & mask;
+    while (true) {
+        int index = _slots[slot];
+        if (index == NotFound) {
+            return (int) slot;
+        }
+
+        const Entry &entry = _entries[index];
+        if (entry.hash == hash && entry.length == length
+                && wmemcmp(&_arena[entry.offset], str, length) == 0) {
+            return (int) slot;
+        }
+
+        /* Linear probing */
+        slot = (slot + 1) & mask;
+    }
+}
+
+void TranslationTable::Grow() {
+    _slots.assign(_slots.size() * 2, (int) NotFound);
+    size_t mask = _slots.size() - 1;
+    for (unsigned int i = 0; i < _entries.size(); ++i) {
+        size_t slot = _entries[i].hash & mask;
+        while (_slots[slot] != NotFound) {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = (int) i;
+    }
+}
+
+unsigned int TranslationTable::Hash(const wchar_t *str, size_t length) {
+    /* FNV-1a over the UTF-16 code units */
+    unsigned int hash = 2166136261U;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned int) str[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Maps original strings to their translations.
+/// <p>
+/// The table is built once, when a language file is loaded, and is read-only
+/// afterward. Original strings are stored back to back in a single arena and
+/// indexed by an open-addressed hash table that is kept at most half full, so
+/// a lookup hashes the string once and usually compares it against a single
+/// entry. Translations are stored as separate strings so they can be returned
+/// by reference.
+/// </summary>
+class TranslationTable {
+public:
+    /// <summary>Returned by Find() when a string has no translation.</summary>
+    static const int NotFound = -1;
+
+    TranslationTable();
+
+    /// <summary>
+    /// Adds a translation. Returns false (and leaves the table unchanged) if
+    /// the original string is already in the table.
+    /// </summary>
+    bool Add(const std::wstring &original, std::wstring translation);
+
+    /// <summary>
+    /// Retrieves the handle of the translation for the given string, or
+    /// NotFound.
+    /// </summary>
+    int Find(const std::wstring &original) const;
+
+    /// <summary>Retrieves a translation by its handle.</summary>
+    const std::wstring &Translation(int handle) const;
+
+    size_t Size() const;
+    void Clear();
+
+private:
+    struct Entry {
+        unsigned int hash;
+        size_t offset;
+        size_t length;
+    };
+
+    std::wstring _arena;
+    std::vector<Entry> _entries;
+    std::vector<std::wstring> _translations;
+
+    /// <summary>
+    /// Entry indexes (or NotFound for empty slots). The size is always a
+    /// power of two.
+    /// </summary>
+    std::vector<int> _slots;
+
+    int Slot(const wchar_t *str, size_t length, unsigned int hash) const;
+    void Grow();
+
+    static unsigned int Hash(const wchar_t *str, size_t length);
+};
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "UTF8.h"
+
+/* SSE2 is part of the x64 baseline and the default for 32-bit x86 builds,
+ * so no runtime dispatch is needed; define UTF8_NO_SIMD to use only the
+ * scalar conversions. */
+#if !defined(UTF8_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const unsigned int Replacement = 0xFFFD;
+
+}
+
+size_t UTF8::MaxWideLength(size_t length) {
+    /* Every byte produces at most one character; four-byte sequences
+     * produce a surrogate pair in UTF-16. */
+    return length;
+}
+
+size_t UTF8::MaxNarrowLength(size_t length) {
+    /* A UTF-16 surrogate pair is four bytes, and every other UTF-16 unit
+     * (including replacements) is at most three. */
+    return length * (sizeof(wchar_t) == 2 ? 3 : 4);
+}
+
+size_t UTF8::Decode(const char *in, size_t length, wchar_t *out) {
+    const unsigned char *s = (const unsigned char *) in;
+    const unsigned char *end = s + length;
+    wchar_t *o = out;
+
+    while (s < end) {
+#ifdef UTF8_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while (end - s >= 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *) s);
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+
+            __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+            __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+            if (sizeof(wchar_t) == 2) {
+                _mm_storeu_si128((__m128i *) o, lo);
+                _mm_storeu_si128((__m128i *) (o + 8), hi);
+            } else {
+                _mm_storeu_si128((__m128i *) o, _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128((__m128i *) (o + 4),
+                    _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128((__m128i *) (o + 8),
+                    _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128((__m128i *) (o + 12),
+                    _mm_unpackhi_epi16(hi, zero));
+            }
+            s += 16;
+            o += 16;
+        }
+        if (s == end) {
+            break;
+        }
+#endif
+
+        unsigned int c = *s++;
+        if (c < 0x80) {
+            *o++ = (wchar_t) c;
+            continue;
+        }
+
+        /* The valid range of the first continuation byte is narrower for
+         * some lead bytes, which rules out overlong encodings, surrogates,
+         * and code points above U+10FFFF. */
+        int continuation;
+        unsigned int codePoint;
+        unsigned int lo = 0x80;
+        unsigned int hi = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            continuation = 1;
+            codePoint = c & 0x1F;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            continuation = 2;
+            codePoint = c & 0x0F;
+            if (c == 0xE0) {
+                lo = 0xA0;
+            } else if (c == 0xED) {
+                hi = 0x9F;
+            }
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            continuation = 3;
+            codePoint = c & 0x07;
+            if (c == 0xF0) {
+                lo = 0x90;
+            } else if (c == 0xF4) {
+                hi = 0x8F;
+            }
+        } else {
+            *o++ = (wchar_t) Replacement;
+            continue;
+        }
+
+        /* A truncated or invalid sequence is replaced by a single U+FFFD,
+         * and decoding resumes at the byte that ended it. */
+        int i = 0;
+        for (; i < continuation && s < end; ++i) {
+            if (*s < lo || *s > hi) {
+                break;
+            }
+            codePoint = (codePoint << 6) | (*s & 0x3F);
+            lo = 0x80;
+            hi = 0xBF;
+            ++s;
+        }
+
+        if (i < continuation) {
+            *o++ = (wchar_t) Replacement;
+        } else {
+            o = PutWide(codePoint, o);
+        }
+    }
+
+    return o - out;
+}
+
+size_t UTF8::Encode(const wchar_t *in, size_t length, char *out) {
+    const wchar_t *s = in;
+    const wchar_t *end = in + length;
+    char *o = out;
+
+    while (s < end) {
+#ifdef UTF8_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while (end - s >= 16) {
+            __m128i packed;
+            if (sizeof(wchar_t) == 2) {
+                __m128i a = _mm_loadu_si128((const __m128i *) s);
+                __m128i b = _mm_loadu_si128((const __m128i *) (s + 8));
+                __m128i high = _mm_and_si128(_mm_or_si128(a, b),
+                    _mm_set1_epi16((short) 0xFF80));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) {
+                    break;
+                }
+                packed = _mm_packus_epi16(a, b);
+            } else {
+                __m128i a = _mm_loadu_si128((const __m128i *) s);
+                __m128i b = _mm_loadu_si128((const __m128i *) (s + 4));
+                __m128i c = _mm_loadu_si128((const __m128i *) (s + 8));
+                __m128i d = _mm_loadu_si128((const __m128i *) (s + 12));
+                __m128i all = _mm_or_si128(_mm_or_si128(a, b),
+                    _mm_or_si128(c, d));
+                __m128i high = _mm_and_si128(all, _mm_set1_epi32(~0x7F));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF) {
+                    break;
+                }
+                packed = _mm_packus_epi16(
+                    _mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            }
+            _mm_storeu_si128((__m128i *) o, packed);
+            s += 16;
+            o += 16;
+        }
+        if (s == end) {
+            break;
+        }
+#endif
+
+        unsigned int c = (unsigned int) *s++;
+        if (sizeof(wchar_t) == 2) {
+            c &= 0xFFFF;
+        }
+
+        if (c < 0x80) {
+            *o++ = (char) c;
+            continue;
+        }
+
+        if (c >= 0xD800 && c <= 0xDFFF) {
+            /* Surrogates are only valid as a high/low pair in UTF-16 */
+            unsigned int low = (s < end) ? ((unsigned int) *s & 0xFFFF) : 0;
+            if (sizeof(wchar_t) == 2 && c <= 0xDBFF
+                    && low >= 0xDC00 && low <= 0xDFFF) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                ++s;
+            } else {
+                c = Replacement;
+            }
+        } else if (c > 0x10FFFF) {
+            c = Replacement;
+        }
+
+        o = PutNarrow(c, o);
+    }
+
+    return o - out;
+}
+
+wchar_t *UTF8::PutWide(unsigned int codePoint, wchar_t *out) {
+    if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        *out++ = (wchar_t) (0xD800 + (codePoint >> 10));
+        *out++ = (wchar_t) (0xDC00 + (codePoint & 0x3FF));
+    } else {
+        *out++ = (wchar_t) codePoint;
+    }
+    return out;
+}
+
+char *UTF8::PutNarrow(unsigned int codePoint, char *out) {
+    if (codePoint < 0x80) {
+        *out++ = (char) codePoint;
+    } else if (codePoint < 0x800) {
+        *out++ = (char) (0xC0 | (codePoint >> 6));
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        *out++ = (char) (0xE0 | (codePoint >> 12));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    } else {
+        *out++ = (char) (0xF0 | (codePoint >> 18));
+        *out++ = (char) (0x80 | ((codePoint >> 12) & 0x3F));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    }
+    return out;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+/// <summary>
+/// Converts between UTF-8 and wide strings (UTF-16 on Windows, UTF-32 on
+/// platforms with a 32-bit wchar_t) without the Win32 code page functions.
+/// <p>
+/// Conversions write to a caller-provided buffer in a single pass; size the
+/// buffer with MaxWideLength() or MaxNarrowLength() rather than measuring
+/// the output first. Runs of ASCII are converted 16 characters at a time
+/// with SSE2 where it is available. Invalid input (malformed UTF-8 or
+/// unpaired surrogates) is replaced with U+FFFD, as MultiByteToWideChar and
+/// WideCharToMultiByte do.
+/// </summary>
+class UTF8 {
+public:
+    /// <summary>
+    /// Retrieves the largest number of wide characters Decode() can produce
+    /// from the given number of UTF-8 bytes.
+    /// </summary>
+    static size_t MaxWideLength(size_t length);
+
+    /// <summary>
+    /// Retrieves the largest number of bytes Encode() can produce from the
+    /// given number of wide characters.
+    /// </summary>
+    static size_t MaxNarrowLength(size_t length);
+
+    /// <summary>
+    /// Converts UTF-8 to a wide string. The output buffer must hold at least
+    /// MaxWideLength(length) characters; it is not null-terminated. Returns
+    /// the number of characters written.
+    /// </summary>
+    static size_t Decode(const char *in, size_t length, wchar_t *out);
+
+    /// <summary>
+    /// Converts a wide string to UTF-8. The output buffer must hold at least
+    /// MaxNarrowLength(length) bytes; it is not null-terminated. Returns the
+    /// number of bytes written.
+    /// </summary>
+    static size_t Encode(const wchar_t *in, size_t length, char *out);
+
+private:
+    static wchar_t *PutWide(unsigned int codePoint, wchar_t *out);
+    static char *PutNarrow(unsigned int codePoint, char *out);
+};
\ No newline at end of file
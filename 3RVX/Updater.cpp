@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Updates
+
 #include "Updater.h"
 
 #pragma comment(lib, "Version.lib")
@@ -39,14 +41,14 @@ std::pair<int, int> Updater::MainAppVersion() {
 
     DWORD size = GetFileVersionInfoSize(mainExe.c_str(), NULL);
     if (size == 0) {
-        CLOG(L"Could not determine version info size");
+        ELOG(L"Could not determine version info size");
         return version;
     }
 
     unsigned char *block = new unsigned char[size];
     result = GetFileVersionInfo(mainExe.c_str(), NULL, size, block);
     if (result == 0) {
-        CLOG(L"Failed to retrieve file version info");
+        ELOG(L"Failed to retrieve file version info");
         delete[] block;
         return version;
     }
@@ -55,13 +57,13 @@ std::pair<int, int> Updater::MainAppVersion() {
     VS_FIXEDFILEINFO *vers;
     result = VerQueryValue(block, L"\\", (void **) &vers, &dataSz);
     if (result == 0) {
-        CLOG(L"Could not query root block for version info");
+        ELOG(L"Could not query root block for version info");
         delete[] block;
         return version;
     }
 
     if (vers->dwSignature != 0xFEEF04BD) {
-        CLOG(L"Invalid version signature");
+        ELOG(L"Invalid version signature");
         delete[] block;
         return version;
     }
@@ -97,7 +99,7 @@ std::pair<int, int> Updater::RemoteVersion() {
         0);
 
     if (connection == NULL) {
-        CLOG(L"Could not connect to URL!");
+        ELOG(L"Could not connect to URL!");
         return std::pair<int, int>(0, 0);
     }
 
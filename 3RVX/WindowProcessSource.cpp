@@ -0,0 +1,27 @@
+#include "WindowProcessSource.h"
+
+#include <Windows.h>
+
+unsigned long WindowProcessSource::ProcessId(void *window) {
+    DWORD pid = 0;
+    GetWindowThreadProcessId((HWND) window, &pid);
+    return pid;
+}
+
+std::wstring WindowProcessSource::ProcessPath(unsigned long pid) {
+    HANDLE process = OpenProcess(
+        PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (process == NULL) {
+        return L"";
+    }
+
+    std::wstring path;
+    wchar_t buf[MAX_PATH];
+    DWORD size = MAX_PATH;
+    if (QueryFullProcessImageName(process, 0, buf, &size)) {
+        path = std::wstring(buf, size);
+    }
+
+    CloseHandle(process);
+    return path;
+}
\ No newline at end of file
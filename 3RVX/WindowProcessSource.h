@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ProcessSource.h"
+
+/// <summary>
+/// Looks up the process that owns a window with the Win32 API.
+/// </summary>
+class WindowProcessSource : public ProcessSource {
+public:
+    virtual unsigned long ProcessId(void *window);
+    virtual std::wstring ProcessPath(unsigned long pid);
+};
\ No newline at end of file
@@ -0,0 +1,399 @@
+#include "XMLReader.h"
+
+#include <cstring>
+
+#include "TinyXml2/tinyxml2.h"
+
+using tinyxml2::XMLUtil;
+
+namespace {
+
+struct Entity {
+    const char *pattern;
+    size_t length;
+    char value;
+};
+
+const Entity Entities[] = {
+    { "quot", 4, '\"' },
+    { "amp", 3, '&' },
+    { "apos", 4, '\'' },
+    { "lt", 2, '<' },
+    { "gt", 2, '>' },
+};
+
+}
+
+XMLReader::XMLReader() {
+    Load("", 0);
+}
+
+bool XMLReader::Load(FILE *fp) {
+    _buffer.clear();
+    if (fp == NULL || fseek(fp, 0, SEEK_END) != 0) {
+        Load("", 0);
+        return false;
+    }
+
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < 0) {
+        Load("", 0);
+        return false;
+    }
+
+    _buffer.resize((size_t) size + 1);
+    size_t read = fread(&_buffer[0], 1, (size_t) size, fp);
+    if (read != (size_t) size) {
+        Load("", 0);
+        return false;
+    }
+
+    _buffer[size] = '\0';
+    Reset();
+    return true;
+}
+
+void XMLReader::Load(const char *xml, size_t length) {
+    _buffer.assign(xml, xml + length);
+    _buffer.push_back('\0');
+    Reset();
+}
+
+void XMLReader::Reset() {
+    bool bom;
+    _p = const_cast<char *>(XMLUtil::ReadBOM(&_buffer[0], &bom));
+    _event = StartElement;
+    _name = NULL;
+    _value = NULL;
+    _open.clear();
+    _tagPending = false;
+    _closePending = false;
+    _attributes.clear();
+}
+
+XMLReader::Event XMLReader::Next() {
+    if (_event == End || _event == Error) {
+        return _event;
+    }
+
+    if (_closePending) {
+        /* The name of the empty element is still set */
+        _closePending = false;
+        _attributes.clear();
+        _open.pop_back();
+        return _event = EndElement;
+    }
+
+    _name = NULL;
+    _value = NULL;
+    _attributes.clear();
+
+    while (true) {
+        if (_tagPending) {
+            _tagPending = false;
+            if (ReadTag(_p + 1)) {
+                return _event;
+            }
+            continue;
+        }
+
+        if (*_p == '\0') {
+            if (_open.empty() == false) {
+                Fail();
+                return _event;
+            }
+            return _event = End;
+        }
+
+        bool read = (*_p == '<') ? ReadTag(_p + 1) : ReadText(_p);
+        if (read) {
+            return _event;
+        }
+    }
+}
+
+bool XMLReader::ReadTag(char *p) {
+    if (strncmp(p, "!--", 3) == 0) {
+        char *end = strstr(p + 3, "-->");
+        if (end == NULL) {
+            return Fail();
+        }
+        _p = end + 3;
+        return false;
+    }
+
+    if (strncmp(p, "![CDATA[", 8) == 0) {
+        char *end = strstr(p + 8, "]]>");
+        if (end == NULL) {
+            return Fail();
+        }
+        *end = '\0';
+        _value = p + 8;
+        _p = end + 3;
+        _event = Text;
+        return true;
+    }
+
+    if (*p == '?' || *p == '!') {
+        /* Declarations and DOCTYPEs */
+        char *end = strchr(p, '>');
+        if (end == NULL) {
+            return Fail();
+        }
+        _p = end + 1;
+        return false;
+    }
+
+    if (*p == '/') {
+        return ReadEndTag(p + 1);
+    }
+
+    return ReadStartTag(p);
+}
+
+bool XMLReader::ReadStartTag(char *p) {
+    char *name = p;
+    char *nameEnd = ReadName(p);
+    if (nameEnd == name) {
+        return Fail();
+    }
+
+    p = nameEnd;
+    bool empty = false;
+    while (true) {
+        p = XMLUtil::SkipWhiteSpace(p);
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+
+        if (*p == '/') {
+            if (*(p + 1) != '>') {
+                return Fail();
+            }
+            empty = true;
+            p += 2;
+            break;
+        }
+
+        char *attr = p;
+        char *attrEnd = ReadName(p);
+        if (attrEnd == attr) {
+            return Fail();
+        }
+
+        p = XMLUtil::SkipWhiteSpace(attrEnd);
+        if (*p != '=') {
+            return Fail();
+        }
+        *attrEnd = '\0';
+
+        p = XMLUtil::SkipWhiteSpace(p + 1);
+        char quote = *p;
+        if (quote != '\"' && quote != '\'') {
+            return Fail();
+        }
+
+        char *value = p + 1;
+        char *valueEnd = strchr(value, quote);
+        if (valueEnd == NULL) {
+            return Fail();
+        }
+        Unescape(value, valueEnd);
+        _attributes.push_back(std::make_pair(attr, value));
+        p = valueEnd + 1;
+    }
+
+    /* The character following the name has been consumed by now */
+    *nameEnd = '\0';
+    _name = name;
+    _p = p;
+    _open.push_back(name);
+    _closePending = empty;
+    _event = StartElement;
+    return true;
+}
+
+bool XMLReader::ReadEndTag(char *p) {
+    char *name = p;
+    char *nameEnd = ReadName(p);
+    if (nameEnd == name || _open.empty()) {
+        return Fail();
+    }
+
+    p = XMLUtil::SkipWhiteSpace(nameEnd);
+    if (*p != '>') {
+        return Fail();
+    }
+
+    *nameEnd = '\0';
+    if (strcmp(name, _open.back()) != 0) {
+        /* The end tag doesn't match the element that is open */
+        return Fail();
+    }
+
+    _name = name;
+    _p = p + 1;
+    _open.pop_back();
+    _event = EndElement;
+    return true;
+}
+
+bool XMLReader::ReadText(char *p) {
+    char *end = strchr(p, '<');
+    if (end == NULL) {
+        end = p + strlen(p);
+    }
+
+    char *text = XMLUtil::SkipWhiteSpace(p);
+    if (text >= end) {
+        _p = end;
+        return false;
+    }
+
+    if (*end == '\0' || _open.empty()) {
+        /* Text is only allowed inside the root element */
+        return Fail();
+    }
+
+    Unescape(p, end);
+    _value = p;
+    _p = end;
+    _tagPending = true;
+    _event = Text;
+    return true;
+}
+
+bool XMLReader::Fail() {
+    _event = Error;
+    _name = NULL;
+    _value = NULL;
+    _closePending = false;
+    _tagPending = false;
+    _attributes.clear();
+    return true;
+}
+
+const char *XMLReader::Name() const {
+    return _name;
+}
+
+bool XMLReader::IsElement(const char *name) const {
+    return _name != NULL && strcmp(_name, name) == 0;
+}
+
+const char *XMLReader::Attribute(const char *name) const {
+    for (const auto &attr : _attributes) {
+        if (strcmp(attr.first, name) == 0) {
+            return attr.second;
+        }
+    }
+    return NULL;
+}
+
+const char *XMLReader::Value() const {
+    return _value;
+}
+
+int XMLReader::Depth() const {
+    return (int) _open.size();
+}
+
+const char *XMLReader::ElementText() {
+    if (_event != StartElement) {
+        return NULL;
+    }
+
+    int depth = Depth();
+    const char *text = NULL;
+    while (true) {
+        Event e = Next();
+        if (e == Text && text == NULL && Depth() == depth) {
+            text = _value;
+        } else if (e == EndElement && Depth() < depth) {
+            return text;
+        } else if (e == End || e == Error) {
+            return NULL;
+        }
+    }
+}
+
+bool XMLReader::Skip() {
+    if (_event != StartElement) {
+        return false;
+    }
+
+    int depth = Depth();
+    while (true) {
+        Event e = Next();
+        if (e == EndElement && Depth() < depth) {
+            return true;
+        } else if (e == End || e == Error) {
+            return false;
+        }
+    }
+}
+
+char *XMLReader::ReadName(char *p) {
+    if (XMLUtil::IsNameStartChar((unsigned char) *p) == false) {
+        return p;
+    }
+
+    ++p;
+    while (*p && XMLUtil::IsNameChar((unsigned char) *p)) {
+        ++p;
+    }
+    return p;
+}
+
+void XMLReader::Unescape(char *start, char *end) {
+    char *p = start;
+    char *q = start;
+
+    /* Text can only shrink, so the output never overtakes the input. */
+    while (p < end) {
+        if (*p == '\r') {
+            *q++ = '\n';
+            p += (p + 1 < end && *(p + 1) == '\n') ? 2 : 1;
+            continue;
+        }
+
+        if (*p != '&') {
+            *q++ = *p++;
+            continue;
+        }
+
+        if (*(p + 1) == '#') {
+            char buf[10] = { 0 };
+            int len = 0;
+            const char *next = XMLUtil::GetCharacterRef(p, buf, &len);
+            if (next != NULL && next <= end && len > 0) {
+                memcpy(q, buf, len);
+                q += len;
+                p = const_cast<char *>(next);
+                continue;
+            }
+        } else {
+            bool found = false;
+            for (const Entity &entity : Entities) {
+                if (p + entity.length + 1 < end
+                        && strncmp(p + 1, entity.pattern, entity.length) == 0
+                        && *(p + entity.length + 1) == ';') {
+                    *q++ = entity.value;
+                    p += entity.length + 2;
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+        }
+
+        /* Not a recognized entity; keep it as-is */
+        *q++ = *p++;
+    }
+
+    *q = '\0';
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Forward-only (pull) XML reader for documents that are read once, such as
+/// language files.
+/// <p>
+/// Unlike tinyxml2::XMLDocument, the reader doesn't build a tree. The
+/// document is read into a single buffer and parsed in place: names, values,
+/// and text are unescaped and null-terminated inside the buffer, and the
+/// strings returned by the reader point into it. They remain valid until the
+/// reader is destroyed or another document is loaded. Aside from the buffer,
+/// the (reused) attribute list, and the stack of open elements, no memory is
+/// allocated while parsing.
+/// <p>
+/// Comments, processing instructions, and DOCTYPEs are skipped, as is text
+/// that consists only of whitespace. Line endings in text are normalized to
+/// LF, and the same entities as tinyxml2 are supported.
+/// </summary>
+class XMLReader {
+public:
+    enum Event {
+        StartElement,
+        EndElement,
+        Text,
+        End,
+        Error
+    };
+
+    XMLReader();
+
+    /// <summary>Reads the entire file into the reader's buffer.</summary>
+    bool Load(FILE *fp);
+
+    /// <summary>Copies the given document into the reader's buffer.</summary>
+    void Load(const char *xml, size_t length);
+
+    /// <summary>Advances to the next event in the document.</summary>
+    Event Next();
+
+    /// <summary>
+    /// Element name for StartElement and EndElement events, or NULL.
+    /// </summary>
+    const char *Name() const;
+
+    /// <summary>
+    /// Determines whether the current element's name is equal to the given
+    /// name.
+    /// </summary>
+    bool IsElement(const char *name) const;
+
+    /// <summary>
+    /// Retrieves an attribute of the current element, or NULL if the
+    /// attribute doesn't exist. Only valid after a StartElement event.
+    /// </summary>
+    const char *Attribute(const char *name) const;
+
+    /// <summary>Text content for Text events, or NULL.</summary>
+    const char *Value() const;
+
+    /// <summary>
+    /// Number of elements that are currently open: 1 after the StartElement
+    /// event for the root element, and 0 after its EndElement event.
+    /// </summary>
+    int Depth() const;
+
+    /// <summary>
+    /// Reads up to the end of the current element, returning its first text
+    /// child (or NULL if it has none). Must be called after StartElement.
+    /// </summary>
+    const char *ElementText();
+
+    /// <summary>
+    /// Skips the remainder of the current element, including its children.
+    /// Must be called after StartElement.
+    /// </summary>
+    bool Skip();
+
+private:
+    std::vector<char> _buffer;
+    char *_p;
+
+    Event _event;
+    const char *_name;
+    const char *_value;
+
+    /// <summary>
+    /// Names of the elements that are currently open, so each end tag can be
+    /// checked against the element it closes.
+    /// </summary>
+    std::vector<const char *> _open;
+
+    /// <summary>
+    /// Set when the previous event overwrote the '&lt;' that begins the next
+    /// tag with a null terminator.
+    /// </summary>
+    bool _tagPending;
+
+    /// <summary>
+    /// Set when an empty element (&lt;a/&gt;) still needs its EndElement.
+    /// </summary>
+    bool _closePending;
+
+    std::vector<std::pair<const char *, const char *>> _attributes;
+
+    void Reset();
+
+    /* Each of these reads from p (after the opening '<' for tags) and
+     * returns false if nothing was produced (a comment or whitespace) */
+    bool ReadTag(char *p);
+    bool ReadStartTag(char *p);
+    bool ReadEndTag(char *p);
+    bool ReadText(char *p);
+    bool Fail();
+
+    static char *ReadName(char *p);
+
+    /// <summary>
+    /// Unescapes text in the range [start, end) in place and null-terminates
+    /// it. The terminator may be written at end.
+    /// </summary>
+    static void Unescape(char *start, char *end);
+};
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#ifndef BENCH_SOURCE_DIR
+#define BENCH_SOURCE_DIR "."
+#endif
+
+namespace {
+
+/* Keeps a single benchmark from running away */
+const unsigned long long MaxIterations = 1000000000ULL;
+
+std::string Duration(double seconds) {
+    std::ostringstream ss;
+    ss.precision(1);
+    ss << std::fixed;
+    if (seconds < 1e-6) {
+        ss << seconds * 1e9 << " ns";
+    } else if (seconds < 1e-3) {
+        ss << seconds * 1e6 << " us";
+    } else {
+        ss << seconds * 1e3 << " ms";
+    }
+    return ss.str();
+}
+
+std::string JSONString(const std::string &str) {
+    std::string escaped("\"");
+    for (char ch : str) {
+        if (ch == '"' || ch == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(ch);
+    }
+    return escaped + "\"";
+}
+
+}
+
+std::string Benchmark::_sourceDir(BENCH_SOURCE_DIR);
+const void *volatile Benchmark::_sink = NULL;
+
+Benchmark::State::State(double minTime) :
+_minTime(minTime),
+_elapsed(0),
+_iterations(0),
+_batch(0),
+_remaining(0),
+_bytes(0),
+_items(0) {
+
+}
+
+bool Benchmark::State::KeepRunning() {
+    if (_remaining > 0) {
+        --_remaining;
+        return true;
+    }
+
+    if (_skipped.empty() == false) {
+        return false;
+    }
+
+    Clock::time_point now = Clock::now();
+    if (_batch == 0) {
+        _start = now;
+        _batch = 1;
+    } else {
+        _elapsed = std::chrono::duration<double>(now - _start).count();
+        if (_elapsed >= _minTime || _iterations >= MaxIterations) {
+            return false;
+        }
+        _batch *= 2;
+    }
+
+    /* This call starts the first iteration of the batch */
+    _iterations += _batch;
+    _remaining = _batch - 1;
+    return true;
+}
+
+void Benchmark::State::Bytes(unsigned long long bytes) {
+    _bytes = bytes;
+}
+
+void Benchmark::State::Items(unsigned long long items) {
+    _items = items;
+}
+
+void Benchmark::State::Counter(const std::string &name, double value) {
+    _counters.push_back(std::make_pair(name, value));
+}
+
+void Benchmark::State::Skip(const std::string &reason) {
+    _skipped = reason;
+    _remaining = 0;
+}
+
+Benchmark::Benchmark(const char *name, Function function) {
+    Case c = { name, function };
+    Cases().push_back(c);
+}
+
+std::vector<Benchmark::Case> &Benchmark::Cases() {
+    /* Registered during static initialization; see Test::Cases() */
+    static std::vector<Case> cases;
+    return cases;
+}
+
+const std::string &Benchmark::SourceDir() {
+    return _sourceDir;
+}
+
+bool Benchmark::ReadFile(const std::string &path, std::string &contents) {
+    FILE *stream = fopen(path.c_str(), "rb");
+    if (stream == NULL) {
+        return false;
+    }
+
+    contents.clear();
+    char buf[65536];
+    size_t read;
+    while ((read = fread(buf, 1, sizeof(buf), stream)) > 0) {
+        contents.append(buf, read);
+    }
+    fclose(stream);
+    return true;
+}
+
+int Benchmark::Main(int argc, char *argv[]) {
+    std::string filter;
+    double minTime = 0.2;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = atof(argv[++i]);
+        } else if (arg == "--source" && i + 1 < argc) {
+            _sourceDir = argv[++i];
+        } else {
+            std::cerr << "Usage: bench [--filter name] [--min-time seconds] "
+                "[--source dir] [--json]\n";
+            return 2;
+        }
+    }
+
+    if (json) {
+        std::cout << "[\n";
+    }
+
+    int run = 0;
+    for (const Case &c : Cases()) {
+        if (std::string(c.name).find(filter) == std::string::npos) {
+            continue;
+        }
+
+        State state(minTime);
+        c.function(state);
+
+        double perIteration = (state._iterations > 0)
+            ? state._elapsed / state._iterations : 0;
+        double mbPerSecond = (state._bytes > 0 && state._elapsed > 0)
+            ? state._bytes * (double) state._iterations
+                / state._elapsed / 1e6
+            : 0;
+
+        if (json) {
+            std::cout << (run > 0 ? ",\n" : "") << "  {\"name\": "
+                << JSONString(c.name);
+            if (state._skipped.empty() == false) {
+                std::cout << ", \"skipped\": " << JSONString(state._skipped);
+            }
+            std::cout << ", \"iterations\": " << state._iterations
+                << ", \"ns_per_iteration\": " << perIteration * 1e9;
+            if (state._items > 0) {
+                std::cout << ", \"ns_per_item\": "
+                    << perIteration * 1e9 / state._items;
+            }
+            if (state._bytes > 0) {
+                std::cout << ", \"mb_per_second\": " << mbPerSecond;
+            }
+            for (auto &counter : state._counters) {
+                std::cout << ", " << JSONString(counter.first) << ": "
+                    << counter.second;
+            }
+            std::cout << "}";
+        } else {
+            std::cout << c.name;
+            if (state._skipped.empty() == false) {
+                std::cout << "  skipped: " << state._skipped << "\n";
+                ++run;
+                continue;
+            }
+
+            std::cout << "  " << Duration(perIteration) << " x "
+                << state._iterations;
+            if (state._items > 0) {
+                std::cout << "  " << Duration(perIteration / state._items)
+                    << "/item";
+            }
+            if (state._bytes > 0) {
+                std::cout.precision(1);
+                std::cout << "  " << std::fixed << mbPerSecond << " MB/s";
+                std::cout.unsetf(std::ios::fixed);
+                std::cout.precision(6);
+            }
+            for (auto &counter : state._counters) {
+                std::cout << "  " << counter.first << "=" << counter.second;
+            }
+            std::cout << "\n";
+        }
+        ++run;
+    }
+
+    if (json) {
+        std::cout << "\n]\n";
+    }
+    return 0;
+}
+
+/// <summary>
+/// Runs the benchmarks; see Benchmark::Main() for the options.
+/// </summary>
+int main(int argc, char *argv[]) {
+    return Benchmark::Main(argc, argv);
+}
\ No newline at end of file
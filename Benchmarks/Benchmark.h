@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define BENCHMARK(name) \
+    static void name(Benchmark::State &state); \
+    static Benchmark name##Benchmark(#name, &name); \
+    static void name(Benchmark::State &state)
+
+/// <summary>
+/// Minimal benchmark registry in the style of Google Benchmark. Each
+/// BENCHMARK() registers a function that repeats its measured code while
+/// state.KeepRunning() returns true; the number of iterations grows until
+/// the loop has run for the minimum time. Results are printed as a table,
+/// or as JSON (--json) for regression tracking.
+/// </summary>
+class Benchmark {
+public:
+    class State {
+    public:
+        State(double minTime);
+
+        /// <summary>
+        /// Returns true while the measured code should run again.
+        /// </summary>
+        bool KeepRunning();
+
+        /// <summary>
+        /// Sets the number of bytes processed by each iteration; the
+        /// throughput is reported in MB/s.
+        /// </summary>
+        void Bytes(unsigned long long bytes);
+
+        /// <summary>
+        /// Sets the number of items (files, draws, events) processed by each
+        /// iteration; the time per item is reported.
+        /// </summary>
+        void Items(unsigned long long items);
+
+        /// <summary>
+        /// Reports a value measured by the benchmark, such as a redraw count
+        /// or memory size, alongside the timing.
+        /// </summary>
+        void Counter(const std::string &name, double value);
+
+        /// <summary>
+        /// Marks the benchmark as skipped (missing fixture files, for
+        /// instance). KeepRunning() returns false afterward.
+        /// </summary>
+        void Skip(const std::string &reason);
+
+    private:
+        friend class Benchmark;
+        typedef std::chrono::steady_clock Clock;
+
+        double _minTime;
+        Clock::time_point _start;
+        double _elapsed;
+        unsigned long long _iterations;
+        unsigned long long _batch;
+        unsigned long long _remaining;
+        unsigned long long _bytes;
+        unsigned long long _items;
+        std::vector<std::pair<std::string, double>> _counters;
+        std::string _skipped;
+    };
+
+    typedef void (*Function)(State &state);
+
+    /// <summary>Registers a benchmark; used by the BENCHMARK() macro.</summary>
+    Benchmark(const char *name, Function function);
+
+    /// <summary>
+    /// Runs the benchmarks. Options: --filter (substring of the benchmark
+    /// names), --min-time (seconds per benchmark), --source (directory
+    /// containing Skins and Languages), and --json.
+    /// </summary>
+    static int Main(int argc, char *argv[]);
+
+    /// <summary>
+    /// Directory of the source tree, which holds the fixture files.
+    /// </summary>
+    static const std::string &SourceDir();
+
+    /// <summary>
+    /// Reads an entire file. Returns false if it can't be read.
+    /// </summary>
+    static bool ReadFile(const std::string &path, std::string &contents);
+
+    /// <summary>
+    /// Prevents the compiler from discarding a value computed by the
+    /// measured code.
+    /// </summary>
+    template <typename T>
+    static void DoNotOptimize(const T &value) {
+#ifdef __GNUC__
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        _sink = &value;
+#endif
+    }
+
+private:
+    struct Case {
+        const char *name;
+        Function function;
+    };
+
+    static std::vector<Case> &Cases();
+    static std::string _sourceDir;
+    static const void *volatile _sink;
+};
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Fixtures.h"
+
+#include <algorithm>
+
+#include "../SkinLint/FileSystem.h"
+#include "Benchmark.h"
+
+std::vector<std::string> Fixtures::SkinDirs() {
+    std::string skins = FileSystem::Resolve(Benchmark::SourceDir(), "Skins");
+    std::vector<FileSystem::Entry> entries;
+    FileSystem::List(skins, entries);
+
+    std::vector<std::string> dirs;
+    for (const FileSystem::Entry &entry : entries) {
+        std::string dir = FileSystem::Resolve(skins, entry.name);
+        if (entry.directory
+                && FileSystem::IsFile(FileSystem::Resolve(dir, "skin.xml"))) {
+            dirs.push_back(dir);
+        }
+    }
+
+    /* Directory order varies between file systems */
+    std::sort(dirs.begin(), dirs.end());
+    return dirs;
+}
+
+std::vector<std::string> Fixtures::SkinFiles() {
+    std::vector<std::string> files;
+    for (const std::string &dir : SkinDirs()) {
+        files.push_back(FileSystem::Resolve(dir, "skin.xml"));
+    }
+    return files;
+}
+
+std::vector<std::string> Fixtures::LanguageFiles() {
+    std::string languages = FileSystem::Resolve(
+        Benchmark::SourceDir(), "Languages");
+    std::vector<FileSystem::Entry> entries;
+    FileSystem::List(languages, entries);
+
+    std::vector<std::string> files;
+    for (const FileSystem::Entry &entry : entries) {
+        const std::string &name = entry.name;
+        if (entry.directory == false && name.size() > 4
+                && name.compare(name.size() - 4, 4, ".xml") == 0) {
+            files.push_back(FileSystem::Resolve(languages, name));
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+unsigned long long Fixtures::Read(const std::vector<std::string> &paths,
+        std::vector<std::string> &contents) {
+
+    unsigned long long bytes = 0;
+    contents.clear();
+    for (const std::string &path : paths) {
+        std::string data;
+        if (Benchmark::ReadFile(path, data)) {
+            bytes += data.size();
+            contents.push_back(data);
+        }
+    }
+    return bytes;
+}
\ No newline at end of file
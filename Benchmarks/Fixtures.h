@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Locates the files the benchmarks run over: the bundled skins and
+/// language files in the source tree (see Benchmark::SourceDir()).
+/// </summary>
+class Fixtures {
+public:
+    /// <summary>Directories in Skins/ that contain a skin.xml.</summary>
+    static std::vector<std::string> SkinDirs();
+
+    /// <summary>Paths of the skin.xml files in Skins/.</summary>
+    static std::vector<std::string> SkinFiles();
+
+    /// <summary>Paths of the .xml files in Languages/.</summary>
+    static std::vector<std::string> LanguageFiles();
+
+    /// <summary>
+    /// Reads each file into 'contents' and returns the total size in bytes.
+    /// Files that can't be read are left out.
+    /// </summary>
+    static unsigned long long Read(const std::vector<std::string> &paths,
+        std::vector<std::string> &contents);
+};
\ No newline at end of file
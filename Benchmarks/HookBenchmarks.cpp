@@ -0,0 +1,215 @@
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HookLatency.h"
+#include "HotkeyMatcher.h"
+#include "HotkeyProfiles.h"
+
+namespace {
+
+/* Windows values, which the matcher doesn't depend on */
+const int ModWin = 0x8 << MOD_OFFSET;
+const unsigned int VkLWin = 0x5B;
+const unsigned int VkUp = 0x26;
+const unsigned int VkV = 0x56;
+const unsigned int VkM = 0x4D;
+
+struct Event {
+    bool down;
+    unsigned int vk;
+    int modifier;
+    unsigned int time;
+};
+
+void Press(std::vector<Event> &events, unsigned int vk, int modifier,
+        unsigned int &time) {
+
+    Event down = { true, vk, modifier, time };
+    Event up = { false, vk, modifier, time + 30 };
+    events.push_back(down);
+    events.push_back(up);
+    time += 60;
+}
+
+void PressWithWin(std::vector<Event> &events, unsigned int vk,
+        unsigned int &time) {
+
+    Event win = { true, VkLWin, ModWin, time };
+    events.push_back(win);
+    time += 20;
+    Press(events, vk, 0, time);
+    Event winUp = { false, VkLWin, ModWin, time };
+    events.push_back(winUp);
+    time += 20;
+}
+
+/// <summary>
+/// Builds a synthetic stream of keyboard events: typing, interleaved with a
+/// hotkey and a two-step sequence every 'interval' keys (0 for none).
+/// </summary>
+std::vector<Event> Stream(int keys, int interval) {
+    std::vector<Event> events;
+    unsigned int time = 0;
+    for (int i = 0; i < keys; ++i) {
+        Press(events, 'A' + i % 26, 0, time);
+        if (interval > 0 && i % interval == interval - 1) {
+            PressWithWin(events, VkM, time);
+            PressWithWin(events, VkV, time);
+            Press(events, VkUp, 0, time);
+        }
+    }
+    return events;
+}
+
+/// <summary>
+/// Runs the events through the matcher the way the keyboard hook does,
+/// timing each one and recording it in the latency histogram.
+/// </summary>
+int Dispatch(HotkeyMatcher &matcher, HookLatency &latency,
+        const std::vector<Event> &events) {
+
+    typedef std::chrono::steady_clock Clock;
+    int fired = 0;
+    for (const Event &e : events) {
+        Clock::time_point start = Clock::now();
+        int binding = e.down
+            ? matcher.KeyDown(e.vk, false, e.modifier, e.time)
+            : matcher.KeyUp(e.vk, e.modifier, e.time);
+        if (binding > 0) {
+            fired++;
+        }
+        latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start).count());
+    }
+    return fired;
+}
+
+void Bind(HotkeyMatcher &matcher) {
+    std::vector<int> sequence;
+    sequence.push_back(ModWin | VkV);
+    sequence.push_back(VkUp);
+    matcher.Add(ModWin | VkM);
+    matcher.Add(sequence, 0x1000001);
+}
+
+/// <summary>Registers hotkeys with the matcher as HotkeyManager does.</summary>
+void Bind(HotkeyMatcher &matcher, const std::vector<HotkeyInfo> &hotkeys) {
+    int nextSequence = 0x1000000;
+    for (HotkeyInfo hki : hotkeys) {
+        if (hki.IsSequence()) {
+            matcher.Add(hki.Steps(), ++nextSequence, hki.holdTime);
+        } else {
+            matcher.Add(hki.keyCombination);
+        }
+    }
+}
+
+void Run(Benchmark::State &state, HotkeyMatcher &matcher, int interval) {
+    std::vector<Event> events = Stream(1000, interval);
+    HookLatency latency;
+
+    int fired = 0;
+    while (state.KeepRunning()) {
+        fired = Dispatch(matcher, latency, events);
+    }
+    state.Items(events.size());
+    state.Counter("fired", fired);
+    state.Counter("p99_us", (double) latency.Percentile(0.99));
+    state.Counter("over_budget", latency.Exceeded());
+}
+
+/// <summary>Two programs, each in the foreground in turn.</summary>
+class FakeProcessSource : public ProcessSource {
+public:
+    virtual unsigned long ProcessId(void *window) {
+        return (unsigned long) (size_t) window;
+    }
+
+    virtual std::wstring ProcessPath(unsigned long pid) {
+        return (pid == 1) ? L"C:\\VLC\\vlc.exe" : L"C:\\explorer.exe";
+    }
+};
+
+HotkeyInfo Hotkey(int keys, int action) {
+    HotkeyInfo hki;
+    hki.keyCombination = keys;
+    hki.action = action;
+    return hki;
+}
+
+/// <summary>
+/// Global hotkeys matching Bind(), and a profile that overrides one and
+/// disables the other.
+/// </summary>
+void LoadProfiles(HotkeyProfiles &profiles) {
+    std::vector<HotkeyInfo> global;
+    global.push_back(Hotkey(ModWin | VkM, HotkeyInfo::Mute));
+    HotkeyInfo sequence = Hotkey(ModWin | VkV, HotkeyInfo::VolumeSlider);
+    sequence.sequence.push_back(VkUp);
+    global.push_back(sequence);
+
+    HotkeyProfile vlc;
+    vlc.process = L"vlc.exe";
+    vlc.hotkeys.push_back(Hotkey(ModWin | VkM, HotkeyInfo::MediaKey));
+    vlc.disabled.push_back(sequence);
+
+    profiles.Load(global, std::vector<HotkeyProfile>(1, vlc));
+}
+
+}
+
+/// <summary>
+/// Keyboard hook path for typing that matches no binding, which is what
+/// the hook sees almost all of the time.
+/// </summary>
+BENCHMARK(HookTyping) {
+    HotkeyMatcher matcher;
+    Bind(matcher);
+    Run(state, matcher, 0);
+}
+
+/// <summary>
+/// Keyboard hook path with a hotkey and a sequence completed every ten
+/// keys.
+/// </summary>
+BENCHMARK(HookHotkeys) {
+    HotkeyMatcher matcher;
+    Bind(matcher);
+    Run(state, matcher, 10);
+}
+
+/// <summary>
+/// HookTyping with the hotkeys of a per-program profile in effect. Profiles
+/// are resolved on foreground changes, so the hook does the same work.
+/// </summary>
+BENCHMARK(HookTypingProfile) {
+    FakeProcessSource source;
+    HotkeyProfiles profiles(&source);
+    LoadProfiles(profiles);
+    profiles.Foreground((void *) 1);
+
+    HotkeyMatcher matcher;
+    Bind(matcher, profiles.Active());
+    Run(state, matcher, 0);
+}
+
+/// <summary>
+/// Switching between two (cached) foreground windows with different
+/// profiles.
+/// </summary>
+BENCHMARK(ProfileForeground) {
+    FakeProcessSource source;
+    HotkeyProfiles profiles(&source);
+    LoadProfiles(profiles);
+
+    int switches = 0;
+    while (state.KeepRunning()) {
+        switches += profiles.Foreground((void *) 1);
+        switches += profiles.Foreground((void *) 2);
+    }
+    state.Items(2);
+    Benchmark::DoNotOptimize(switches);
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HotkeyAction.h"
+#include "HotkeyInfo.h"
+
+namespace {
+
+/* Volume units in the default skin */
+const int Units = 20;
+
+/// <summary>A hotkey of each kind that takes arguments.</summary>
+std::vector<HotkeyInfo> Hotkeys() {
+    struct Definition {
+        int action;
+        const wchar_t *arg0;
+        const wchar_t *arg1;
+    };
+    const Definition definitions[] = {
+        { HotkeyInfo::IncreaseVolume, L"2", L"0" },
+        { HotkeyInfo::DecreaseVolume, L"5", L"1" },
+        { HotkeyInfo::SetVolume, L"50", L"1" },
+        { HotkeyInfo::MediaKey, L"Previous", NULL },
+        { HotkeyInfo::VirtualKey, L"AD", NULL },
+        { HotkeyInfo::EjectDrive, L"e", NULL },
+        { HotkeyInfo::Mute, NULL, NULL },
+    };
+
+    std::vector<HotkeyInfo> hotkeys;
+    int combination = 0x80041;
+    for (const Definition &d : definitions) {
+        HotkeyInfo hki;
+        hki.keyCombination = combination++;
+        hki.action = d.action;
+        if (d.arg0 != NULL) {
+            hki.args.push_back(d.arg0);
+        }
+        if (d.arg1 != NULL) {
+            hki.args.push_back(d.arg1);
+        }
+        hotkeys.push_back(hki);
+    }
+    return hotkeys;
+}
+
+/// <summary>
+/// Resolves what a hotkey does from its string arguments, as dispatch did
+/// before hotkeys were compiled.
+/// </summary>
+float Parsed(HotkeyInfo &hki) {
+    switch (hki.action) {
+    case HotkeyInfo::IncreaseVolume:
+    case HotkeyInfo::DecreaseVolume:
+    case HotkeyInfo::SetVolume: {
+        float sign = (hki.action == HotkeyInfo::DecreaseVolume) ? -1.0f : 1;
+        if (HotkeyInfo::VolumeArgType(hki) == HotkeyInfo::Percentage) {
+            return sign * (float) hki.ArgToDouble(0) / 100.0f;
+        }
+        return sign * hki.ArgToInt(0) / (float) Units;
+    }
+
+    case HotkeyInfo::MediaKey:
+        for (unsigned int i = 0; i < HotkeyInfo::MediaKeyNames.size(); ++i) {
+            if (HotkeyInfo::MediaKeyNames[i] == hki.args[0]) {
+                return HotkeyInfo::MediaKeyVKs[i];
+            }
+        }
+        return 0;
+
+    case HotkeyInfo::VirtualKey:
+        return (float) hki.HexArgToInt(0);
+
+    case HotkeyInfo::EjectDrive:
+        return hki.args[0][0];
+    }
+    return 0;
+}
+
+/// <summary>Resolves what a compiled hotkey does.</summary>
+float Compiled(const HotkeyAction &hka) {
+    switch (hka.action) {
+    case HotkeyInfo::IncreaseVolume:
+    case HotkeyInfo::DecreaseVolume:
+    case HotkeyInfo::SetVolume:
+        if (hka.volume.type == HotkeyInfo::Percentage) {
+            return hka.volume.amount;
+        }
+        return hka.volume.units / (float) Units;
+
+    case HotkeyInfo::MediaKey:
+    case HotkeyInfo::VirtualKey:
+        return hka.vk;
+
+    case HotkeyInfo::EjectDrive:
+        return hka.drive;
+
+    default:
+        return 0;
+    }
+}
+
+}
+
+/// <summary>
+/// Looks up each hotkey by its key combination and parses its arguments,
+/// as every press did before hotkeys were compiled.
+/// </summary>
+BENCHMARK(HotkeyDispatchParsed) {
+    std::vector<HotkeyInfo> hotkeys = Hotkeys();
+    std::unordered_map<int, HotkeyInfo> map;
+    for (HotkeyInfo &hki : hotkeys) {
+        map[hki.keyCombination] = hki;
+    }
+
+    while (state.KeepRunning()) {
+        float result = 0;
+        for (HotkeyInfo &hki : hotkeys) {
+            result += Parsed(map.find(hki.keyCombination)->second);
+        }
+        Benchmark::DoNotOptimize(result);
+    }
+    state.Items(hotkeys.size());
+}
+
+/// <summary>
+/// Looks up each hotkey and reads its compiled action, as each press does
+/// now.
+/// </summary>
+BENCHMARK(HotkeyDispatchCompiled) {
+    std::vector<HotkeyInfo> hotkeys = Hotkeys();
+    std::unordered_map<int, HotkeyAction> map;
+    for (HotkeyInfo &hki : hotkeys) {
+        map[hki.keyCombination] = HotkeyAction(hki);
+    }
+
+    while (state.KeepRunning()) {
+        float result = 0;
+        for (HotkeyInfo &hki : hotkeys) {
+            result += Compiled(map.find(hki.keyCombination)->second);
+        }
+        Benchmark::DoNotOptimize(result);
+    }
+    state.Items(hotkeys.size());
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Fixtures.h"
+#include "StringUtils.h"
+#include "TinyXml2/tinyxml2.h"
+#include "TranslationTable.h"
+#include "XMLReader.h"
+
+namespace {
+
+typedef std::vector<std::pair<std::wstring, std::wstring>> Strings;
+
+/// <summary>
+/// Reads the original and translated strings from every language file, as
+/// LanguageTranslator::LoadTranslations() does.
+/// </summary>
+std::vector<Strings> Translations() {
+    std::vector<std::string> files;
+    Fixtures::Read(Fixtures::LanguageFiles(), files);
+
+    std::vector<Strings> languages;
+    XMLReader reader;
+    for (const std::string &xml : files) {
+        Strings strings;
+        reader.Load(xml.c_str(), xml.size());
+        XMLReader::Event e;
+        while ((e = reader.Next()) != XMLReader::End
+                && e != XMLReader::Error) {
+            if (e != XMLReader::StartElement
+                    || reader.IsElement("string") == false) {
+                continue;
+            }
+
+            const char *original = NULL;
+            const char *translation = NULL;
+            while ((e = reader.Next()) == XMLReader::StartElement
+                    || e == XMLReader::Text) {
+                if (e == XMLReader::Text) {
+                    continue;
+                }
+                if (reader.IsElement("original")) {
+                    original = reader.ElementText();
+                } else if (reader.IsElement("translation")) {
+                    translation = reader.ElementText();
+                } else {
+                    reader.Skip();
+                }
+            }
+
+            if (original && translation) {
+                strings.push_back(std::make_pair(
+                    StringUtils::Widen(original),
+                    StringUtils::Widen(translation)));
+            }
+        }
+        languages.push_back(strings);
+    }
+    return languages;
+}
+
+/// <summary>
+/// Strings the settings application translates that aren't in any language
+/// file, so lookups miss as well as hit.
+/// </summary>
+const wchar_t *Misses[] = {
+    L"Hide Animation:", L"Skin Author:", L"Show notification icon",
+    L"Monitor:", L"Position:", L"Custom position",
+};
+const size_t MissCount = sizeof(Misses) / sizeof(*Misses);
+
+}
+
+/// <summary>Parses every language file into a tinyxml2 DOM.</summary>
+BENCHMARK(LanguageXMLDOM) {
+    std::vector<std::string> files;
+    unsigned long long bytes = Fixtures::Read(
+        Fixtures::LanguageFiles(), files);
+    if (files.empty()) {
+        state.Skip("no languages in " + Benchmark::SourceDir());
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        for (const std::string &xml : files) {
+            tinyxml2::XMLDocument doc;
+            doc.Parse(xml.c_str(), xml.size());
+            Benchmark::DoNotOptimize(doc.RootElement());
+        }
+    }
+    state.Bytes(bytes);
+    state.Items(files.size());
+}
+
+/// <summary>Reads every language file with the streaming XMLReader.</summary>
+BENCHMARK(LanguageXMLReader) {
+    std::vector<std::string> files;
+    unsigned long long bytes = Fixtures::Read(
+        Fixtures::LanguageFiles(), files);
+    if (files.empty()) {
+        state.Skip("no languages in " + Benchmark::SourceDir());
+        return;
+    }
+
+    XMLReader reader;
+    int elements = 0;
+    while (state.KeepRunning()) {
+        elements = 0;
+        for (const std::string &xml : files) {
+            reader.Load(xml.c_str(), xml.size());
+            XMLReader::Event event;
+            while ((event = reader.Next()) != XMLReader::End
+                    && event != XMLReader::Error) {
+                if (event == XMLReader::StartElement) {
+                    elements++;
+                }
+            }
+        }
+    }
+    state.Bytes(bytes);
+    state.Items(files.size());
+    state.Counter("elements", elements);
+}
+
+/// <summary>
+/// Builds a TranslationTable for every language file and looks up each of
+/// its strings, plus some that aren't translated.
+/// </summary>
+BENCHMARK(TranslationTableLookup) {
+    std::vector<Strings> languages = Translations();
+    if (languages.empty()) {
+        state.Skip("no languages in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<TranslationTable> tables(languages.size());
+    unsigned long long lookups = 0;
+    for (unsigned int i = 0; i < languages.size(); ++i) {
+        for (auto &string : languages[i]) {
+            tables[i].Add(string.first, string.second);
+        }
+        lookups += languages[i].size() + MissCount;
+    }
+
+    std::vector<std::wstring> misses(Misses, Misses + MissCount);
+    int found = 0;
+    while (state.KeepRunning()) {
+        found = 0;
+        for (unsigned int i = 0; i < languages.size(); ++i) {
+            for (auto &string : languages[i]) {
+                found += (tables[i].Find(string.first)
+                    != TranslationTable::NotFound);
+            }
+            for (const std::wstring &miss : misses) {
+                found += (tables[i].Find(miss)
+                    != TranslationTable::NotFound);
+            }
+        }
+        Benchmark::DoNotOptimize(found);
+    }
+    state.Items(lookups);
+    state.Counter("found", found);
+}
+
+/// <summary>
+/// Makes the same lookups in a std::unordered_map, as translations were
+/// stored before.
+/// </summary>
+BENCHMARK(TranslationMapLookup) {
+    typedef std::unordered_map<std::wstring, std::wstring> Map;
+
+    std::vector<Strings> languages = Translations();
+    if (languages.empty()) {
+        state.Skip("no languages in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<Map> maps(languages.size());
+    unsigned long long lookups = 0;
+    for (unsigned int i = 0; i < languages.size(); ++i) {
+        for (auto &string : languages[i]) {
+            maps[i].insert(string);
+        }
+        lookups += languages[i].size() + MissCount;
+    }
+
+    std::vector<std::wstring> misses(Misses, Misses + MissCount);
+    int found = 0;
+    while (state.KeepRunning()) {
+        found = 0;
+        for (unsigned int i = 0; i < languages.size(); ++i) {
+            for (auto &string : languages[i]) {
+                found += (maps[i].find(string.first) != maps[i].end());
+            }
+            for (const std::wstring &miss : misses) {
+                found += (maps[i].find(miss) != maps[i].end());
+            }
+        }
+        Benchmark::DoNotOptimize(found);
+    }
+    state.Items(lookups);
+    state.Counter("found", found);
+}
+
+/// <summary>Builds a TranslationTable from each language file.</summary>
+BENCHMARK(TranslationTableBuild) {
+    std::vector<Strings> languages = Translations();
+    if (languages.empty()) {
+        state.Skip("no languages in " + Benchmark::SourceDir());
+        return;
+    }
+
+    unsigned long long strings = 0;
+    for (const Strings &language : languages) {
+        strings += language.size();
+    }
+
+    while (state.KeepRunning()) {
+        for (const Strings &language : languages) {
+            TranslationTable table;
+            for (auto &string : language) {
+                table.Add(string.first, string.second);
+            }
+            Benchmark::DoNotOptimize(table.Size());
+        }
+    }
+    state.Items(strings);
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <cwctype>
+#include <string>
+
+#include "Benchmark.h"
+#include "SettingsValues.h"
+#include "StringUtils.h"
+#include "TinyXml2/tinyxml2.h"
+
+namespace {
+
+const char *File =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<settings>\n"
+    "    <audioDeviceID>{0.0.0.00000000}.{5d1c4a7e}</audioDeviceID>\n"
+    "    <skin>Ignition</skin>\n"
+    "    <language>English</language>\n"
+    "    <onTop>true</onTop>\n"
+    "    <hideFullscreen>false</hideFullscreen>\n"
+    "    <hideAnimation>Fade</hideAnimation>\n"
+    "    <hideDelay>800</hideDelay>\n"
+    "    <hideSpeed>765</hideSpeed>\n"
+    "    <osdPosition>Bottom-right</osdPosition>\n"
+    "    <osdEdgeOffset>140</osdEdgeOffset>\n"
+    "    <hotkeys>\n"
+    "        <hotkey combination=\"65601\" action=\"Mute\"/>\n"
+    "        <hotkey combination=\"65602\" action=\"Show Settings\"/>\n"
+    "    </hotkeys>\n"
+    "</settings>\n";
+
+int DOMInt(const tinyxml2::XMLElement *root, const char *name, int def) {
+    const tinyxml2::XMLElement *el = root->FirstChildElement(name);
+    int val = def;
+    if (el != NULL) {
+        el->QueryIntText(&val);
+    }
+    return val;
+}
+
+bool DOMEnabled(const tinyxml2::XMLElement *root, const char *name,
+        bool def) {
+
+    const tinyxml2::XMLElement *el = root->FirstChildElement(name);
+    bool val = def;
+    if (el != NULL) {
+        el->QueryBoolText(&val);
+    }
+    return val;
+}
+
+int DOMIndex(const tinyxml2::XMLElement *root, const char *name,
+        const std::vector<std::wstring> &names, int def) {
+
+    const tinyxml2::XMLElement *el = root->FirstChildElement(name);
+    if (el == NULL || el->GetText() == NULL) {
+        return def;
+    }
+
+    std::wstring text = StringUtils::Widen(el->GetText());
+    for (unsigned int i = 0; i < names.size(); ++i) {
+        if (names[i].size() != text.size()) {
+            continue;
+        }
+        size_t c = 0;
+        while (c < text.size() && towlower(text[c]) == towlower(names[i][c])) {
+            ++c;
+        }
+        if (c == text.size()) {
+            return i;
+        }
+    }
+    return def;
+}
+
+}
+
+/// <summary>
+/// Reads the settings an OSD uses each time it is shown by searching the DOM
+/// and converting the text, as the getters did before the settings were
+/// deserialized.
+/// </summary>
+BENCHMARK(SettingsGetDOM) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(File);
+    const tinyxml2::XMLElement *root = xml.FirstChildElement("settings");
+
+    while (state.KeepRunning()) {
+        int sum = 0;
+        sum += DOMInt(root, "hideDelay", 800);
+        sum += DOMInt(root, "hideSpeed", 765);
+        sum += DOMInt(root, "osdEdgeOffset", 140);
+        sum += DOMEnabled(root, "onTop", true);
+        sum += DOMEnabled(root, "hideFullscreen", false);
+        sum += DOMIndex(root, "osdPosition",
+            SettingsValues::OSDPosNames, SettingsValues::Bottom);
+        sum += DOMIndex(root, "hideAnimation",
+            AnimationTypes::HideAnimationNames, AnimationTypes::Fade);
+        Benchmark::DoNotOptimize(sum);
+    }
+    state.Items(7);
+}
+
+/// <summary>Reads the same settings from the deserialized values.</summary>
+BENCHMARK(SettingsGetTyped) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(File);
+    SettingsValues v;
+    v.Deserialize(xml.FirstChildElement("settings"));
+    const SettingsValues *values = &v;
+
+    while (state.KeepRunning()) {
+        /* Read through a pointer the optimizer can't see past, the way the
+         * getters read the Settings instance. */
+        Benchmark::DoNotOptimize(values);
+        int sum = 0;
+        sum += values->hideDelay;
+        sum += values->hideSpeed;
+        sum += values->osdEdgeOffset;
+        sum += values->onTop;
+        sum += values->hideFullscreen;
+        sum += values->osdPosition;
+        sum += values->hideAnim;
+        Benchmark::DoNotOptimize(sum);
+    }
+    state.Items(7);
+}
+
+/// <summary>
+/// Deserializes the settings and serializes them back, as each load and
+/// save does.
+/// </summary>
+BENCHMARK(SettingsRoundTrip) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(File);
+    tinyxml2::XMLElement *root = xml.FirstChildElement("settings");
+    SettingsValues v;
+
+    while (state.KeepRunning()) {
+        v.Deserialize(root);
+        v.Serialize(root);
+        Benchmark::DoNotOptimize(v.hideDelay);
+    }
+    state.Items(1);
+}
\ No newline at end of file
@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../SkinLint/SkinCheck.h"
+#include "Benchmark.h"
+#include "ElementIndex.h"
+#include "Fixtures.h"
+#include "MeterWnd/ArcRasterizer.h"
+#include "MeterWnd/MeterLayout.h"
+#include "TinyXml2/tinyxml2.h"
+#include "XMLReader.h"
+
+namespace {
+
+/* Steps in the 0 - 1 meter sweep; matches SkinCheck */
+const int SweepSteps = 1000;
+
+/* OSD and slider lookups made when a Skin is loaded */
+const char *OSDLookups[] = {
+    "volume", "volume", "volume", "volume", "volume", "volume",
+    "mute", "mute",
+    "eject", "eject",
+};
+const char *SliderLookups[] = {
+    "volume", "volume", "volume", "volume",
+};
+
+/// <summary>
+/// Computes the layout of a bitmap meter at one value the way its Draw()
+/// does, returning a value that depends on the result.
+/// </summary>
+int Layout(const SkinCheck::MeterCost &m, float value) {
+    MeterLayout::Rect image = { m.x, m.y, m.imageWidth, m.imageHeight };
+    int units = MeterLayout::Units(value, m.units);
+    if (m.type == "numberstrip") {
+        MeterLayout::Blit blits[MeterLayout::MaxDigits];
+        int count = MeterLayout::NumberStrip(
+            image, m.units, units, MeterLayout::Near, blits);
+        return count + blits[0].src.y;
+    } else if (m.type == "horizontaltile") {
+        return MeterLayout::HorizontalTile(
+            image, m.units, units, m.inverted).width;
+    } else if (m.type == "bitstrip") {
+        return MeterLayout::Bitstrip(image, m.units, units).src.y;
+    } else if (m.type == "verticalbar") {
+        if (m.smooth) {
+            return MeterLayout::SmoothVerticalBar(image, value).coverage;
+        }
+        return MeterLayout::VerticalBar(image, m.units, units).src.height;
+    } else if (m.type == "horizontalbar") {
+        if (m.smooth) {
+            return MeterLayout::SmoothHorizontalBar(image, value).coverage;
+        }
+        return MeterLayout::HorizontalBar(
+            image, m.units, units, m.inverted).src.width;
+    }
+    return units;
+}
+
+/// <summary>
+/// Retrieves the meters of every bundled skin, as estimated by SkinCheck.
+/// </summary>
+std::vector<SkinCheck::MeterCost> Meters() {
+    std::vector<SkinCheck::MeterCost> meters;
+    for (const std::string &dir : Fixtures::SkinDirs()) {
+        SkinCheck check(dir);
+        check.Run();
+        for (const SkinCheck::Cost &cost : check.Costs()) {
+            meters.insert(meters.end(),
+                cost.meters.begin(), cost.meters.end());
+        }
+    }
+    return meters;
+}
+
+/// <summary>Retrieves the number strips of every bundled skin.</summary>
+std::vector<SkinCheck::MeterCost> NumberStrips() {
+    std::vector<SkinCheck::MeterCost> strips;
+    for (const SkinCheck::MeterCost &m : Meters()) {
+        if (m.type == "numberstrip" && m.imageHeight >= 10) {
+            strips.push_back(m);
+        }
+    }
+    return strips;
+}
+
+/// <summary>The digits drawn for one unit value.</summary>
+struct DigitLayout {
+    int count;
+    MeterLayout::Blit blits[MeterLayout::MaxDigits];
+};
+
+/// <summary>
+/// Retrieves the alignment of a number strip as Skin::Alignment() reads it
+/// (left by default).
+/// </summary>
+MeterLayout::Alignment Alignment(const SkinCheck::MeterCost &m) {
+    if (m.align == "center") {
+        return MeterLayout::Center;
+    } else if (m.align == "right") {
+        return MeterLayout::Far;
+    }
+    return MeterLayout::Near;
+}
+
+/// <summary>
+/// Builds the digit layouts for every unit value of a number strip, as the
+/// NumberStrip constructor does.
+/// </summary>
+std::vector<DigitLayout> DigitLayouts(const SkinCheck::MeterCost &m) {
+    MeterLayout::Rect image = { 0, 0, m.imageWidth, m.imageHeight };
+    std::vector<DigitLayout> layouts(m.units + 1);
+    for (int units = 0; units <= m.units; ++units) {
+        layouts[units].count = MeterLayout::NumberStrip(
+            image, m.units, units, Alignment(m), layouts[units].blits);
+    }
+    return layouts;
+}
+
+/// <summary>
+/// Copies a blit from a digit strip to a buffer three digits wide, as
+/// Graphics::DrawImage() does for each digit.
+/// </summary>
+void Copy(const MeterLayout::Blit &blit, const std::vector<unsigned int> &src,
+        int srcWidth, std::vector<unsigned int> &dest, int destWidth) {
+
+    for (int y = 0; y < blit.src.height; ++y) {
+        const unsigned int *from = &src[(blit.src.y + y) * srcWidth
+            + blit.src.x];
+        unsigned int *to = &dest[(blit.dest.y + y) * destWidth
+            + blit.dest.x];
+        std::copy(from, from + blit.src.width, to);
+    }
+}
+
+/// <summary>Retrieves the bitstrip meters of every bundled skin.</summary>
+std::vector<SkinCheck::MeterCost> Bitstrips() {
+    std::vector<SkinCheck::MeterCost> bitstrips;
+    for (const SkinCheck::MeterCost &m : Meters()) {
+        if (m.type == "bitstrip" && m.imageHeight >= m.units) {
+            bitstrips.push_back(m);
+        }
+    }
+    return bitstrips;
+}
+
+}
+
+/// <summary>
+/// Loads and checks every bundled skin without rendering: parses skin.xml,
+/// reads each image header, and computes the meter costs.
+/// </summary>
+BENCHMARK(SkinLoad) {
+    std::vector<std::string> dirs = Fixtures::SkinDirs();
+    if (dirs.empty()) {
+        state.Skip("no skins in " + Benchmark::SourceDir());
+        return;
+    }
+
+    int errors = 0;
+    while (state.KeepRunning()) {
+        errors = 0;
+        for (const std::string &dir : dirs) {
+            SkinCheck check(dir);
+            check.Run();
+            errors += check.Errors();
+        }
+    }
+    state.Items(dirs.size());
+    state.Counter("skins", (double) dirs.size());
+    state.Counter("errors", errors);
+}
+
+/// <summary>
+/// Sweeps every meter of every bundled skin from 0 to 1, computing the
+/// layout at each step and counting the steps that change what is drawn.
+/// </summary>
+BENCHMARK(MeterSweep) {
+    std::vector<SkinCheck::MeterCost> meters = Meters();
+    if (meters.empty()) {
+        state.Skip("no meters in " + Benchmark::SourceDir());
+        return;
+    }
+
+    int redraws = 0;
+    while (state.KeepRunning()) {
+        redraws = 0;
+        for (const SkinCheck::MeterCost &m : meters) {
+            int drawn = -1;
+            for (int i = 0; i <= SweepSteps; ++i) {
+                float value = (float) i / SweepSteps;
+                int length = (m.type == "verticalbar")
+                    ? m.imageHeight : m.imageWidth;
+                int current = m.smooth
+                    ? MeterLayout::SmoothState(value, length)
+                    : MeterLayout::Units(value, m.units);
+                if (current != drawn) {
+                    Benchmark::DoNotOptimize(Layout(m, value));
+                    redraws++;
+                    drawn = current;
+                }
+            }
+        }
+    }
+    state.Items(meters.size() * (SweepSteps + 1));
+    state.Counter("meters", (double) meters.size());
+    state.Counter("redraws", redraws);
+}
+
+/// <summary>
+/// Indexes the OSD and slider elements of every skin.xml by std::string and
+/// looks them up as the Skin constructor does, which builds a temporary key
+/// for each lookup. This is how the elements were indexed before.
+/// </summary>
+BENCHMARK(SkinElementsHashed) {
+    typedef std::unordered_map<std::string, tinyxml2::XMLElement *> Index;
+
+    std::vector<std::string> files;
+    Fixtures::Read(Fixtures::SkinFiles(), files);
+    if (files.empty()) {
+        state.Skip("no skins in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<tinyxml2::XMLDocument *> docs;
+    for (const std::string &xml : files) {
+        docs.push_back(new tinyxml2::XMLDocument());
+        docs.back()->Parse(xml.c_str(), xml.size());
+    }
+
+    while (state.KeepRunning()) {
+        for (tinyxml2::XMLDocument *doc : docs) {
+            tinyxml2::XMLElement *root = doc->FirstChildElement("skin");
+            Index indexes[2];
+            const char *parents[] = { "osds", "sliders" };
+            for (int i = 0; i < 2; ++i) {
+                tinyxml2::XMLElement *parent = (root == NULL)
+                    ? NULL : root->FirstChildElement(parents[i]);
+                tinyxml2::XMLElement *elem = (parent == NULL)
+                    ? NULL : parent->FirstChildElement();
+                for (; elem != NULL; elem = elem->NextSiblingElement()) {
+                    indexes[i].insert(std::make_pair(elem->Name(), elem));
+                }
+            }
+
+            for (const char *name : OSDLookups) {
+                auto it = indexes[0].find(name);
+                Benchmark::DoNotOptimize(it == indexes[0].end());
+            }
+            for (const char *name : SliderLookups) {
+                auto it = indexes[1].find(name);
+                Benchmark::DoNotOptimize(it == indexes[1].end());
+            }
+        }
+    }
+    state.Items(docs.size());
+
+    for (tinyxml2::XMLDocument *doc : docs) {
+        delete doc;
+    }
+}
+
+/// <summary>
+/// Indexes and looks up the same elements with ElementIndex, as the Skin
+/// constructor does now.
+/// </summary>
+BENCHMARK(SkinElementsIndexed) {
+    std::vector<std::string> files;
+    Fixtures::Read(Fixtures::SkinFiles(), files);
+    if (files.empty()) {
+        state.Skip("no skins in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<tinyxml2::XMLDocument *> docs;
+    for (const std::string &xml : files) {
+        docs.push_back(new tinyxml2::XMLDocument());
+        docs.back()->Parse(xml.c_str(), xml.size());
+    }
+
+    while (state.KeepRunning()) {
+        for (tinyxml2::XMLDocument *doc : docs) {
+            tinyxml2::XMLElement *root = doc->FirstChildElement("skin");
+            ElementIndex osds;
+            ElementIndex sliders;
+            if (root != NULL) {
+                osds.Build(root->FirstChildElement("osds"));
+                sliders.Build(root->FirstChildElement("sliders"));
+            }
+
+            for (const char *name : OSDLookups) {
+                Benchmark::DoNotOptimize(osds.Find(name));
+            }
+            for (const char *name : SliderLookups) {
+                Benchmark::DoNotOptimize(sliders.Find(name));
+            }
+        }
+    }
+    state.Items(docs.size());
+
+    for (tinyxml2::XMLDocument *doc : docs) {
+        delete doc;
+    }
+}
+
+/// <summary>Parses every skin.xml into a tinyxml2 DOM.</summary>
+BENCHMARK(SkinXMLDOM) {
+    std::vector<std::string> files;
+    unsigned long long bytes = Fixtures::Read(Fixtures::SkinFiles(), files);
+    if (files.empty()) {
+        state.Skip("no skins in " + Benchmark::SourceDir());
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        for (const std::string &xml : files) {
+            tinyxml2::XMLDocument doc;
+            doc.Parse(xml.c_str(), xml.size());
+            Benchmark::DoNotOptimize(doc.RootElement());
+        }
+    }
+    state.Bytes(bytes);
+    state.Items(files.size());
+}
+
+/// <summary>Reads every skin.xml with the streaming XMLReader.</summary>
+BENCHMARK(SkinXMLReader) {
+    std::vector<std::string> files;
+    unsigned long long bytes = Fixtures::Read(Fixtures::SkinFiles(), files);
+    if (files.empty()) {
+        state.Skip("no skins in " + Benchmark::SourceDir());
+        return;
+    }
+
+    XMLReader reader;
+    int elements = 0;
+    while (state.KeepRunning()) {
+        elements = 0;
+        for (const std::string &xml : files) {
+            reader.Load(xml.c_str(), xml.size());
+            XMLReader::Event event;
+            while ((event = reader.Next()) != XMLReader::End
+                    && event != XMLReader::Error) {
+                if (event == XMLReader::StartElement) {
+                    elements++;
+                }
+            }
+        }
+    }
+    state.Bytes(bytes);
+    state.Items(files.size());
+    state.Counter("elements", elements);
+}
+
+/// <summary>
+/// Copies each frame of every bundled bitstrip meter out of its strip, as
+/// Bitstrip::Draw() does for each unit value. The whole strip is held in
+/// memory for as long as the skin is loaded.
+/// </summary>
+BENCHMARK(BitstripFrames) {
+    std::vector<SkinCheck::MeterCost> meters = Bitstrips();
+    if (meters.empty()) {
+        state.Skip("no bitstrips in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<std::vector<unsigned int>> strips;
+    unsigned long long frames = 0;
+    unsigned long long bytes = 0;
+    for (const SkinCheck::MeterCost &m : meters) {
+        strips.push_back(std::vector<unsigned int>(
+            m.imageWidth * m.imageHeight, 0xFF808080));
+        frames += m.units;
+        bytes += strips.back().size() * 4;
+    }
+
+    std::vector<unsigned int> frame;
+    while (state.KeepRunning()) {
+        for (unsigned int i = 0; i < meters.size(); ++i) {
+            const SkinCheck::MeterCost &m = meters[i];
+            MeterLayout::Rect image = { 0, 0, m.imageWidth, m.imageHeight };
+            for (int units = 1; units <= m.units; ++units) {
+                MeterLayout::Blit blit = MeterLayout::Bitstrip(
+                    image, m.units, units);
+                frame.assign(
+                    strips[i].begin() + blit.src.y * m.imageWidth,
+                    strips[i].begin() + (blit.src.y + blit.src.height)
+                        * m.imageWidth);
+                Benchmark::DoNotOptimize(frame[0]);
+            }
+        }
+    }
+    state.Items(frames);
+    state.Counter("bytes", (double) bytes);
+}
+
+/// <summary>
+/// Rasterizes an arc for each unit value of the same meters, in a square
+/// the size of a bitstrip frame. ArcGauge keeps each frame once it has been
+/// rasterized, so this is paid once per unit value; 'bytes' is the memory
+/// held once every frame has been shown.
+/// </summary>
+BENCHMARK(ArcFrames) {
+    std::vector<SkinCheck::MeterCost> meters = Bitstrips();
+    if (meters.empty()) {
+        state.Skip("no bitstrips in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<ArcRasterizer> arcs;
+    unsigned long long frames = 0;
+    unsigned long long bytes = 0;
+    size_t largest = 0;
+    for (const SkinCheck::MeterCost &m : meters) {
+        int size = std::max(m.imageWidth, m.imageHeight / m.units);
+        arcs.push_back(ArcRasterizer(size, size / 8.0f, 225.0f, 270.0f));
+        frames += m.units;
+        bytes += (unsigned long long) size * size * 4 * m.units;
+        largest = std::max(largest, (size_t) size * size);
+    }
+
+    std::vector<unsigned char> coverage(largest);
+    while (state.KeepRunning()) {
+        for (unsigned int i = 0; i < meters.size(); ++i) {
+            int units = meters[i].units;
+            for (int u = 1; u <= units; ++u) {
+                arcs[i].Rasterize((float) u / units, &coverage[0]);
+                Benchmark::DoNotOptimize(coverage[0]);
+            }
+        }
+    }
+    state.Items(frames);
+    state.Counter("bytes", (double) bytes);
+}
+
+/// <summary>
+/// Computes the digit layout of every bundled number strip at each unit
+/// value, as NumberStrip::Draw() did on every redraw before the layouts
+/// were precomputed.
+/// </summary>
+BENCHMARK(NumberStripLayout) {
+    std::vector<SkinCheck::MeterCost> meters = NumberStrips();
+    if (meters.empty()) {
+        state.Skip("no number strips in " + Benchmark::SourceDir());
+        return;
+    }
+
+    unsigned long long draws = 0;
+    for (const SkinCheck::MeterCost &m : meters) {
+        draws += m.units + 1;
+    }
+
+    MeterLayout::Blit blits[MeterLayout::MaxDigits];
+    while (state.KeepRunning()) {
+        for (const SkinCheck::MeterCost &m : meters) {
+            MeterLayout::Rect image = { 0, 0, m.imageWidth, m.imageHeight };
+            MeterLayout::Alignment align = Alignment(m);
+            for (int units = 0; units <= m.units; ++units) {
+                int count = MeterLayout::NumberStrip(
+                    image, m.units, units, align, blits);
+                Benchmark::DoNotOptimize(blits[count - 1].dest.x);
+            }
+        }
+    }
+    state.Items(draws);
+}
+
+/// <summary>
+/// Looks up the same layouts in tables built up front, as the meter does
+/// now.
+/// </summary>
+BENCHMARK(NumberStripTable) {
+    std::vector<SkinCheck::MeterCost> meters = NumberStrips();
+    if (meters.empty()) {
+        state.Skip("no number strips in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<std::vector<DigitLayout>> tables;
+    unsigned long long draws = 0;
+    for (const SkinCheck::MeterCost &m : meters) {
+        tables.push_back(DigitLayouts(m));
+        draws += m.units + 1;
+    }
+
+    while (state.KeepRunning()) {
+        for (const std::vector<DigitLayout> &table : tables) {
+            for (unsigned int units = 0; units < table.size(); ++units) {
+                const DigitLayout *layout = &table[units];
+                Benchmark::DoNotOptimize(layout);
+                Benchmark::DoNotOptimize(
+                    layout->blits[layout->count - 1].dest.x);
+            }
+        }
+    }
+    state.Items(draws);
+}
+
+/// <summary>
+/// Draws every bundled number strip at each unit value from its table,
+/// copying the digit pixels as DrawImage() would. The copies are most of
+/// the cost of a draw, which puts the layout savings in proportion.
+/// </summary>
+BENCHMARK(NumberStripDraw) {
+    std::vector<SkinCheck::MeterCost> meters = NumberStrips();
+    if (meters.empty()) {
+        state.Skip("no number strips in " + Benchmark::SourceDir());
+        return;
+    }
+
+    std::vector<std::vector<DigitLayout>> tables;
+    std::vector<std::vector<unsigned int>> strips;
+    std::vector<std::vector<unsigned int>> buffers;
+    unsigned long long draws = 0;
+    for (const SkinCheck::MeterCost &m : meters) {
+        tables.push_back(DigitLayouts(m));
+        strips.push_back(std::vector<unsigned int>(
+            m.imageWidth * m.imageHeight, 0xFF808080));
+        buffers.push_back(std::vector<unsigned int>(
+            m.imageWidth * MeterLayout::MaxDigits * (m.imageHeight / 10)));
+        draws += m.units + 1;
+    }
+
+    while (state.KeepRunning()) {
+        for (unsigned int i = 0; i < meters.size(); ++i) {
+            int destWidth = meters[i].imageWidth * MeterLayout::MaxDigits;
+            for (const DigitLayout &layout : tables[i]) {
+                for (int d = 0; d < layout.count; ++d) {
+                    Copy(layout.blits[d], strips[i], meters[i].imageWidth,
+                        buffers[i], destWidth);
+                }
+            }
+            Benchmark::DoNotOptimize(buffers[i][0]);
+        }
+    }
+    state.Items(draws);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MeterWnd/TextLayout.h"
+
+/* GDI+ isn't available here, so these time the work each redraw does
+ * around the call that renders the text: DrawString before, glyph copies
+ * from the atlas now. */
+
+namespace {
+
+const wchar_t *Format = L"Volume: [[PERC]]%";
+
+}
+
+/// <summary>
+/// Sweeps from 0 to 100 percent, building the string for each value the way
+/// Text::Draw() did before the glyph atlas: a copy of the format string with
+/// [[PERC]] replaced.
+/// </summary>
+BENCHMARK(TextSweepFormatString) {
+    std::wstring format(Format);
+    size_t replaceIndex = format.find(L"[[PERC]]");
+
+    while (state.KeepRunning()) {
+        for (int perc = 0; perc <= 100; ++perc) {
+            std::wstring text(format);
+            text.replace(replaceIndex, 8, std::to_wstring(perc));
+            Benchmark::DoNotOptimize(text.c_str());
+        }
+    }
+    state.Items(101);
+}
+
+/// <summary>
+/// Sweeps the same values, laying out the glyphs from the atlas as
+/// Text::Draw() does now.
+/// </summary>
+BENCHMARK(TextSweepGlyphs) {
+    TextLayout layout(Format);
+    std::vector<int> glyphs(layout.MaxGlyphs());
+
+    while (state.KeepRunning()) {
+        for (int perc = 0; perc <= 100; ++perc) {
+            int count = layout.Glyphs(perc, glyphs.data());
+            Benchmark::DoNotOptimize(glyphs[count - 1]);
+        }
+    }
+    state.Items(101);
+}
+
+/// <summary>
+/// Creates the layout for a format string, as each Text meter does when a
+/// skin is loaded.
+/// </summary>
+BENCHMARK(TextLayoutCreate) {
+    while (state.KeepRunning()) {
+        TextLayout layout(Format);
+        Benchmark::DoNotOptimize(layout.Cells().size());
+    }
+    state.Items(1);
+}
\ No newline at end of file
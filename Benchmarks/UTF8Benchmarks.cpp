@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Fixtures.h"
+#include "StringUtils.h"
+#include "UTF8.h"
+
+namespace {
+
+/// <summary>
+/// Decodes a character at a time, without the ASCII fast path. Only valid
+/// UTF-8 is handled, which is all the fixtures contain.
+/// </summary>
+size_t ScalarDecode(const char *in, size_t length, wchar_t *out) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(in);
+    const unsigned char *end = p + length;
+    wchar_t *start = out;
+    while (p < end) {
+        unsigned int c = *p++;
+        int continuation = 0;
+        if (c >= 0xF0) {
+            c &= 0x07;
+            continuation = 3;
+        } else if (c >= 0xE0) {
+            c &= 0x0F;
+            continuation = 2;
+        } else if (c >= 0xC0) {
+            c &= 0x1F;
+            continuation = 1;
+        }
+        for (; continuation > 0 && p < end; --continuation) {
+            c = (c << 6) | (*p++ & 0x3F);
+        }
+
+        if (sizeof(wchar_t) == 2 && c >= 0x10000) {
+            c -= 0x10000;
+            *out++ = (wchar_t) (0xD800 + (c >> 10));
+            *out++ = (wchar_t) (0xDC00 + (c & 0x3FF));
+        } else {
+            *out++ = (wchar_t) c;
+        }
+    }
+    return out - start;
+}
+
+/// <summary>
+/// Reads the given files, or skips the benchmark if there aren't any.
+/// </summary>
+bool Load(const std::vector<std::string> &paths, Benchmark::State &state,
+        std::vector<std::string> &files, unsigned long long &bytes) {
+
+    bytes = Fixtures::Read(paths, files);
+    if (files.empty()) {
+        state.Skip("no fixtures in " + Benchmark::SourceDir());
+        return false;
+    }
+    return true;
+}
+
+/// <summary>
+/// Decodes each file into a buffer sized for the largest one.
+/// </summary>
+template <typename Decoder>
+void Decode(const std::vector<std::string> &files, Decoder decode,
+        Benchmark::State &state) {
+
+    size_t largest = 0;
+    for (const std::string &file : files) {
+        largest = std::max(largest, file.size());
+    }
+    std::vector<wchar_t> out(UTF8::MaxWideLength(largest));
+
+    size_t chars = 0;
+    while (state.KeepRunning()) {
+        chars = 0;
+        for (const std::string &file : files) {
+            chars += decode(file.c_str(), file.size(), &out[0]);
+        }
+        Benchmark::DoNotOptimize(out[0]);
+    }
+    state.Counter("chars", (double) chars);
+}
+
+}
+
+/// <summary>
+/// Decodes the skin files, which are almost entirely ASCII, so most of the
+/// input goes through the vector fast path.
+/// </summary>
+BENCHMARK(UTF8DecodeSkins) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::SkinFiles(), state, files, bytes) == false) {
+        return;
+    }
+    Decode(files, UTF8::Decode, state);
+    state.Bytes(bytes);
+}
+
+/// <summary>Decodes the same files a character at a time.</summary>
+BENCHMARK(UTF8DecodeSkinsScalar) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::SkinFiles(), state, files, bytes) == false) {
+        return;
+    }
+    Decode(files, ScalarDecode, state);
+    state.Bytes(bytes);
+}
+
+/// <summary>
+/// Decodes the language files, where translated text breaks up the runs of
+/// ASCII markup.
+/// </summary>
+BENCHMARK(UTF8DecodeLanguages) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::LanguageFiles(), state, files, bytes) == false) {
+        return;
+    }
+    Decode(files, UTF8::Decode, state);
+    state.Bytes(bytes);
+}
+
+/// <summary>Decodes the language files a character at a time.</summary>
+BENCHMARK(UTF8DecodeLanguagesScalar) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::LanguageFiles(), state, files, bytes) == false) {
+        return;
+    }
+    Decode(files, ScalarDecode, state);
+    state.Bytes(bytes);
+}
+
+/// <summary>Encodes the decoded language files back to UTF-8.</summary>
+BENCHMARK(UTF8EncodeLanguages) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::LanguageFiles(), state, files, bytes) == false) {
+        return;
+    }
+
+    std::vector<std::wstring> wide;
+    size_t largest = 0;
+    for (const std::string &file : files) {
+        wide.push_back(StringUtils::Widen(file));
+        largest = std::max(largest, wide.back().size());
+    }
+    std::vector<char> out(UTF8::MaxNarrowLength(largest));
+
+    while (state.KeepRunning()) {
+        for (const std::wstring &str : wide) {
+            Benchmark::DoNotOptimize(
+                UTF8::Encode(str.c_str(), str.size(), &out[0]));
+        }
+    }
+    state.Bytes(bytes);
+}
+
+/// <summary>
+/// Widens each line of the language files separately. Most conversions in
+/// the program are this short (attribute values, element text), so the
+/// allocation and setup around each call matter as much as throughput.
+/// </summary>
+BENCHMARK(UTF8WidenLines) {
+    std::vector<std::string> files;
+    unsigned long long bytes;
+    if (Load(Fixtures::LanguageFiles(), state, files, bytes) == false) {
+        return;
+    }
+
+    std::vector<std::string> lines;
+    for (const std::string &file : files) {
+        size_t start = 0;
+        while (start < file.size()) {
+            size_t end = file.find('\n', start);
+            if (end == std::string::npos) {
+                end = file.size();
+            }
+            lines.push_back(file.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    while (state.KeepRunning()) {
+        for (const std::string &line : lines) {
+            Benchmark::DoNotOptimize(StringUtils::Widen(line).size());
+        }
+    }
+    state.Items(lines.size());
+    state.Bytes(bytes);
+}
\ No newline at end of file
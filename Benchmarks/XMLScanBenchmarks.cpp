@@ -0,0 +1,94 @@
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TinyXml2/tinyxml2.h"
+
+using tinyxml2::XMLUtil;
+
+namespace {
+
+/* Long enough that the head and tail of each scan don't matter */
+const size_t Length = 64 * 1024;
+
+/* The scanners as they are built with TINYXML2_NO_SIMD */
+char *ScalarFindCharOrEnd(char *p, char c) {
+    while (*p && *p != c) {
+        ++p;
+    }
+    return p;
+}
+
+const char *ScalarSkipWhiteSpace(const char *p) {
+    while (XMLUtil::IsUTF8Continuation(*p) == false
+            && isspace(*reinterpret_cast<const unsigned char *>(p))) {
+        ++p;
+    }
+    return p;
+}
+
+/// <summary>Text without any markup, followed by a terminator.</summary>
+std::vector<char> Text() {
+    std::string sentence = "The quick brown fox jumps over the lazy dog. ";
+    std::vector<char> text;
+    while (text.size() < Length) {
+        text.insert(text.end(), sentence.begin(), sentence.end());
+    }
+    text.resize(Length);
+    text.push_back('\0');
+    return text;
+}
+
+/// <summary>Mixed whitespace, followed by a terminator.</summary>
+std::vector<char> WhiteSpace() {
+    std::string indent = "\r\n\t\t    ";
+    std::vector<char> space;
+    while (space.size() < Length) {
+        space.insert(space.end(), indent.begin(), indent.end());
+    }
+    space.resize(Length);
+    space.push_back('\0');
+    return space;
+}
+
+}
+
+/// <summary>
+/// Searches text for the '&lt;' that ends it with the tinyxml2 scanner, which
+/// reads 16 bytes at a time unless TINYXML2_NO_SIMD is defined.
+/// </summary>
+BENCHMARK(ScanFindChar) {
+    std::vector<char> text = Text();
+    while (state.KeepRunning()) {
+        Benchmark::DoNotOptimize(XMLUtil::FindCharOrEnd(&text[0], '<'));
+    }
+    state.Bytes(Length);
+}
+
+/// <summary>Searches the same text a byte at a time.</summary>
+BENCHMARK(ScanFindCharScalar) {
+    std::vector<char> text = Text();
+    while (state.KeepRunning()) {
+        Benchmark::DoNotOptimize(ScalarFindCharOrEnd(&text[0], '<'));
+    }
+    state.Bytes(Length);
+}
+
+/// <summary>Skips a run of whitespace with the tinyxml2 scanner.</summary>
+BENCHMARK(ScanWhiteSpace) {
+    std::vector<char> space = WhiteSpace();
+    while (state.KeepRunning()) {
+        Benchmark::DoNotOptimize(XMLUtil::SkipWhiteSpace(&space[0]));
+    }
+    state.Bytes(Length);
+}
+
+/// <summary>Skips the same whitespace a byte at a time.</summary>
+BENCHMARK(ScanWhiteSpaceScalar) {
+    std::vector<char> space = WhiteSpace();
+    while (state.KeepRunning()) {
+        Benchmark::DoNotOptimize(ScalarSkipWhiteSpace(&space[0]));
+    }
+    state.Bytes(Length);
+}
\ No newline at end of file
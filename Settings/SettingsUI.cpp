@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Settings
+
 #include "SettingsUI.h"
 
 #include <iostream>
@@ -95,7 +97,7 @@ int APIENTRY wWinMain(
     wcex.lpszClassName = CLASS_3RVX_SETTINGS;
 
     if (RegisterClassEx(&wcex) == 0) {
-        CLOG(L"Could not register class: %d", GetLastError());
+        ELOG(L"Could not register class: %d", GetLastError());
         return EXIT_FAILURE;
     }
 
@@ -169,7 +171,11 @@ int APIENTRY wWinMain(
     MoveWindow(mainWnd, pt.x - XOFFSET, pt.y - YOFFSET, 0, 0, TRUE);
 
     CLOG(L"Launching modal property sheet.");
-    return PropertySheet(&psh);
+    INT_PTR result = PropertySheet(&psh);
+
+    /* Make sure the last Apply/OK has been written before we exit */
+    settings->Flush();
+    return (int) result;
 }
 
 LRESULT CALLBACK WndProc(
@@ -237,11 +243,17 @@ int CALLBACK PropSheetProc(HWND hWnd, UINT msg, LPARAM lParam) {
                 for (Tab *tab : tabs) {
                     tab->SaveSettings();
                 }
-                Settings::Instance()->Save();
-
-                CLOG(L"Notifying 3RVX process of settings change");
-                HWND masterWnd = FindWindow(L"3RVXv3", L"3RVXv3");
-                SendMessage(masterWnd, WM_3RVX_CONTROL, MSG_LOAD, NULL);
+                Settings::Instance()->SaveAsync([](bool saved) {
+                    /* Runs on the writer thread once the file is on disk */
+                    if (saved == false) {
+                        ELOG(L"Could not write settings file!");
+                        return;
+                    }
+
+                    CLOG(L"Notifying 3RVX process of settings change");
+                    HWND masterWnd = FindWindow(L"3RVXv3", L"3RVXv3");
+                    PostMessage(masterWnd, WM_3RVX_CONTROL, MSG_LOAD, NULL);
+                });
             }
         }
         break;
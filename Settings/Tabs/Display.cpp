@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Settings
+
 #include "Display.h"
 
 #include <CommCtrl.h>
@@ -60,7 +62,7 @@ void Display::LoadSettings() {
     _hideFullscreen.Checked(settings->HideFullscreen());
 
     /* Position on Screen*/
-    for (std::wstring position : settings->OSDPosNames) {
+    for (std::wstring position : SettingsValues::OSDPosNames) {
         _position.AddItem(translator->Translate(position));
     }
     _position.Select((int) settings->OSDPosition());
@@ -69,7 +71,7 @@ void Display::LoadSettings() {
     _positionX.Text(settings->OSDX());
     _positionY.Text(settings->OSDY());
     _customDistance.Checked(
-        settings->OSDEdgeOffset() != Settings::DefaultOSDOffset);
+        settings->OSDEdgeOffset() != SettingsValues::DefaultOSDOffset);
     _edgeSpinner.Text(settings->OSDEdgeOffset());
     _edgeSpinner.Range(MIN_EDGE, MAX_EDGE);
 
@@ -128,7 +130,7 @@ void Display::SaveSettings() {
     } else {
         /* We have to write the default here, just in case somebody unchecked
          * the checkbox. */
-        settings->OSDEdgeOffset(Settings::DefaultOSDOffset);
+        settings->OSDEdgeOffset(SettingsValues::DefaultOSDOffset);
     }
 
     std::wstring monitor = _displayDevice.Selection();
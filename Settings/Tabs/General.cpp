@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Settings
+
 #include "General.h"
 
 #include <shellapi.h>
@@ -56,7 +58,7 @@ void General::LoadSettings() {
     std::wstring current = settings->CurrentSkin();
     int idx = _skin.Select(current);
     if (idx == CB_ERR) {
-        _skin.Select(Settings::DefaultSkin);
+        _skin.Select(SettingsValues::DefaultSkin);
     }
     LoadSkinInfo(current);
 
@@ -140,7 +142,7 @@ std::list<std::wstring> General::FindSkins(std::wstring dir) {
     dir += L"\\*";
     hFind = FindFirstFile(dir.c_str(), &ffd);
     if (hFind == INVALID_HANDLE_VALUE) {
-        CLOG(L"FindFirstFile() failed");
+        ELOG(L"FindFirstFile() failed");
         return skins;
     }
 
@@ -184,7 +186,7 @@ std::list<std::wstring> General::FindLanguages(std::wstring dir) {
     dir += L"\\*.xml";
     hFind = FindFirstFile(dir.c_str(), &ffd);
     if (hFind == INVALID_HANDLE_VALUE) {
-        CLOG(L"FindFirstFile() failed");
+        ELOG(L"FindFirstFile() failed");
         return languages;
     }
 
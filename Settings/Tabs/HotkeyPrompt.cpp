@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Hotkeys
+
 #include "HotkeyPrompt.h"
 
 #include "../../3RVX/Error.h"
@@ -90,8 +92,17 @@ INT_PTR CALLBACK HotkeyPrompt::DialogProc(
         KeyGrabber::Instance()->Grab();
         break;
 
+    case WM_TIMER:
+        if (wParam == KeyGrabber::SequenceTimer) {
+            /* No more keys were pressed; the hotkey is complete */
+            KillTimer(hwndDlg, KeyGrabber::SequenceTimer);
+            SendMessage(hwndDlg, WM_CLOSE, NULL, NULL);
+        }
+        break;
+
     case WM_CLOSE:
         CLOG(L"Closing hotkey prompt.");
+        KillTimer(hwndDlg, KeyGrabber::SequenceTimer);
         EnableWindow(_parent, TRUE);
         EndDialog(hwndDlg, 0);
         DestroyWindow(_hWnd);
@@ -101,6 +112,8 @@ INT_PTR CALLBACK HotkeyPrompt::DialogProc(
         nCode = HIWORD(wParam);
         ctrlId = LOWORD(wParam);
         if (ctrlId == BTN_CANCEL && nCode == BN_CLICKED) {
+            /* Discard any partially-entered sequence */
+            KeyGrabber::Instance()->Reset();
             SendMessage(hwndDlg, WM_CLOSE, NULL, NULL);
         }
         break;
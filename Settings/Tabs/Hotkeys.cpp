@@ -1,3 +1,5 @@
+#define LOG_SUBSYSTEM Hotkeys
+
 #include "Hotkeys.h"
 
 #include <CommCtrl.h>
@@ -76,14 +78,11 @@ void Hotkeys::LoadSettings() {
         _action.AddItem(_translator->Translate(action));
     }
 
-    std::unordered_map<int, HotkeyInfo> hotkeys = settings->Hotkeys();
-    for (auto it = hotkeys.begin(); it != hotkeys.end(); ++it) {
-        _keyInfo.push_back(it->second);
-    }
+    _keyInfo = settings->Hotkeys();
 
     for (unsigned int i = 0; i < _keyInfo.size(); ++i) {
         HotkeyInfo hki = _keyInfo[i];
-        std::wstring hkStr = HotkeyManager::HotkeysToString(hki.keyCombination);
+        std::wstring hkStr = hki.KeysToString();
         int idx = _keyList.AddItem(hkStr);
         LoadAction(idx, hki);
     }
@@ -133,8 +132,7 @@ void Hotkeys::LoadSelection(int index) {
 
     _keys.Text(L"");
     if (selection.keyCombination > 0) {
-        std::wstring keyStr
-            = HotkeyManager::HotkeysToString(selection.keyCombination);
+        std::wstring keyStr = selection.KeysToString();
         _keys.Text(keyStr);
         _keyList.ItemText(index, 0, keyStr);
     }
@@ -475,10 +473,12 @@ bool Hotkeys::OnKeysButtonClick() {
     KeyGrabber::Instance()->Unhook();
     int keyCombo = KeyGrabber::Instance()->KeyCombination();
     if (keyCombo > 0) {
-        std::wstring keyStr = HotkeyManager::HotkeysToString(keyCombo);
-        _keys.Text(keyStr);
         int sel = _keyList.Selection();
-        _keyInfo[sel].keyCombination = keyCombo;
+        HotkeyInfo &current = _keyInfo[sel];
+        current.keyCombination = keyCombo;
+        current.sequence = KeyGrabber::Instance()->Sequence();
+        current.holdTime = KeyGrabber::Instance()->HoldTime();
+        _keys.Text(current.KeysToString());
         LoadSelection(sel);
     }
     return true;
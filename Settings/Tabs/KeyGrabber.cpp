@@ -29,17 +29,34 @@ bool KeyGrabber::Unhook() {
 }
 
 void KeyGrabber::Grab() {
-    _keyCombination = 0;
-    _modifierState = 0;
+    Reset();
     Hook();
 }
 
+void KeyGrabber::Reset() {
+    _capture.Reset();
+    _modifierState = 0;
+}
+
+void KeyGrabber::Finish() {
+    KillTimer(_hWnd, SequenceTimer);
+    PostMessage(_hWnd, WM_CLOSE, NULL, NULL);
+}
+
 void KeyGrabber::SetHwnd(HWND updateHwnd) {
     _hWnd = updateHwnd;
 }
 
 int KeyGrabber::KeyCombination() {
-    return _keyCombination;
+    return _capture.KeyCombination();
+}
+
+std::vector<int> KeyGrabber::Sequence() {
+    return _capture.Sequence();
+}
+
+unsigned int KeyGrabber::HoldTime() {
+    return _capture.HoldTime();
 }
 
 LRESULT CALLBACK
@@ -65,8 +82,15 @@ KeyGrabber::KeyProc(int nCode, WPARAM wParam, LPARAM lParam) {
         /* Is this an extended key? (Used for converting VKs to strings) */
         int ext = (kbInfo->flags & 0x1) << EXT_OFFSET;
 
-        _keyCombination = (_modifierState | ext | vk);
-        PostMessage(_hWnd, WM_CLOSE, NULL, NULL);
+        int keys = (_modifierState | ext | vk);
+
+        if (_capture.KeyDown(keys, kbInfo->time)) {
+            Finish();
+        } else {
+            /* Wait for the next step of the sequence, or for a key that is
+             * being held to reach the hold time (restarts the timer) */
+            SetTimer(_hWnd, SequenceTimer, HotkeyMatcher::DefaultTimeout, NULL);
+        }
 
         /* Prevent other applications from receiving this event */
         return (LRESULT) 1;
@@ -77,6 +101,8 @@ KeyGrabber::KeyProc(int nCode, WPARAM wParam, LPARAM lParam) {
         int m = HotkeyManager::IsModifier(kbInfo->vkCode);
         if (m) {
             _modifierState ^= m;
+        } else {
+            _capture.KeyUp(kbInfo->vkCode);
         }
         return (LRESULT) 1;
     }
@@ -135,8 +161,11 @@ KeyGrabber::MouseProc(int nCode, WPARAM wParam, LPARAM lParam) {
             return CallNextHookEx(NULL, nCode, wParam, lParam);
         }
 
-        _keyCombination = (_modifierState | keyCombo);
-        PostMessage(_hWnd, WM_CLOSE, NULL, NULL);
+        _capture.Mouse(_modifierState | keyCombo);
+
+        /* Mouse combinations can't be part of a sequence, so a mouse event
+         * always finishes the capture. */
+        Finish();
 
         return (LRESULT) 1;
     }
@@ -1,21 +1,41 @@
 #pragma once
 
 #include <Windows.h>
+#include <vector>
+#include "../../3RVX/HotkeyCapture.h"
 #include "../../3RVX/HotkeyManager.h"
 
+/// <summary>
+/// Captures a hotkey from the user. Keyboard combinations entered in quick
+/// succession (within HotkeyMatcher::DefaultTimeout) are recorded as a
+/// multi-key sequence, and holding the last key down records a press-and-hold
+/// hotkey (see HotkeyCapture). When the capture is finished, WM_CLOSE is
+/// posted to the window.
+/// </summary>
 class KeyGrabber {
 public:
     static KeyGrabber *Instance();
 
     void Grab();
+    void Reset();
     int KeyCombination();
+    std::vector<int> Sequence();
+    unsigned int HoldTime();
     void SetHwnd(HWND updateHwnd);
     bool Unhook();
 
+    /// <summary>
+    /// Timer posted to the window when the sequence timeout elapses; the
+    /// window should close when it receives this timer.
+    /// </summary>
+    static const UINT_PTR SequenceTimer = 300;
+
 private:
     HWND _hWnd;
-    int _keyCombination;
+    HotkeyCapture _capture;
     int _modifierState;
+
+    void Finish();
     HHOOK _keyHook;
     HHOOK _mouseHook;
 
@@ -0,0 +1,157 @@
+#include "FileSystem.h"
+
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include "StringUtils.h"
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+FILE *FileSystem::Open(const std::string &path) {
+    return _wfopen(StringUtils::Widen(path).c_str(), L"rb");
+}
+
+bool FileSystem::List(const std::string &dir, std::vector<Entry> &entries) {
+    std::wstring pattern = StringUtils::Widen(dir) + L"\\*";
+    WIN32_FIND_DATAW fd = {};
+    HANDLE hFind = FindFirstFileW(pattern.c_str(), &fd);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    do {
+        std::wstring name(fd.cFileName);
+        if (name == L"." || name == L"..") {
+            continue;
+        }
+
+        Entry entry;
+        entry.name = StringUtils::Narrow(name);
+        entry.directory = (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        entries.push_back(entry);
+    } while (FindNextFileW(hFind, &fd));
+    FindClose(hFind);
+
+    return true;
+}
+
+bool FileSystem::IsDirectory(const std::string &path) {
+    DWORD attr = GetFileAttributesW(StringUtils::Widen(path).c_str());
+    return attr != INVALID_FILE_ATTRIBUTES
+        && (attr & FILE_ATTRIBUTE_DIRECTORY) != 0;
+}
+
+bool FileSystem::IsFile(const std::string &path) {
+    DWORD attr = GetFileAttributesW(StringUtils::Widen(path).c_str());
+    return attr != INVALID_FILE_ATTRIBUTES
+        && (attr & FILE_ATTRIBUTE_DIRECTORY) == 0;
+}
+
+std::string FileSystem::Resolve(const std::string &dir,
+        const std::string &relativePath) {
+
+    return dir + "\\" + relativePath;
+}
+
+#else
+
+namespace {
+
+bool EqualsIgnoreCase(const std::string &a, const std::string &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (tolower((unsigned char) a[i]) != tolower((unsigned char) b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+FILE *FileSystem::Open(const std::string &path) {
+    return fopen(path.c_str(), "rb");
+}
+
+bool FileSystem::List(const std::string &dir, std::vector<Entry> &entries) {
+    DIR *d = opendir(dir.c_str());
+    if (d == NULL) {
+        return false;
+    }
+
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL) {
+        std::string name(ent->d_name);
+        if (name == "." || name == "..") {
+            continue;
+        }
+
+        Entry entry;
+        entry.name = name;
+        entry.directory = IsDirectory(dir + "/" + name);
+        entries.push_back(entry);
+    }
+    closedir(d);
+
+    std::sort(entries.begin(), entries.end(),
+        [](const Entry &a, const Entry &b) { return a.name < b.name; });
+    return true;
+}
+
+bool FileSystem::IsDirectory(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool FileSystem::IsFile(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+std::string FileSystem::Resolve(const std::string &dir,
+        const std::string &relativePath) {
+
+    std::string path = dir;
+    size_t start = 0;
+    while (start <= relativePath.size()) {
+        size_t end = relativePath.find_first_of("\\/", start);
+        if (end == std::string::npos) {
+            end = relativePath.size();
+        }
+
+        std::string component = relativePath.substr(start, end - start);
+        start = end + 1;
+        if (component.empty() || component == ".") {
+            continue;
+        }
+
+        std::string exact = path + "/" + component;
+        struct stat st;
+        if (component == ".." || stat(exact.c_str(), &st) == 0) {
+            path = exact;
+            continue;
+        }
+
+        std::vector<Entry> entries;
+        List(path, entries);
+        for (const Entry &entry : entries) {
+            if (EqualsIgnoreCase(entry.name, component)) {
+                exact = path + "/" + entry.name;
+                break;
+            }
+        }
+        path = exact;
+    }
+
+    return path;
+}
+
+#endif
\ No newline at end of file
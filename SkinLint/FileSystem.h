@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Minimal file system access for the skin checker, which has to run on
+/// Windows and on other platforms. All paths are UTF-8.
+/// </summary>
+class FileSystem {
+public:
+    struct Entry {
+        std::string name;
+        bool directory;
+    };
+
+    /// <summary>
+    /// Opens a file for reading in binary mode. Returns NULL if the file
+    /// cannot be opened.
+    /// </summary>
+    static FILE *Open(const std::string &path);
+
+    /// <summary>
+    /// Retrieves the entries of a directory, excluding '.' and '..'. Returns
+    /// false if the directory cannot be read.
+    /// </summary>
+    static bool List(const std::string &dir, std::vector<Entry> &entries);
+
+    static bool IsDirectory(const std::string &path);
+    static bool IsFile(const std::string &path);
+
+    /// <summary>
+    /// Appends a skin-relative path (which uses backslashes, as skins are
+    /// written for Windows) to a directory. Where the file system is case
+    /// sensitive, each component is matched without regard to case so that
+    /// files are found the same way they would be on Windows.
+    /// </summary>
+    static std::string Resolve(const std::string &dir,
+        const std::string &relativePath);
+};
\ No newline at end of file
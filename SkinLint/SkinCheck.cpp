@@ -0,0 +1,837 @@
+#include "SkinCheck.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <math.h>
+#include <sstream>
+
+#include "TinyXml2/tinyxml2.h"
+#include "MeterWnd/ArcRasterizer.h"
+#include "MeterWnd/MeterLayout.h"
+#include "FileSystem.h"
+
+namespace {
+
+/* Matches SKIN_DEFAULT_UNITS and the clamping in Skin::LoadMeter */
+const int DefaultUnits = 10;
+const int MinUnits = 1;
+const int MaxUnits = 100;
+
+/* Meters draw at most this many digits (100%) */
+const int NumberStripDigits = 3;
+
+const char *RequiredOSDs[] = { "volume", "mute", "eject" };
+
+/* Meter values sampled by ReportLayout */
+const float LayoutValues[] = { 0.0f, 0.01f, 0.25f, 0.5f, 0.75f, 0.99f, 1.0f };
+
+/* Steps in the 0 - 1 sweep used to count bar redraws */
+const int SweepSteps = 1000;
+
+std::string Lower(const char *str) {
+    std::string s(str == NULL ? "" : str);
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+std::string Str(int value) {
+    std::ostringstream ss;
+    ss << value;
+    return ss.str();
+}
+
+std::string Size(int width, int height) {
+    return Str(width) + "x" + Str(height);
+}
+
+std::string Bytes(unsigned long long bytes) {
+    std::ostringstream ss;
+    if (bytes >= 1024 * 1024) {
+        ss.precision(1);
+        ss << std::fixed << (bytes / (1024.0 * 1024.0)) << " MiB";
+    } else {
+        ss << (bytes + 1023) / 1024 << " KiB";
+    }
+    return ss.str();
+}
+
+unsigned long long Pixels(int width, int height) {
+    return (unsigned long long) width * height;
+}
+
+unsigned int BigEndian(const unsigned char *b) {
+    return (b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3];
+}
+
+int LittleEndian(const unsigned char *b) {
+    return (int) (b[0] | (b[1] << 8) | (b[2] << 16) | (b[3] << 24));
+}
+
+/// <summary>
+/// Reads the dimensions of a PNG or BMP image from its header. Returns false
+/// if the file is not a recognized image.
+/// </summary>
+bool ImageSize(FILE *file, int &width, int &height) {
+    unsigned char header[26];
+    size_t read = fread(header, 1, sizeof(header), file);
+
+    static const unsigned char png[] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A };
+    if (read >= 24 && std::equal(png, png + sizeof(png), header)
+            && std::equal(header + 12, header + 16, "IHDR")) {
+        width = (int) BigEndian(header + 16);
+        height = (int) BigEndian(header + 20);
+        return true;
+    }
+
+    if (read >= 26 && header[0] == 'B' && header[1] == 'M') {
+        width = LittleEndian(header + 18);
+        height = std::abs(LittleEndian(header + 22));
+        return true;
+    }
+
+    return false;
+}
+
+std::string RectString(const MeterLayout::Rect &r) {
+    return "(" + Str(r.x) + ", " + Str(r.y) + ") " + Size(r.width, r.height);
+}
+
+std::string BlitString(const MeterLayout::Blit &blit) {
+    return RectString(blit.src) + " -> " + RectString(blit.dest);
+}
+
+/// <summary>
+/// Counts the redraws of a bar as its value sweeps from 0 to 1, in units or
+/// (for smooth bars) whenever the drawn pixels change.
+/// </summary>
+int SweepRedraws(int units, int length, bool smooth) {
+    int redraws = 0;
+    int drawn = -1;
+    for (int i = 0; i <= SweepSteps; ++i) {
+        float value = (float) i / SweepSteps;
+        int state = smooth
+            ? MeterLayout::SmoothState(value, length)
+            : MeterLayout::Units(value, units);
+        if (state != drawn) {
+            redraws++;
+            drawn = state;
+        }
+    }
+    return redraws;
+}
+
+bool Outside(int x, int y, int width, int height, int bgWidth, int bgHeight) {
+    return x < 0 || y < 0 || x + width > bgWidth || y + height > bgHeight;
+}
+
+}
+
+SkinCheck::SkinCheck(const std::string &skinDir) :
+_skinDir(skinDir) {
+
+}
+
+bool SkinCheck::Run() {
+    _issues.clear();
+    _costs.clear();
+
+    std::string xmlFile = FileSystem::Resolve(_skinDir, "skin.xml");
+    FILE *file = FileSystem::Open(xmlFile);
+    if (file == NULL) {
+        Add(Error, "skin.xml", "could not open " + xmlFile);
+        return false;
+    }
+
+    tinyxml2::XMLDocument xml;
+    tinyxml2::XMLError result = xml.LoadFile(file);
+    fclose(file);
+    if (result != tinyxml2::XML_SUCCESS) {
+        std::string detail = xml.GetErrorStr1() ? xml.GetErrorStr1() : "";
+        Add(Error, "skin.xml", std::string("could not parse the skin: ")
+            + xml.ErrorName() + (detail.empty() ? "" : " (" + detail + ")"));
+        return false;
+    }
+
+    tinyxml2::XMLElement *root = xml.FirstChildElement("skin");
+    if (root == NULL) {
+        tinyxml2::XMLElement *other = xml.RootElement();
+        Add(Error, "skin.xml", std::string("missing root <skin> element")
+            + (other ? " (found <" + std::string(other->Name()) + ">)" : ""));
+        return false;
+    }
+
+    if (root->FirstChildElement("info") == NULL) {
+        Add(Warning, "skin", "missing <info>; author and website are blank");
+    }
+
+    CheckOSDs(root->FirstChildElement("osds"));
+    CheckSliders(root->FirstChildElement("sliders"));
+    return Errors() == 0;
+}
+
+const std::vector<SkinCheck::Issue> &SkinCheck::Issues() const {
+    return _issues;
+}
+
+const std::vector<SkinCheck::Cost> &SkinCheck::Costs() const {
+    return _costs;
+}
+
+int SkinCheck::Errors() const {
+    return (int) std::count_if(_issues.begin(), _issues.end(),
+        [](const Issue &i) { return i.severity == Error; });
+}
+
+int SkinCheck::Warnings() const {
+    return (int) _issues.size() - Errors();
+}
+
+void SkinCheck::Report(std::ostream &out) const {
+    out << _skinDir << "\n";
+    for (const Issue &issue : _issues) {
+        out << "  " << (issue.severity == Error ? "error" : "warning")
+            << ": " << issue.location << ": " << issue.message << "\n";
+    }
+
+    for (const Cost &cost : _costs) {
+        out << "  " << cost.name << ": " << Size(cost.width, cost.height)
+            << ", " << cost.bitmaps << " bitmaps (" << Bytes(cost.bytes)
+            << "), " << cost.pixelsPerFrame << " px/frame\n";
+
+        for (const MeterCost &m : cost.meters) {
+            out << "    " << m.type << " " << Size(m.width, m.height);
+            if (m.frames > 1) {
+                out << ", " << m.frames << " frames";
+            }
+            if (m.tiles > 1) {
+                out << ", " << m.tiles << " tiles";
+            }
+            out << ", " << Bytes(m.bytes);
+            if (m.rasterTime > 0) {
+                out << " when all frames are shown, "
+                    << (int) (m.rasterTime + 0.5) << " us/frame to render";
+            }
+            out << ", " << m.pixelsPerFrame << " px/frame\n";
+        }
+    }
+}
+
+void SkinCheck::ReportLayout(std::ostream &out) const {
+    out << _skinDir << "\n";
+    for (const Cost &cost : _costs) {
+        for (const MeterCost &m : cost.meters) {
+            MeterLayout::Rect image = {
+                m.x, m.y, m.imageWidth, m.imageHeight
+            };
+            bool known = (m.type == "horizontalbar" || m.type == "verticalbar"
+                || m.type == "bitstrip" || m.type == "horizontaltile"
+                || m.type == "numberstrip");
+            if (known == false) {
+                continue;
+            }
+
+            bool bar = (m.type == "horizontalbar"
+                || m.type == "verticalbar");
+            out << "  " << cost.name << ": " << m.type
+                << " (" << m.units << " units"
+                << (m.smooth ? ", smooth" : "") << ")\n";
+            for (float value : LayoutValues) {
+                int units = MeterLayout::Units(value, m.units);
+                out << "    " << value << " = " << units << ": ";
+                if (m.type == "numberstrip") {
+                    /* Matches Skin::Alignment: anything else is left */
+                    MeterLayout::Alignment align = MeterLayout::Near;
+                    if (m.align == "center") {
+                        align = MeterLayout::Center;
+                    } else if (m.align == "right") {
+                        align = MeterLayout::Far;
+                    }
+
+                    MeterLayout::Blit blits[MeterLayout::MaxDigits];
+                    int count = MeterLayout::NumberStrip(
+                        image, m.units, units, align, blits);
+                    out << MeterLayout::Percent(m.units, units) << "%";
+                    for (int i = count - 1; i >= 0; --i) {
+                        out << (i == count - 1 ? " " : ", ")
+                            << BlitString(blits[i]);
+                    }
+                    out << "\n";
+                    continue;
+                }
+
+                if (m.type == "horizontaltile") {
+                    out << "fill " << RectString(MeterLayout::HorizontalTile(
+                        image, m.units, units, m.inverted)) << "\n";
+                    continue;
+                }
+
+                if (bar && m.smooth) {
+                    MeterLayout::SmoothBlit smooth = (m.type == "verticalbar")
+                        ? MeterLayout::SmoothVerticalBar(image, value)
+                        : MeterLayout::SmoothHorizontalBar(image, value);
+                    out << BlitString(smooth.full);
+                    if (smooth.coverage > 0) {
+                        out << ", edge " << BlitString(smooth.edge)
+                            << " at " << smooth.coverage << "/255";
+                    }
+                    out << "\n";
+                    continue;
+                }
+
+                MeterLayout::Blit blit;
+                if (m.type == "horizontalbar") {
+                    /* Skin does not pass 'inverted' to horizontal bars */
+                    blit = MeterLayout::HorizontalBar(
+                        image, m.units, units, false);
+                } else if (m.type == "verticalbar") {
+                    blit = MeterLayout::VerticalBar(image, m.units, units);
+                } else {
+                    blit = MeterLayout::Bitstrip(image, m.units, units);
+                }
+                out << BlitString(blit) << "\n";
+            }
+
+            if (bar) {
+                int length = (m.type == "verticalbar")
+                    ? m.imageHeight : m.imageWidth;
+                out << "    sweep: " << SweepRedraws(m.units, length, false)
+                    << " redraws in units, "
+                    << SweepRedraws(m.units, length, true) << " smooth\n";
+            }
+        }
+    }
+}
+
+void SkinCheck::Add(Severity severity, const std::string &location,
+        const std::string &message) {
+
+    Issue issue = { severity, location, message };
+    _issues.push_back(issue);
+}
+
+void SkinCheck::CheckOSDs(tinyxml2::XMLElement *osds) {
+    if (osds == NULL) {
+        Add(Error, "skin", "missing <osds>");
+        return;
+    }
+
+    for (const char *name : RequiredOSDs) {
+        if (osds->FirstChildElement(name) == NULL) {
+            Add(Error, "osds", std::string("missing <") + name + ">");
+        }
+    }
+
+    std::vector<std::string> seen;
+    tinyxml2::XMLElement *osd = osds->FirstChildElement();
+    for (; osd != NULL; osd = osd->NextSiblingElement()) {
+        std::string name(osd->Name());
+        std::string location = "osds/" + name;
+
+        if (std::find(seen.begin(), seen.end(), name) != seen.end()) {
+            Add(Warning, location, "duplicate element; only the first "
+                "one is used");
+            continue;
+        }
+        seen.push_back(name);
+
+        const char **last = RequiredOSDs
+            + sizeof(RequiredOSDs) / sizeof(char *);
+        if (std::find(RequiredOSDs, last, name) == last) {
+            Add(Warning, location, "unknown OSD; it is ignored");
+            continue;
+        }
+
+        Cost cost = CheckBackground(osd, location);
+        if (name == "volume") {
+            int units = DefaultUnits;
+            if (osd->QueryIntAttribute("defaultUnits", &units)
+                    == tinyxml2::XML_SUCCESS
+                    && (units < MinUnits || units > MaxUnits)) {
+                Add(Warning, location, "defaultUnits " + Str(units)
+                    + " is outside " + Str(MinUnits) + "-" + Str(MaxUnits));
+            }
+
+            CheckMeters(osd, location, cost);
+            CheckIconset(osd->FirstChildElement("iconset"), location);
+            CheckSound(osd->FirstChildElement("sound"), location);
+        } else if (osd->FirstChildElement("meter") != NULL) {
+            Add(Warning, location, "meters are only drawn on the volume "
+                "OSD; they are ignored");
+        }
+
+        _costs.push_back(cost);
+    }
+}
+
+void SkinCheck::CheckSliders(tinyxml2::XMLElement *sliders) {
+    tinyxml2::XMLElement *volume = NULL;
+    if (sliders != NULL) {
+        volume = sliders->FirstChildElement("volume");
+    }
+    if (volume == NULL) {
+        Add(Error, "sliders", "missing <sliders><volume>");
+        return;
+    }
+
+    std::string location = "sliders/volume";
+    Cost cost = CheckBackground(volume, location);
+    cost.name = "volume slider";
+    CheckKnob(volume->FirstChildElement("slider"), location, cost);
+    CheckMeters(volume, location, cost);
+    _costs.push_back(cost);
+}
+
+SkinCheck::Cost SkinCheck::CheckBackground(tinyxml2::XMLElement *element,
+        const std::string &location) {
+
+    Cost cost = {};
+    cost.name = std::string(element->Name()) + " OSD";
+
+    Image bg = ReadImage(element, "background", location, true);
+    if (bg.found == false) {
+        return cost;
+    }
+
+    cost.width = bg.width;
+    cost.height = bg.height;
+
+    /* The background and the composite it is cloned into on every update */
+    cost.bitmaps = 2;
+    cost.bytes = 2 * Pixels(bg.width, bg.height) * 4;
+
+    /* Cloning the background into the composite, then copying the composite
+     * to the layered window */
+    cost.pixelsPerFrame = 2 * Pixels(bg.width, bg.height);
+
+    Image mask = ReadImage(element, "mask", location, false);
+    if (mask.found) {
+        cost.bitmaps++;
+        cost.bytes += Pixels(mask.width, mask.height) * 4;
+        if (mask.width != bg.width || mask.height != bg.height) {
+            Add(Warning, location, "mask is " + Size(mask.width, mask.height)
+                + " but the background is " + Size(bg.width, bg.height));
+        }
+    }
+
+    return cost;
+}
+
+void SkinCheck::CheckMeters(tinyxml2::XMLElement *parent,
+        const std::string &location, Cost &cost) {
+
+    int index = 0;
+    tinyxml2::XMLElement *meter = parent->FirstChildElement("meter");
+    for (; meter != NULL; meter = meter->NextSiblingElement("meter")) {
+        std::string meterLocation = location + "/meter[" + Str(++index) + "]";
+        MeterCost meterCost = {};
+        if (CheckMeter(meter, meterLocation, cost, meterCost) == false) {
+            continue;
+        }
+
+        if (meterCost.bytes > 0) {
+            cost.bitmaps++;
+        }
+        cost.bytes += meterCost.bytes;
+        cost.pixelsPerFrame += meterCost.pixelsPerFrame;
+        cost.meters.push_back(meterCost);
+    }
+}
+
+bool SkinCheck::CheckMeter(tinyxml2::XMLElement *meter,
+        const std::string &location, const Cost &parent, MeterCost &cost) {
+
+    const char *typeAttr = meter->Attribute("type");
+    if (typeAttr == NULL) {
+        Add(Error, location, "missing type; the meter is not loaded");
+        return false;
+    }
+
+    std::string type = Lower(typeAttr);
+    cost.type = type;
+
+    static const char *types[] = {
+        "arc", "bitstrip", "horizontalbar", "horizontalendcap",
+        "horizontaltile", "image", "numberstrip", "ring", "text",
+        "verticalbar",
+    };
+    const char **typesEnd = types + sizeof(types) / sizeof(char *);
+    if (std::find(types, typesEnd, type) == typesEnd) {
+        Add(Error, location, "unknown meter type '" + std::string(typeAttr)
+            + "'; the meter is not loaded");
+        return false;
+    }
+
+    int x = meter->IntAttribute("x");
+    int y = meter->IntAttribute("y");
+
+    int units = DefaultUnits;
+    meter->QueryIntAttribute("units", &units);
+    if (units < MinUnits || units > MaxUnits) {
+        int clamped = std::min(std::max(units, MinUnits), MaxUnits);
+        Add(Warning, location, "units " + Str(units) + " is clamped to "
+            + Str(clamped));
+        units = clamped;
+    }
+
+    bool inverted = false;
+    meter->QueryBoolAttribute("inverted", &inverted);
+    if (meter->Attribute("inverted") != NULL
+            && type != "horizontaltile" && type != "verticalbar") {
+        Add(Warning, location, "'inverted' has no effect on " + type);
+    }
+
+    cost.x = x;
+    cost.y = y;
+    cost.units = units;
+    cost.inverted = inverted;
+
+    bool smooth = false;
+    meter->QueryBoolAttribute("smooth", &smooth);
+    if (meter->Attribute("smooth") != NULL
+            && type != "horizontalbar" && type != "verticalbar") {
+        Add(Warning, location, "'smooth' has no effect on " + type);
+    }
+    cost.smooth = smooth;
+    cost.align = Lower(meter->Attribute("align"));
+
+    if (type == "text") {
+        cost.width = meter->IntAttribute("width");
+        cost.height = meter->IntAttribute("height");
+        if (cost.width <= 0 || cost.height <= 0) {
+            Add(Warning, location, "text area is "
+                + Size(cost.width, cost.height) + "; nothing is drawn");
+        }
+
+        float size = 10;
+        meter->QueryFloatAttribute("size", &size);
+        if (size <= 0) {
+            Add(Warning, location, "font size must be positive");
+        }
+
+        CheckColor(meter, location);
+        CheckAlignment(meter, location);
+
+        /* Glyphs are drawn from an atlas with one cell per character the
+         * meter can show. The cell size is estimated from the font size
+         * (in points, at 96 DPI): the line height, and an average advance
+         * plus a quarter of the line height on each side. */
+        const char *formatAttr = meter->Attribute("format");
+        std::string format(formatAttr ? formatAttr : "[[PERC]]%");
+        size_t perc = format.find("[[PERC]]");
+        if (perc != std::string::npos) {
+            format.erase(perc, 8);
+        }
+        /* Each code point (a UTF-8 sequence) gets its own cell */
+        std::vector<std::string> chars;
+        for (char digit = '0'; digit <= '9'; ++digit) {
+            chars.push_back(std::string(1, digit));
+        }
+        int shown = 3;
+        for (size_t i = 0; i < format.size(); ++shown) {
+            size_t length = 1;
+            while (i + length < format.size()
+                    && (format[i + length] & 0xC0) == 0x80) {
+                ++length;
+            }
+            std::string ch = format.substr(i, length);
+            if (std::find(chars.begin(), chars.end(), ch) == chars.end()) {
+                chars.push_back(ch);
+            }
+            i += length;
+        }
+
+        int lineHeight = (int) ceil(size * 96.0f / 72.0f * 1.15f);
+        int cellWidth = (int) ceil(lineHeight * 0.55f) + 2 * (lineHeight / 4);
+        cost.frames = (int) chars.size();
+        cost.bytes = Pixels(cellWidth * cost.frames, lineHeight) * 4;
+        cost.pixelsPerFrame = Pixels(cellWidth * shown, lineHeight);
+    } else if (type == "arc" || type == "ring") {
+        int size = meter->IntAttribute("size");
+        if (size <= 0) {
+            Add(Error, location, "size must be positive");
+            return false;
+        }
+
+        float thickness = size / 8.0f;
+        meter->QueryFloatAttribute("thickness", &thickness);
+        if (thickness <= 0) {
+            Add(Warning, location, "thickness must be positive; nothing "
+                "is drawn");
+        }
+
+        float sweep = (type == "ring") ? 360.0f : 270.0f;
+        meter->QueryFloatAttribute("sweep", &sweep);
+        if (sweep <= 0 || sweep > 360) {
+            Add(Warning, location, "sweep " + Str((int) sweep)
+                + " is outside 1-360 degrees");
+        }
+
+        CheckColor(meter, location);
+
+        /* One frame per unit value, rendered when first shown */
+        cost.width = size;
+        cost.height = size;
+        cost.frames = units;
+        cost.bytes = Pixels(size, size) * 4 * units;
+        cost.pixelsPerFrame = Pixels(size, size);
+
+        float start = (type == "ring") ? 0.0f : 225.0f;
+        meter->QueryFloatAttribute("start", &start);
+        ArcRasterizer rasterizer(size, thickness, start, sweep);
+        std::vector<unsigned char> coverage(Pixels(size, size));
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 1; i <= units; ++i) {
+            rasterizer.Rasterize((float) i / units, &coverage[0]);
+        }
+        auto end = std::chrono::steady_clock::now();
+        cost.rasterTime = std::chrono::duration<double, std::micro>(
+            end - begin).count() / units;
+    } else {
+        Image img = ReadImage(meter, "image", location, true);
+        if (img.found == false) {
+            return false;
+        }
+
+        cost.imageWidth = img.width;
+        cost.imageHeight = img.height;
+        cost.width = img.width;
+        cost.height = img.height;
+        cost.frames = 1;
+        cost.bytes = Pixels(img.width, img.height) * 4;
+        cost.pixelsPerFrame = Pixels(img.width, img.height);
+
+        if (type == "bitstrip") {
+            cost.frames = units;
+            cost.height = img.height / units;
+            cost.pixelsPerFrame = Pixels(cost.width, cost.height);
+            if (img.height % units != 0) {
+                Add(Warning, location, "image height " + Str(img.height)
+                    + " is not a multiple of " + Str(units) + " units");
+            }
+        } else if (smooth) {
+            /* Smooth bars are not divided into units */
+        } else if (type == "horizontalbar" || type == "horizontalendcap") {
+            if (img.width % units != 0) {
+                Add(Warning, location, "image width " + Str(img.width)
+                    + " is not a multiple of " + Str(units) + " units; "
+                    + Str(img.width % units) + " px are never drawn");
+            }
+        } else if (type == "verticalbar") {
+            if (img.height % units != 0) {
+                Add(Warning, location, "image height " + Str(img.height)
+                    + " is not a multiple of " + Str(units) + " units; "
+                    + Str(img.height % units) + " px are never drawn");
+            }
+        } else if (type == "horizontaltile") {
+            cost.tiles = units;
+            cost.width = img.width * units;
+            cost.pixelsPerFrame = Pixels(cost.width, cost.height);
+        } else if (type == "numberstrip") {
+            cost.frames = 10;
+            cost.width = img.width * NumberStripDigits;
+            cost.height = img.height / 10;
+            cost.pixelsPerFrame = Pixels(cost.width, cost.height);
+            if (img.height % 10 != 0) {
+                Add(Warning, location, "image height " + Str(img.height)
+                    + " is not a multiple of 10 digits");
+            }
+            CheckAlignment(meter, location);
+        }
+    }
+
+    if (parent.width > 0 && Outside(x, y, cost.width, cost.height,
+            parent.width, parent.height)) {
+        Add(Warning, location, Size(cost.width, cost.height) + " at ("
+            + Str(x) + ", " + Str(y) + ") extends outside the "
+            + Size(parent.width, parent.height) + " background");
+    }
+
+    return true;
+}
+
+void SkinCheck::CheckKnob(tinyxml2::XMLElement *slider,
+        const std::string &location, Cost &cost) {
+
+    if (slider == NULL) {
+        Add(Error, location, "missing <slider>");
+        return;
+    }
+
+    std::string knobLocation = location + "/slider";
+    std::string type = Lower(slider->Attribute("type"));
+    if (type.empty()) {
+        type = "vertical";
+    }
+    if (type != "vertical" && type != "horizontal") {
+        Add(Error, knobLocation, "type must be vertical or horizontal");
+    }
+
+    int x = slider->IntAttribute("x");
+    int y = slider->IntAttribute("y");
+    int width = slider->IntAttribute("width");
+    int height = slider->IntAttribute("height");
+    if (width <= 0 || height <= 0) {
+        Add(Warning, knobLocation, "track is " + Size(width, height));
+    } else if (cost.width > 0
+            && Outside(x, y, width, height, cost.width, cost.height)) {
+        Add(Warning, knobLocation, "track " + Size(width, height) + " at ("
+            + Str(x) + ", " + Str(y) + ") extends outside the "
+            + Size(cost.width, cost.height) + " background");
+    }
+
+    Image knob = ReadImage(slider, "image", knobLocation, true);
+    if (knob.found == false) {
+        return;
+    }
+
+    if ((type == "vertical" && knob.height > height)
+            || (type == "horizontal" && knob.width > width)) {
+        Add(Warning, knobLocation, "knob " + Size(knob.width, knob.height)
+            + " is larger than its " + Size(width, height) + " track");
+    }
+
+    MeterCost knobCost = {};
+    knobCost.type = "knob";
+    knobCost.width = knob.width;
+    knobCost.height = knob.height;
+    knobCost.frames = 1;
+    knobCost.bytes = Pixels(knob.width, knob.height) * 4;
+    knobCost.pixelsPerFrame = Pixels(knob.width, knob.height);
+
+    cost.bitmaps++;
+    cost.bytes += knobCost.bytes;
+    cost.pixelsPerFrame += knobCost.pixelsPerFrame;
+    cost.meters.push_back(knobCost);
+}
+
+void SkinCheck::CheckIconset(tinyxml2::XMLElement *iconset,
+        const std::string &location) {
+
+    if (iconset == NULL) {
+        return;
+    }
+
+    std::string iconLocation = location + "/iconset";
+    const char *loc = iconset->Attribute("location");
+    if (loc == NULL) {
+        Add(Warning, iconLocation, "missing location; no icons are loaded");
+        return;
+    }
+
+    std::vector<FileSystem::Entry> entries;
+    std::string dir = FileSystem::Resolve(_skinDir, loc);
+    if (FileSystem::List(dir, entries) == false) {
+        Add(Warning, iconLocation, "could not read " + dir);
+        return;
+    }
+
+    int icons = 0;
+    for (const FileSystem::Entry &entry : entries) {
+        std::string name = Lower(entry.name.c_str());
+        if (entry.directory == false && name.size() > 4
+                && name.compare(name.size() - 4, 4, ".ico") == 0) {
+            icons++;
+        }
+    }
+
+    if (icons == 0) {
+        Add(Warning, iconLocation, "no .ico files in " + dir);
+    }
+}
+
+void SkinCheck::CheckSound(tinyxml2::XMLElement *sound,
+        const std::string &location) {
+
+    if (sound == NULL) {
+        return;
+    }
+
+    const char *fileName = sound->Attribute("file");
+    if (fileName == NULL) {
+        Add(Warning, location + "/sound", "missing file; no sound is played");
+        return;
+    }
+
+    std::string path = FileSystem::Resolve(_skinDir, fileName);
+    if (FileSystem::IsFile(path) == false) {
+        Add(Error, location + "/sound", "file not found: " + path);
+    }
+}
+
+void SkinCheck::CheckColor(tinyxml2::XMLElement *element,
+        const std::string &location) {
+
+    const char *color = element->Attribute("color");
+    if (color != NULL) {
+        std::string c(color);
+        if (c.size() != 6 || c.find_first_not_of(
+                "0123456789abcdefABCDEF") != std::string::npos) {
+            Add(Warning, location, "color '" + c
+                + "' is not six hexadecimal digits");
+        }
+    }
+
+    int transparency = 255;
+    element->QueryIntAttribute("transparency", &transparency);
+    if (transparency < 0 || transparency > 255) {
+        Add(Warning, location, "transparency " + Str(transparency)
+            + " is outside 0-255");
+    }
+}
+
+void SkinCheck::CheckAlignment(tinyxml2::XMLElement *element,
+        const std::string &location) {
+
+    const char *align = element->Attribute("align");
+    if (align == NULL) {
+        return;
+    }
+
+    std::string a = Lower(align);
+    if (a != "left" && a != "right" && a != "center") {
+        Add(Warning, location, "align '" + std::string(align)
+            + "' is not left, right, or center; left is used");
+    }
+}
+
+SkinCheck::Image SkinCheck::ReadImage(tinyxml2::XMLElement *element,
+        const char *attrName, const std::string &location, bool required) {
+
+    Image img = {};
+    const char *fileName = element->Attribute(attrName);
+    if (fileName == NULL) {
+        if (required) {
+            Add(Error, location, std::string("missing ") + attrName);
+        }
+        return img;
+    }
+
+    std::string path = FileSystem::Resolve(_skinDir, fileName);
+    FILE *file = FileSystem::Open(path);
+    if (file == NULL) {
+        Add(Error, location, std::string(attrName) + " not found: " + path);
+        return img;
+    }
+
+    bool valid = ImageSize(file, img.width, img.height);
+    fclose(file);
+    if (valid == false) {
+        /* GDI+ reads other formats too, so the skin may still work; there
+         * is nothing to measure, though. */
+        Add(Warning, location, std::string(attrName)
+            + " is not a PNG or BMP image: " + path);
+        return img;
+    }
+
+    if (img.width <= 0 || img.height <= 0) {
+        Add(Error, location, std::string(attrName) + " is "
+            + Size(img.width, img.height) + ": " + path);
+        return img;
+    }
+
+    img.found = true;
+    return img;
+}
\ No newline at end of file
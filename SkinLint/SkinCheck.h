@@ -0,0 +1,145 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tinyxml2 {
+    class XMLElement;
+}
+
+/// <summary>
+/// Validates a skin without loading it into the program: the skin XML is
+/// checked against what Skin expects, referenced files are checked for
+/// existence, image dimensions are read from the file headers, and meter
+/// geometry is checked against the OSD background.
+/// <p>
+/// The check also estimates the cost of each OSD: the memory used by its
+/// decoded bitmaps (GDI+ stores them as 32 bpp ARGB) and the number of
+/// pixels composited each time the OSD is redrawn.
+/// </summary>
+class SkinCheck {
+public:
+    enum Severity {
+        Warning,
+        Error
+    };
+
+    struct Issue {
+        Severity severity;
+        std::string location;
+        std::string message;
+    };
+
+    struct MeterCost {
+        std::string type;
+        int x;
+        int y;
+        int units;
+        bool inverted;
+        bool smooth;
+        std::string align;
+        int imageWidth;
+        int imageHeight;
+
+        /// <summary>Size of the area drawn for a full meter.</summary>
+        int width;
+        int height;
+
+        /// <summary>Frames, digits, or glyphs in the meter bitmap.</summary>
+        int frames;
+
+        /// <summary>Tiles drawn for a full meter (tiled meters only).</summary>
+        int tiles;
+
+        /// <summary>
+        /// Microseconds taken to rasterize one frame, averaged over every
+        /// unit value (arcs only). Rasterized frames are kept, so this is
+        /// paid once per unit value.
+        /// </summary>
+        double rasterTime;
+
+        unsigned long long bytes;
+        unsigned long long pixelsPerFrame;
+    };
+
+    struct Cost {
+        std::string name;
+        int width;
+        int height;
+        int bitmaps;
+        unsigned long long bytes;
+        unsigned long long pixelsPerFrame;
+        std::vector<MeterCost> meters;
+    };
+
+    /// <summary>
+    /// Creates a checker for the skin in the given directory (which contains
+    /// skin.xml). Paths are UTF-8.
+    /// </summary>
+    SkinCheck(const std::string &skinDir);
+
+    /// <summary>
+    /// Runs the checks. Returns false if any errors were found.
+    /// </summary>
+    bool Run();
+
+    const std::vector<Issue> &Issues() const;
+    const std::vector<Cost> &Costs() const;
+    int Errors() const;
+    int Warnings() const;
+
+    /// <summary>Writes the issues and cost estimates as text.</summary>
+    void Report(std::ostream &out) const;
+
+    /// <summary>
+    /// Writes the regions each bitmap meter draws at a fixed set of values,
+    /// using the same layout code as the meters. Comparing the output before
+    /// and after a change to the draw path shows any change in what is
+    /// rendered.
+    /// </summary>
+    void ReportLayout(std::ostream &out) const;
+
+private:
+    struct Image {
+        bool found;
+        int width;
+        int height;
+    };
+
+    std::string _skinDir;
+    std::vector<Issue> _issues;
+    std::vector<Cost> _costs;
+
+    void Add(Severity severity, const std::string &location,
+        const std::string &message);
+
+    void CheckOSDs(tinyxml2::XMLElement *osds);
+    void CheckSliders(tinyxml2::XMLElement *sliders);
+    Cost CheckBackground(tinyxml2::XMLElement *element,
+        const std::string &location);
+    void CheckMeters(tinyxml2::XMLElement *parent,
+        const std::string &location, Cost &cost);
+    bool CheckMeter(tinyxml2::XMLElement *meter,
+        const std::string &location, const Cost &parent, MeterCost &cost);
+    void CheckKnob(tinyxml2::XMLElement *slider,
+        const std::string &location, Cost &cost);
+    void CheckIconset(tinyxml2::XMLElement *iconset,
+        const std::string &location);
+    void CheckSound(tinyxml2::XMLElement *sound,
+        const std::string &location);
+    void CheckAlignment(tinyxml2::XMLElement *element,
+        const std::string &location);
+    void CheckColor(tinyxml2::XMLElement *element,
+        const std::string &location);
+
+    /// <summary>
+    /// Reads the dimensions of the image named by the given attribute,
+    /// reporting an error if the attribute is missing (when required) or the
+    /// file does not exist.
+    /// </summary>
+    Image ReadImage(tinyxml2::XMLElement *element, const char *attrName,
+        const std::string &location, bool required);
+
+    std::string SkinPath(const char *relativePath) const;
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FileSystem.h"
+#include "SkinCheck.h"
+
+/// <summary>
+/// Checks skins without starting 3RVX. Each argument is either a skin
+/// directory (containing skin.xml) or a directory of skins, such as Skins\.
+/// With --layout, the regions drawn by each meter are printed instead of the
+/// issues and costs. Exits with a nonzero status if any skin has errors.
+/// </summary>
+int main(int argc, char *argv[]) {
+    bool layout = false;
+    std::vector<std::string> dirs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--layout") {
+            layout = true;
+        } else {
+            dirs.push_back(arg);
+        }
+    }
+
+    if (dirs.empty()) {
+        std::cerr << "Usage: SkinLint [--layout] "
+            "<skin or skins directory>...\n";
+        return 2;
+    }
+
+    std::vector<std::string> skins;
+    for (const std::string &dir : dirs) {
+        if (FileSystem::IsFile(FileSystem::Resolve(dir, "skin.xml"))) {
+            skins.push_back(dir);
+            continue;
+        }
+
+        std::vector<FileSystem::Entry> entries;
+        if (FileSystem::List(dir, entries) == false) {
+            std::cerr << "Could not read directory: " << dir << "\n";
+            return 2;
+        }
+
+        for (const FileSystem::Entry &entry : entries) {
+            std::string skinDir = FileSystem::Resolve(dir, entry.name);
+            if (entry.directory && FileSystem::IsFile(
+                    FileSystem::Resolve(skinDir, "skin.xml"))) {
+                skins.push_back(skinDir);
+            }
+        }
+    }
+
+    int errors = 0;
+    int warnings = 0;
+    for (const std::string &skinDir : skins) {
+        SkinCheck check(skinDir);
+        check.Run();
+        if (layout) {
+            check.ReportLayout(std::cout);
+        } else {
+            check.Report(std::cout);
+        }
+        std::cout << "\n";
+        errors += check.Errors();
+        warnings += check.Warnings();
+    }
+
+    std::cout << skins.size() << " skins, " << errors << " errors, "
+        << warnings << " warnings\n";
+    return (errors > 0) ? 1 : 0;
+}
\ No newline at end of file
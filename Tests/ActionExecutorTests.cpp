@@ -0,0 +1,168 @@
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "ActionExecutor.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// <summary>
+/// Stands in for the UI thread and its notification window: records how
+/// long the calls it makes into the executor block, and waits for the
+/// completion notifications the executor would post.
+/// </summary>
+class FakeUIThread {
+public:
+    FakeUIThread() :
+    _notifications(0),
+    _maxBlock(0) {
+
+    }
+
+    ActionExecutor::Notify Notifier() {
+        return [this]() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_notifications;
+            _cv.notify_all();
+        };
+    }
+
+    bool Submit(ActionExecutor &executor, const std::wstring &key,
+            ActionExecutor::Action action) {
+
+        Clock::time_point start = Clock::now();
+        bool queued = executor.Submit(key, action);
+        Record(start);
+        return queued;
+    }
+
+    std::vector<ActionExecutor::Result> Completed(ActionExecutor &executor) {
+        Clock::time_point start = Clock::now();
+        std::vector<ActionExecutor::Result> results = executor.Completed();
+        Record(start);
+        return results;
+    }
+
+    /// <summary>
+    /// Waits (up to a second) until the given number of notifications have
+    /// been received.
+    /// </summary>
+    bool WaitFor(int notifications) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, std::chrono::seconds(1), [&]() {
+            return _notifications >= notifications;
+        });
+    }
+
+    /// <summary>Longest time a single call blocked, in ms.</summary>
+    long long MaxBlock() const {
+        return _maxBlock;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int _notifications;
+    long long _maxBlock;
+
+    void Record(Clock::time_point start) {
+        long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - start).count();
+        if (ms > _maxBlock) {
+            _maxBlock = ms;
+        }
+    }
+};
+
+/// <summary>A launch that takes as long as a slow ShellExecute.</summary>
+ActionExecutor::Action SlowLaunch(bool success) {
+    return [success]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return success;
+    };
+}
+
+}
+
+TEST(ActionExecutorDoesNotBlockCaller) {
+    FakeUIThread ui;
+    ActionExecutor executor(ui.Notifier());
+
+    CHECK(ui.Submit(executor, L"notepad.exe", SlowLaunch(true)));
+    CHECK(ui.Submit(executor, L"missing.exe", SlowLaunch(false)));
+    CHECK(ui.Completed(executor).empty());
+    CHECK(ui.WaitFor(2));
+
+    std::vector<ActionExecutor::Result> results = ui.Completed(executor);
+    CHECK_EQUAL(2u, results.size());
+    for (ActionExecutor::Result &result : results) {
+        CHECK_EQUAL(result.key == L"notepad.exe", result.success);
+    }
+
+    /* Launches run on the pool, so the UI thread is never held up for
+     * the 200 ms each one takes. */
+    CHECK(ui.MaxBlock() < 50);
+}
+
+TEST(ActionExecutorIgnoresRepeatedLaunches) {
+    FakeUIThread ui;
+    ActionExecutor executor(ui.Notifier());
+    std::atomic<int> launches(0);
+    ActionExecutor::Action launch = [&launches]() {
+        ++launches;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return true;
+    };
+
+    CHECK(ui.Submit(executor, L"calc.exe", launch));
+    CHECK(ui.Submit(executor, L"calc.exe", launch) == false);
+    CHECK(executor.Busy(L"calc.exe"));
+    CHECK(ui.WaitFor(1));
+    CHECK(executor.Busy(L"calc.exe") == false);
+    CHECK_EQUAL(1, launches.load());
+
+    /* Once finished, it can be launched again */
+    CHECK(ui.Submit(executor, L"calc.exe", launch));
+    CHECK(ui.WaitFor(2));
+    CHECK_EQUAL(2, launches.load());
+}
+
+TEST(ActionExecutorReportsExceptions) {
+    FakeUIThread ui;
+    ActionExecutor executor(ui.Notifier(), 1);
+    CHECK(ui.Submit(executor, L"throws", []() -> bool {
+        throw std::runtime_error("launch failed");
+    }));
+    CHECK(ui.WaitFor(1));
+
+    std::vector<ActionExecutor::Result> results = ui.Completed(executor);
+    CHECK_EQUAL(1u, results.size());
+    CHECK(results.empty() || results[0].success == false);
+}
+
+TEST(ActionExecutorDiscardsQueuedOnDestruction) {
+    std::atomic<int> launches(0);
+    {
+        FakeUIThread ui;
+        ActionExecutor executor(ui.Notifier(), 1);
+        for (int i = 0; i < 5; ++i) {
+            ui.Submit(executor, std::to_wstring(i), [&launches]() {
+                ++launches;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return true;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    /* Only the running launch finishes */
+    CHECK_EQUAL(1, launches.load());
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "Test.h"
+
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "MeterWnd/ArcRasterizer.h"
+
+namespace {
+
+const float Pi = 3.14159265f;
+
+/// <summary>
+/// Retrieves the coverage of the pixel at the given angle (clockwise from
+/// the top, in degrees) and distance from the center.
+/// </summary>
+int Sample(const std::vector<unsigned char> &coverage, int size,
+        float angle, float radius) {
+
+    float a = angle * Pi / 180.0f;
+    int x = (int) floor(size / 2.0f + radius * sin(a));
+    int y = (int) floor(size / 2.0f - radius * cos(a));
+    return coverage[y * size + x];
+}
+
+std::vector<unsigned char> Rasterize(const ArcRasterizer &arc,
+        float fraction) {
+
+    std::vector<unsigned char> coverage(arc.Size() * arc.Size());
+    arc.Rasterize(fraction, &coverage[0]);
+    return coverage;
+}
+
+unsigned long long Sum(const std::vector<unsigned char> &coverage) {
+    unsigned long long sum = 0;
+    for (unsigned char c : coverage) {
+        sum += c;
+    }
+    return sum;
+}
+
+}
+
+TEST(ArcRasterizerEmptyAndFull) {
+    const int size = 100;
+    ArcRasterizer ring(size, 10.0f, 0.0f, 360.0f);
+    CHECK_EQUAL(size, ring.Size());
+
+    std::vector<unsigned char> empty = Rasterize(ring, 0.0f);
+    CHECK_EQUAL(0ULL, Sum(empty));
+
+    /* The whole ring is covered, and nothing inside or outside it */
+    std::vector<unsigned char> full = Rasterize(ring, 1.0f);
+    for (int angle = 0; angle < 360; angle += 15) {
+        CHECK_EQUAL(255, Sample(full, size, (float) angle, 45.0f));
+        CHECK_EQUAL(0, Sample(full, size, (float) angle, 30.0f));
+    }
+    CHECK_EQUAL(0, (int) full[0]);
+    CHECK_EQUAL(0, (int) full[size * size - 1]);
+
+    /* The anti-aliased area is close to the exact one */
+    double area = Sum(full) / 255.0;
+    double exact = Pi * (50.0 * 50.0 - 40.0 * 40.0);
+    CHECK(fabs(area - exact) < exact * 0.01);
+}
+
+TEST(ArcRasterizerGrowsWithFraction) {
+    ArcRasterizer arc(64, 8.0f, 225.0f, 270.0f);
+    unsigned long long last = 0;
+    for (int i = 0; i <= 20; ++i) {
+        unsigned long long sum = Sum(Rasterize(arc, i / 20.0f));
+        if (sum < last) {
+            Test::Fail(__FILE__, __LINE__, "coverage shrank at step "
+                + std::to_string(i));
+        }
+        last = sum;
+    }
+}
+
+TEST(ArcRasterizerConvexAndUnion) {
+    const int size = 100;
+    const float mid = 45.0f;
+
+    /* Up to 180 degrees, an arc is the intersection of the half-planes
+     * inside its start and end edges. */
+    ArcRasterizer quarter(size, 10.0f, 0.0f, 90.0f);
+    std::vector<unsigned char> q = Rasterize(quarter, 1.0f);
+    CHECK_EQUAL(255, Sample(q, size, 45.0f, mid));
+    CHECK_EQUAL(0, Sample(q, size, 135.0f, mid));
+    CHECK_EQUAL(0, Sample(q, size, 225.0f, mid));
+    CHECK_EQUAL(0, Sample(q, size, 315.0f, mid));
+
+    ArcRasterizer half(size, 10.0f, 0.0f, 180.0f);
+    std::vector<unsigned char> h = Rasterize(half, 1.0f);
+    CHECK_EQUAL(255, Sample(h, size, 45.0f, mid));
+    CHECK_EQUAL(255, Sample(h, size, 135.0f, mid));
+    CHECK_EQUAL(0, Sample(h, size, 225.0f, mid));
+    CHECK_EQUAL(0, Sample(h, size, 315.0f, mid));
+
+    /* Past 180 degrees, it is their union; the intersection would leave
+     * the middle of the arc empty. */
+    ArcRasterizer gauge(size, 10.0f, 0.0f, 270.0f);
+    std::vector<unsigned char> g = Rasterize(gauge, 1.0f);
+    CHECK_EQUAL(255, Sample(g, size, 45.0f, mid));
+    CHECK_EQUAL(255, Sample(g, size, 135.0f, mid));
+    CHECK_EQUAL(255, Sample(g, size, 225.0f, mid));
+    CHECK_EQUAL(0, Sample(g, size, 315.0f, mid));
+
+    /* The same arc filled to a third is convex again */
+    std::vector<unsigned char> t = Rasterize(gauge, 1.0f / 3.0f);
+    CHECK_EQUAL(255, Sample(t, size, 45.0f, mid));
+    CHECK_EQUAL(0, Sample(t, size, 135.0f, mid));
+    CHECK_EQUAL(0, Sample(t, size, 315.0f, mid));
+
+    /* Arcs can start anywhere, including past the top */
+    ArcRasterizer wrapped(size, 10.0f, 315.0f, 90.0f);
+    std::vector<unsigned char> w = Rasterize(wrapped, 1.0f);
+    CHECK_EQUAL(255, Sample(w, size, 0.0f, mid));
+    CHECK_EQUAL(0, Sample(w, size, 90.0f, mid));
+    CHECK_EQUAL(0, Sample(w, size, 270.0f, mid));
+}
+
+TEST(ArcRasterizerPie) {
+    const int size = 100;
+
+    /* A thickness of half the size or more fills in to the center */
+    const float thicknesses[] = { 50.0f, 80.0f };
+    for (float thickness : thicknesses) {
+        ArcRasterizer pie(size, thickness, 0.0f, 90.0f);
+        std::vector<unsigned char> p = Rasterize(pie, 1.0f);
+        CHECK_EQUAL(255, Sample(p, size, 45.0f, 5.0f));
+        CHECK_EQUAL(255, Sample(p, size, 45.0f, 25.0f));
+        CHECK_EQUAL(255, Sample(p, size, 45.0f, 45.0f));
+        CHECK_EQUAL(0, Sample(p, size, 225.0f, 25.0f));
+    }
+
+    ArcRasterizer disc(size, 50.0f, 0.0f, 360.0f);
+    std::vector<unsigned char> d = Rasterize(disc, 1.0f);
+    CHECK_EQUAL(255, (int) d[(size / 2) * size + size / 2]);
+    double area = Sum(d) / 255.0;
+    double exact = Pi * 50.0 * 50.0;
+    CHECK(fabs(area - exact) < exact * 0.01);
+}
+
+TEST(ArcRasterizerSizeClamped) {
+    /* A missing size attribute reads as zero; the rasterizer still has a
+     * pixel to draw into. */
+    ArcRasterizer zero(0, 0.0f, 0.0f, 360.0f);
+    CHECK_EQUAL(1, zero.Size());
+    ArcRasterizer negative(-5, 1.0f, 0.0f, 360.0f);
+    CHECK_EQUAL(1, negative.Size());
+    std::vector<unsigned char> coverage = Rasterize(negative, 1.0f);
+    CHECK_EQUAL(1, (int) coverage.size());
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "Test.h"
+
+/* The crash tests kill a child process, so these tests are POSIX-only. */
+#ifndef _WIN32
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <signal.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "AtomicWriter.h"
+#include "StringUtils.h"
+
+namespace {
+
+/// <summary>Creates an empty directory for a test's files.</summary>
+std::string TempDir() {
+    char dir[] = "/tmp/3RVXTestsXXXXXX";
+    if (mkdtemp(dir) == NULL) {
+        return "/tmp";
+    }
+    return dir;
+}
+
+std::string Read(const std::string &path) {
+    std::string contents;
+    FILE *stream = fopen(path.c_str(), "rb");
+    if (stream == NULL) {
+        return contents;
+    }
+
+    char buf[65536];
+    size_t read;
+    while ((read = fread(buf, 1, sizeof(buf), stream)) > 0) {
+        contents.append(buf, read);
+    }
+    fclose(stream);
+    return contents;
+}
+
+bool Exists(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+void Sleep(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+}
+
+TEST(AtomicWriterWrite) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+
+    CHECK(AtomicWriter::Write(wpath, "first"));
+    CHECK_EQUAL(std::string("first"), Read(path));
+    CHECK(AtomicWriter::Write(wpath, "second"));
+    CHECK_EQUAL(std::string("second"), Read(path));
+    CHECK(Exists(path + ".tmp") == false);
+}
+
+TEST(AtomicWriterFailedWriteKeepsPrevious) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+    CHECK(AtomicWriter::Write(wpath, "previous"));
+
+    /* The temporary file can't be created */
+    mkdir((path + ".tmp").c_str(), 0700);
+    CHECK(AtomicWriter::Write(wpath, "next") == false);
+    CHECK_EQUAL(std::string("previous"), Read(path));
+    rmdir((path + ".tmp").c_str());
+
+    /* A temporary file left behind by an earlier crash is replaced */
+    FILE *stale = fopen((path + ".tmp").c_str(), "wb");
+    fputs("partial", stale);
+    fclose(stale);
+    CHECK_EQUAL(std::string("previous"), Read(path));
+    CHECK(AtomicWriter::Write(wpath, "next"));
+    CHECK_EQUAL(std::string("next"), Read(path));
+}
+
+TEST(AtomicWriterKilledMidWrite) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+
+    /* Large enough that the write takes a few milliseconds */
+    const size_t size = 16 * 1024 * 1024;
+    std::string previous(size, 'a');
+    CHECK(AtomicWriter::Write(wpath, previous));
+
+    for (int i = 0; i < 20; ++i) {
+        std::string next(size, (char) ('b' + i));
+        pid_t child = fork();
+        if (child == 0) {
+            if (i % 2 == 0) {
+                AtomicWriter::Write(wpath, next);
+            } else {
+                AtomicWriter writer(0);
+                writer.Schedule(wpath, next);
+                writer.Flush();
+            }
+            _exit(0);
+        }
+
+        /* Kill the writer at a different point each time */
+        std::this_thread::sleep_for(std::chrono::microseconds(i * 500));
+        kill(child, SIGKILL);
+        int status;
+        waitpid(child, &status, 0);
+
+        std::string contents = Read(path);
+        if (contents != previous && contents != next) {
+            Test::Fail(__FILE__, __LINE__, "file corrupted after kill "
+                + std::to_string(i));
+            return;
+        }
+        previous = contents;
+    }
+}
+
+TEST(AtomicWriterDebounces) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+    std::atomic<int> calls(0);
+    std::atomic<int> successes(0);
+
+    AtomicWriter writer(50);
+    for (int i = 0; i < 10; ++i) {
+        writer.Schedule(wpath, std::to_string(i), [&](bool success) {
+            ++calls;
+            successes += success ? 1 : 0;
+        });
+    }
+
+    CHECK(Exists(path) == false);
+    Sleep(250);
+    CHECK_EQUAL(std::string("9"), Read(path));
+    CHECK_EQUAL(10, calls.load());
+    CHECK_EQUAL(10, successes.load());
+}
+
+TEST(AtomicWriterFlushWaitsForWriterThread) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+    std::atomic<bool> started(false);
+    std::atomic<bool> finished(false);
+
+    AtomicWriter writer(0);
+    writer.Schedule(wpath, "older", [&](bool) {
+        started = true;
+        Sleep(100);
+        finished = true;
+    });
+
+    while (started == false) {
+        Sleep(1);
+    }
+
+    /* The older contents are being written by the writer thread. Flush
+     * must wait for that write and its callback, and the newer contents
+     * must end up on disk. */
+    writer.Schedule(wpath, "newer");
+    CHECK(writer.Flush());
+    CHECK(finished.load());
+    CHECK_EQUAL(std::string("newer"), Read(path));
+}
+
+TEST(AtomicWriterDestructorFlushes) {
+    std::string path = TempDir() + "/Settings.xml";
+    std::wstring wpath = StringUtils::Widen(path);
+    {
+        AtomicWriter writer(10000);
+        writer.Schedule(wpath, "pending");
+    }
+    CHECK_EQUAL(std::string("pending"), Read(path));
+}
+
+TEST(AtomicWriterSchedulesDifferentFiles) {
+    std::string dir = TempDir();
+    AtomicWriter writer(10000);
+    writer.Schedule(StringUtils::Widen(dir + "/a.xml"), "a");
+    writer.Schedule(StringUtils::Widen(dir + "/b.xml"), "b");
+
+    /* The first file is written when the second is scheduled */
+    CHECK_EQUAL(std::string("a"), Read(dir + "/a.xml"));
+    CHECK(writer.Flush());
+    CHECK_EQUAL(std::string("b"), Read(dir + "/b.xml"));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "Test.h"
+
+#include "ElementIndex.h"
+#include "TinyXml2/tinyxml2.h"
+
+TEST(ElementIndexFind) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(
+        "<osds>"
+        "<volume units=\"1\"/><!-- x --><mute/>"
+        "<volume units=\"2\"/><eject/>"
+        "</osds>");
+
+    ElementIndex index;
+    index.Build(xml.FirstChildElement("osds"));
+    CHECK_EQUAL((size_t) 3, index.Size());
+
+    /* Only the first element with a given name is used */
+    tinyxml2::XMLElement *volume = index.Find("volume");
+    CHECK(volume != NULL);
+    CHECK_EQUAL(1, volume->IntAttribute("units"));
+
+    CHECK(index.Find("mute") == xml.FirstChildElement("osds")
+        ->FirstChildElement("mute"));
+    CHECK(index.Find("eject") != NULL);
+
+    /* Names are compared in full */
+    CHECK(index.Find("vol") == NULL);
+    CHECK(index.Find("volumes") == NULL);
+    CHECK(index.Find("") == NULL);
+}
+
+TEST(ElementIndexNoParent) {
+    ElementIndex index;
+    index.Build(NULL);
+    CHECK_EQUAL((size_t) 0, index.Size());
+    CHECK(index.Find("volume") == NULL);
+}
+
+TEST(ElementIndexRebuild) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse("<skin><osds><volume/></osds><sliders><knob/></sliders></skin>");
+    tinyxml2::XMLElement *skin = xml.FirstChildElement("skin");
+
+    ElementIndex index;
+    index.Build(skin->FirstChildElement("osds"));
+    index.Build(skin->FirstChildElement("sliders"));
+    CHECK_EQUAL((size_t) 1, index.Size());
+    CHECK(index.Find("volume") == NULL);
+    CHECK(index.Find("knob") != NULL);
+}
\ No newline at end of file
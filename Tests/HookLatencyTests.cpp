@@ -0,0 +1,96 @@
+#include "Test.h"
+
+#include <string>
+
+#include "HookLatency.h"
+
+TEST(HookLatencyBuckets) {
+    HookLatency latency;
+    latency.Record(0);
+    latency.Record(1);
+    latency.Record(3);
+    latency.Record(4);
+    latency.Record(1000);
+
+    CHECK_EQUAL(5u, latency.Samples());
+    CHECK_EQUAL(1u, latency.Count(0));
+    CHECK_EQUAL(1u, latency.Count(1));
+    CHECK_EQUAL(1u, latency.Count(2));
+    CHECK_EQUAL(1u, latency.Count(3));
+    CHECK_EQUAL(1u, latency.Count(10));
+    CHECK_EQUAL(0u, latency.Count(-1));
+    CHECK_EQUAL(0u, latency.Count(HookLatency::Buckets));
+    CHECK_EQUAL(1000ULL, latency.Max());
+
+    /* Samples beyond the last bucket are kept in it */
+    latency.Record(~0ULL);
+    CHECK_EQUAL(1u, latency.Count(HookLatency::Buckets - 1));
+}
+
+TEST(HookLatencyBudget) {
+    HookLatency latency(100);
+    CHECK_EQUAL(false, latency.Record(100));
+    CHECK_EQUAL(true, latency.Record(101));
+    CHECK_EQUAL(1u, latency.Exceeded());
+
+    latency.Budget(1000);
+    CHECK_EQUAL(1000u, latency.Budget());
+    CHECK_EQUAL(false, latency.Record(101));
+    CHECK_EQUAL(1u, latency.Exceeded());
+}
+
+TEST(HookLatencyBudgetIsFractionOfTimeout) {
+    /* Events exceeding the budget must be counted before they are slow
+     * enough for Windows to remove the hook */
+    CHECK(HookLatency::BudgetFor(300) < 300000u);
+    CHECK(HookLatency::BudgetFor(1000) < 1000000u);
+
+    unsigned int budget = HookLatency::DefaultBudget;
+    CHECK_EQUAL(budget, HookLatency::BudgetFor(HookLatency::DefaultTimeout));
+
+    HookLatency latency;
+    CHECK_EQUAL(budget, latency.Budget());
+    CHECK_EQUAL(true, latency.Record(HookLatency::DefaultTimeout * 1000ULL));
+}
+
+TEST(HookLatencyPercentile) {
+    HookLatency latency;
+    CHECK_EQUAL(0ULL, latency.Percentile(0.5));
+
+    for (int i = 0; i < 99; ++i) {
+        latency.Record(5);
+    }
+    latency.Record(5000);
+
+    /* The upper limit of the bucket each percentile falls in */
+    CHECK_EQUAL(8ULL, latency.Percentile(0.5));
+    CHECK_EQUAL(8ULL, latency.Percentile(0.99));
+    CHECK_EQUAL(8192ULL, latency.Percentile(1.0));
+}
+
+TEST(HookLatencyReset) {
+    HookLatency latency(10);
+    latency.Record(50);
+    latency.Reset();
+
+    CHECK_EQUAL(0u, latency.Samples());
+    CHECK_EQUAL(0u, latency.Exceeded());
+    CHECK_EQUAL(0ULL, latency.Max());
+    CHECK_EQUAL(0u, latency.Count(6));
+    CHECK_EQUAL(10u, latency.Budget());
+}
+
+TEST(HookLatencyToString) {
+    HookLatency latency(10);
+    latency.Record(3);
+    latency.Record(50);
+
+    std::wstring str = latency.ToString();
+    CHECK(str.find(L"Events: 2") != std::wstring::npos);
+    CHECK(str.find(L"over budget (10 us): 1") != std::wstring::npos);
+    CHECK(str.find(L"< 4 us: 1") != std::wstring::npos);
+    CHECK(str.find(L"< 64 us: 1") != std::wstring::npos);
+
+    /* Empty buckets are omitted */
+    CHECK(str.find(L"< 8 us") == std::wstring::npos);
+}
\ No newline at end of file
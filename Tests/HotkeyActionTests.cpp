@@ -0,0 +1,202 @@
+#include "Test.h"
+
+#include <string>
+
+#include "HotkeyAction.h"
+#include "HotkeyInfo.h"
+#include "HotkeyMatcher.h"
+
+namespace {
+
+HotkeyInfo Hotkey(int action, const wchar_t *arg0 = NULL,
+        const wchar_t *arg1 = NULL) {
+
+    HotkeyInfo hki;
+    hki.keyCombination = 0x8004D;
+    hki.action = action;
+    if (arg0 != NULL) {
+        hki.args.push_back(arg0);
+    }
+    if (arg1 != NULL) {
+        hki.args.push_back(arg1);
+    }
+    return hki;
+}
+
+}
+
+TEST(HotkeyActionVolumeUnits) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::IncreaseVolume, L"5");
+    HotkeyAction hka(hki);
+    CHECK(hki.Valid());
+    CHECK(hka.Valid());
+    CHECK_EQUAL(HotkeyInfo::Units, hka.volume.type);
+    CHECK_EQUAL(5, hka.volume.units);
+
+    /* Decreases are negative */
+    hki = Hotkey(HotkeyInfo::DecreaseVolume, L"3", L"0");
+    hka = HotkeyAction(hki);
+    CHECK_EQUAL(HotkeyInfo::Units, hka.volume.type);
+    CHECK_EQUAL(-3, hka.volume.units);
+
+    /* One unit by default */
+    hki = Hotkey(HotkeyInfo::DecreaseVolume);
+    hka = HotkeyAction(hki);
+    CHECK(hki.Valid());
+    CHECK_EQUAL(HotkeyInfo::Units, hka.volume.type);
+    CHECK_EQUAL(-1, hka.volume.units);
+}
+
+TEST(HotkeyActionVolumePercentage) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::IncreaseVolume, L"10", L"1");
+    HotkeyAction hka(hki);
+    CHECK(hki.Valid());
+    CHECK_EQUAL(HotkeyInfo::Percentage, hka.volume.type);
+    CHECK_EQUAL(0.1f, hka.volume.amount);
+
+    hki = Hotkey(HotkeyInfo::DecreaseVolume, L"25", L"1");
+    hka = HotkeyAction(hki);
+    CHECK_EQUAL(-0.25f, hka.volume.amount);
+}
+
+TEST(HotkeyActionSetVolume) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::SetVolume, L"50", L"1");
+    HotkeyAction hka(hki);
+    CHECK(hka.Valid());
+    CHECK_EQUAL(HotkeyInfo::Percentage, hka.volume.type);
+    CHECK_EQUAL(0.5f, hka.volume.amount);
+
+    hki = Hotkey(HotkeyInfo::SetVolume, L"0");
+    hka = HotkeyAction(hki);
+    CHECK(hki.Valid());
+    CHECK_EQUAL(HotkeyInfo::Units, hka.volume.type);
+    CHECK_EQUAL(0, hka.volume.units);
+
+    /* Nothing to set the volume to */
+    hki = Hotkey(HotkeyInfo::SetVolume);
+    hka = HotkeyAction(hki);
+    CHECK_EQUAL(HotkeyInfo::NoArgs, hka.volume.type);
+}
+
+TEST(HotkeyActionInvalidVolume) {
+    CHECK_EQUAL(false, Hotkey(HotkeyInfo::IncreaseVolume, L"101").Valid());
+    CHECK_EQUAL(false, Hotkey(HotkeyInfo::IncreaseVolume, L"-1").Valid());
+    CHECK_EQUAL(false, Hotkey(HotkeyInfo::SetVolume, L"").Valid());
+    CHECK_EQUAL(false,
+        Hotkey(HotkeyInfo::IncreaseVolume, L"5", L"3").Valid());
+
+    /* Unparseable amounts are treated as zero */
+    HotkeyInfo hki = Hotkey(HotkeyInfo::SetVolume, L"loud");
+    HotkeyAction hka(hki);
+    CHECK_EQUAL(0, hka.volume.units);
+}
+
+TEST(HotkeyActionNoArgs) {
+    const int actions[] = {
+        HotkeyInfo::Mute,
+        HotkeyInfo::VolumeSlider,
+        HotkeyInfo::EjectLastDisk,
+        HotkeyInfo::Settings,
+        HotkeyInfo::Exit,
+        HotkeyInfo::RecordTrace,
+    };
+
+    for (int action : actions) {
+        HotkeyInfo hki = Hotkey(action);
+        HotkeyAction hka(hki);
+        CHECK(hki.Valid());
+        CHECK(hka.Valid());
+        CHECK_EQUAL(action, (int) hka.action);
+        CHECK_EQUAL(0x8004D, hka.keyCombination);
+    }
+}
+
+TEST(HotkeyActionEjectDrive) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::EjectDrive, L"e");
+    HotkeyAction hka(hki);
+    CHECK(hki.Valid());
+    CHECK(hka.Valid());
+    CHECK_EQUAL(L'E', hka.drive);
+
+    hki = Hotkey(HotkeyInfo::EjectDrive, L"1");
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+
+    hki = Hotkey(HotkeyInfo::EjectDrive);
+    CHECK_EQUAL(false, hki.Valid());
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+}
+
+TEST(HotkeyActionMediaKey) {
+    for (unsigned int i = 0; i < HotkeyInfo::MediaKeyNames.size(); ++i) {
+        HotkeyInfo hki = Hotkey(HotkeyInfo::MediaKey,
+            HotkeyInfo::MediaKeyNames[i].c_str());
+        HotkeyAction hka(hki);
+        CHECK(hka.Valid());
+        CHECK_EQUAL(HotkeyInfo::MediaKeyVKs[i], hka.vk);
+    }
+
+    /* VK_MEDIA_NEXT_TRACK */
+    HotkeyInfo hki = Hotkey(HotkeyInfo::MediaKey, L"Next");
+    CHECK_EQUAL((unsigned short) 0xB0, HotkeyAction(hki).vk);
+
+    hki = Hotkey(HotkeyInfo::MediaKey, L"Rewind");
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+
+    hki = Hotkey(HotkeyInfo::MediaKey);
+    CHECK_EQUAL(false, hki.Valid());
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+}
+
+TEST(HotkeyActionVirtualKey) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::VirtualKey, L"AD");
+    HotkeyAction hka(hki);
+    CHECK(hka.Valid());
+    CHECK_EQUAL((unsigned short) 0xAD, hka.vk);
+
+    hki = Hotkey(HotkeyInfo::VirtualKey, L"zz");
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+
+    hki = Hotkey(HotkeyInfo::VirtualKey, L"AD", L"AE");
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+}
+
+TEST(HotkeyActionRun) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::Run, L"notepad.exe");
+    HotkeyAction hka(hki);
+    CHECK(hki.Valid());
+    CHECK(hka.Valid());
+    CHECK(hka.target == L"notepad.exe");
+
+    hki = Hotkey(HotkeyInfo::Run);
+    CHECK_EQUAL(false, hki.Valid());
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+}
+
+TEST(HotkeyActionInvalidAction) {
+    HotkeyInfo hki = Hotkey(-1);
+    CHECK_EQUAL(false, hki.Valid());
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+
+    hki = Hotkey((int) HotkeyInfo::ActionNames.size());
+    CHECK_EQUAL(false, hki.Valid());
+    CHECK_EQUAL(false, HotkeyAction(hki).Valid());
+
+    /* Every action has a name */
+    CHECK_EQUAL(HotkeyInfo::RecordTrace + 1,
+        (int) HotkeyInfo::ActionNames.size());
+
+    CHECK_EQUAL(false, HotkeyAction().Valid());
+}
+
+TEST(HotkeyInfoMouseSequence) {
+    HotkeyInfo hki = Hotkey(HotkeyInfo::Mute);
+    hki.sequence.push_back(0x26);
+    CHECK(hki.Valid());
+
+    /* Mouse buttons and the wheel can't be used in sequences */
+    hki.sequence.push_back(0x01);
+    CHECK_EQUAL(false, hki.Valid());
+
+    hki.sequence.back() = 0x1 << MOUSE_OFFSET;
+    CHECK_EQUAL(false, hki.Valid());
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "Test.h"
+
+#include <vector>
+
+#include "HotkeyCapture.h"
+#include "HotkeyMatcher.h"
+
+namespace {
+
+/* Windows values, which the matcher doesn't depend on */
+const int ModWin = 0x8 << MOD_OFFSET;
+const int ModCtrl = 0x2 << MOD_OFFSET;
+const int Consumed = HotkeyMatcher::Consumed;
+const unsigned int VkLWin = 0x5B;
+const unsigned int VkUp = 0x26;
+const unsigned int VkDown = 0x28;
+const unsigned int VkV = 0x56;
+const unsigned int VkM = 0x4D;
+
+const int WinV = ModWin | VkV;
+const int WinM = ModWin | VkM;
+const int Up = VkUp;
+const int Down = VkDown;
+
+std::vector<int> Steps(int first, int second) {
+    std::vector<int> steps;
+    steps.push_back(first);
+    steps.push_back(second);
+    return steps;
+}
+
+/// <summary>Presses and releases a key while Win is held.</summary>
+int PressWith(HotkeyMatcher &matcher, unsigned int vk, unsigned int time) {
+    matcher.KeyDown(VkLWin, false, ModWin, time);
+    int result = matcher.KeyDown(vk, false, 0, time);
+    matcher.KeyUp(vk, 0, time);
+    matcher.KeyUp(VkLWin, ModWin, time);
+    return result;
+}
+
+int Press(HotkeyMatcher &matcher, unsigned int vk, unsigned int time) {
+    int result = matcher.KeyDown(vk, false, 0, time);
+    matcher.KeyUp(vk, 0, time);
+    return result;
+}
+
+}
+
+TEST(HotkeyMatcherSingleCombination) {
+    HotkeyMatcher matcher;
+    matcher.Add(WinM);
+    CHECK(matcher.Contains(WinM));
+    CHECK(matcher.IsPrefix(WinM));
+
+    CHECK_EQUAL(WinM, PressWith(matcher, VkM, 0));
+    CHECK_EQUAL(0, Press(matcher, VkM, 10));
+    CHECK_EQUAL(0, matcher.KeyDown(VkM, false, 0, 20));
+    matcher.KeyUp(VkM, 0, 20);
+
+    /* Modifiers must match exactly */
+    matcher.KeyDown(VkLWin, false, ModWin, 30);
+    matcher.KeyDown(0xA2, false, ModCtrl, 30);
+    CHECK_EQUAL(0, matcher.KeyDown(VkM, false, 0, 30));
+}
+
+TEST(HotkeyMatcherSequence) {
+    HotkeyMatcher matcher;
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+    matcher.Add(Steps(WinV, Down), 0x1000002);
+
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 0));
+    CHECK_EQUAL(0x1000001, Press(matcher, VkUp, 100));
+
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 200));
+    CHECK_EQUAL(0x1000002, Press(matcher, VkDown, 300));
+
+    /* The second step alone does nothing */
+    CHECK_EQUAL(0, Press(matcher, VkUp, 400));
+}
+
+TEST(HotkeyMatcherSequenceTimeout) {
+    HotkeyMatcher matcher;
+    matcher.Timeout(500);
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 1000));
+
+    /* The prefix was swallowed, so it is replayed ahead of the next key */
+    CHECK_EQUAL(Consumed, Press(matcher, VkUp, 1501));
+    std::vector<int> replay = matcher.TakeReplay();
+    CHECK_EQUAL(2, (int) replay.size());
+    CHECK_EQUAL(WinV, replay[0]);
+    CHECK_EQUAL(Up, replay[1]);
+
+    /* Timestamps wrap around */
+    CHECK_EQUAL(Consumed,
+        PressWith(matcher, VkV, 0xFFFFFF00));
+    CHECK_EQUAL(0x1000001, Press(matcher, VkUp, 0x10));
+}
+
+TEST(HotkeyMatcherBrokenSequenceRestarts) {
+    HotkeyMatcher matcher;
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+    matcher.Add(WinM);
+
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 0));
+
+    /* A key that isn't the next step but starts another binding */
+    CHECK_EQUAL(WinM, PressWith(matcher, VkM, 10));
+    std::vector<int> replay = matcher.TakeReplay();
+    CHECK_EQUAL(1, (int) replay.size());
+    CHECK_EQUAL(WinV, replay[0]);
+
+    CHECK_EQUAL(0, Press(matcher, VkUp, 20));
+    CHECK(matcher.ReplayPending() == false);
+}
+
+TEST(HotkeyMatcherAbandonedSequenceIsReplayed) {
+    HotkeyMatcher matcher;
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 0));
+    CHECK(matcher.ReplayPending() == false);
+
+    /* Keys pressed before the replay is sent must follow it */
+    CHECK_EQUAL(Consumed, Press(matcher, VkM, 10));
+    CHECK(matcher.ReplayPending());
+    CHECK_EQUAL(Consumed, Press(matcher, VkDown, 20));
+
+    std::vector<int> replay = matcher.TakeReplay();
+    CHECK_EQUAL(3, (int) replay.size());
+    CHECK_EQUAL(WinV, replay[0]);
+    CHECK_EQUAL((int) VkM, replay[1]);
+    CHECK_EQUAL(Down, replay[2]);
+
+    /* Once sent, keys pass through again */
+    CHECK(matcher.ReplayPending() == false);
+    CHECK_EQUAL(0, Press(matcher, VkM, 30));
+    CHECK(matcher.TakeReplay().empty());
+
+    /* A completed sequence is never replayed */
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 40));
+    CHECK_EQUAL(0x1000001, Press(matcher, VkUp, 50));
+    CHECK(matcher.ReplayPending() == false);
+}
+
+TEST(HotkeyMatcherCombinationThatBeginsSequence) {
+    HotkeyMatcher matcher;
+    matcher.Add(WinV);
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+
+    CHECK_EQUAL(WinV, PressWith(matcher, VkV, 0));
+    CHECK_EQUAL(0x1000001, Press(matcher, VkUp, 10));
+}
+
+TEST(HotkeyMatcherHold) {
+    HotkeyMatcher matcher;
+    std::vector<int> steps(1, WinM);
+    matcher.Add(WinM);
+    matcher.Add(steps, 0x1000003, 500);
+
+    /* Tap: released before the hold time */
+    matcher.KeyDown(VkLWin, false, ModWin, 0);
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkM, false, 0, 0));
+    CHECK_EQUAL(WinM, matcher.KeyUp(VkM, 0, 100));
+
+    /* Hold: auto-repeat past the hold time fires once */
+    CHECK_EQUAL(Consumed,
+        matcher.KeyDown(VkM, false, 0, 1000));
+    CHECK_EQUAL(Consumed,
+        matcher.KeyDown(VkM, false, 0, 1300));
+    CHECK_EQUAL(0x1000003, matcher.KeyDown(VkM, false, 0, 1500));
+    CHECK_EQUAL(Consumed,
+        matcher.KeyDown(VkM, false, 0, 1600));
+    CHECK_EQUAL(Consumed, matcher.KeyUp(VkM, 0, 1700));
+    matcher.KeyUp(VkLWin, ModWin, 1700);
+}
+
+TEST(HotkeyMatcherHoldOnlyTapIsReplayed) {
+    HotkeyMatcher matcher;
+    std::vector<int> steps(1, WinM);
+    matcher.Add(steps, 0x1000003, 500);
+
+    /* The press is held back until it's known to be a tap... */
+    matcher.KeyDown(VkLWin, false, ModWin, 0);
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkM, false, 0, 0));
+    CHECK(matcher.ReplayPending() == false);
+
+    /* ...and then sent on, since only the hold is bound */
+    CHECK_EQUAL(Consumed, matcher.KeyUp(VkM, 0, 100));
+    std::vector<int> replay = matcher.TakeReplay();
+    CHECK_EQUAL(1, (int) replay.size());
+    CHECK_EQUAL(WinM, replay[0]);
+
+    /* A hold still fires and isn't replayed */
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkM, false, 0, 1000));
+    CHECK_EQUAL(0x1000003, matcher.KeyDown(VkM, false, 0, 1500));
+    CHECK_EQUAL(Consumed, matcher.KeyUp(VkM, 0, 1600));
+    CHECK(matcher.ReplayPending() == false);
+    matcher.KeyUp(VkLWin, ModWin, 1600);
+}
+
+TEST(HotkeyMatcherHoldInterruptedIsReplayed) {
+    HotkeyMatcher matcher;
+    std::vector<int> steps(1, WinM);
+    matcher.Add(steps, 0x1000003, 500);
+
+    matcher.KeyDown(VkLWin, false, ModWin, 0);
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkM, false, 0, 0));
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkV, false, 0, 100));
+
+    std::vector<int> replay = matcher.TakeReplay();
+    CHECK_EQUAL(2, (int) replay.size());
+    CHECK_EQUAL(WinM, replay[0]);
+    CHECK_EQUAL(WinV, replay[1]);
+}
+
+TEST(HotkeyMatcherHoldReleasedWithoutRepeat) {
+    HotkeyMatcher matcher;
+    std::vector<int> steps(1, WinM);
+    matcher.Add(steps, 0x1000003, 500);
+
+    /* No auto-repeat arrived, but the key was held long enough */
+    matcher.KeyDown(VkLWin, false, ModWin, 0);
+    CHECK_EQUAL(Consumed, matcher.KeyDown(VkM, false, 0, 0));
+    CHECK_EQUAL(0x1000003, matcher.KeyUp(VkM, 0, 600));
+    CHECK(matcher.ReplayPending() == false);
+}
+
+TEST(HotkeyMatcherRemoveSequence) {
+    HotkeyMatcher matcher;
+    matcher.Add(WinM);
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+    CHECK(matcher.IsPrefix(WinV));
+
+    matcher.Remove(0x1000001);
+    CHECK(matcher.Contains(0x1000001) == false);
+    CHECK(matcher.IsPrefix(WinV) == false);
+
+    /* The first step of the removed sequence must pass through */
+    CHECK_EQUAL(0, PressWith(matcher, VkV, 0));
+    CHECK_EQUAL(0, Press(matcher, VkUp, 10));
+
+    /* Other bindings are unaffected */
+    CHECK_EQUAL(WinM, PressWith(matcher, VkM, 20));
+}
+
+TEST(HotkeyMatcherRemoveSharedPrefix) {
+    HotkeyMatcher matcher;
+    matcher.Add(Steps(WinV, Up), 0x1000001);
+    matcher.Add(Steps(WinV, Down), 0x1000002);
+
+    matcher.Remove(0x1000001);
+    CHECK(matcher.IsPrefix(WinV));
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 0));
+
+    /* No longer a sequence; both keys are sent on */
+    CHECK_EQUAL(Consumed, Press(matcher, VkUp, 10));
+    CHECK_EQUAL(2, (int) matcher.TakeReplay().size());
+    CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 20));
+    CHECK_EQUAL(0x1000002, Press(matcher, VkDown, 30));
+
+    matcher.Remove(0x1000002);
+    CHECK(matcher.Empty());
+    CHECK_EQUAL(0, PressWith(matcher, VkV, 40));
+}
+
+TEST(HotkeyMatcherRemoveHold) {
+    HotkeyMatcher matcher;
+    std::vector<int> steps(1, WinM);
+    matcher.Add(WinM);
+    matcher.Add(steps, 0x1000003, 500);
+    matcher.Remove(0x1000003);
+
+    /* Without its hold variant, the combination fires on press again */
+    CHECK_EQUAL(WinM, PressWith(matcher, VkM, 0));
+}
+
+TEST(HotkeyMatcherReregister) {
+    /* Settings reloads unregister and register everything again */
+    HotkeyMatcher matcher;
+    for (int i = 0; i < 3; ++i) {
+        matcher.Add(Steps(WinV, Up), 0x1000001 + i);
+        CHECK_EQUAL(Consumed, PressWith(matcher, VkV, 0));
+        CHECK_EQUAL(0x1000001 + i, Press(matcher, VkUp, 10));
+        matcher.Remove(0x1000001 + i);
+        CHECK_EQUAL(0, PressWith(matcher, VkV, 20));
+    }
+}
+
+TEST(HotkeyCaptureSequence) {
+    HotkeyCapture capture;
+    CHECK_EQUAL(false, capture.KeyDown(WinV, 0));
+    CHECK_EQUAL(false, capture.KeyDown(Up, 300));
+    CHECK_EQUAL(WinV, capture.KeyCombination());
+    CHECK_EQUAL(1, (int) capture.Sequence().size());
+    CHECK_EQUAL(Up, capture.Sequence()[0]);
+    CHECK_EQUAL(0u, capture.HoldTime());
+}
+
+TEST(HotkeyCaptureSlowPressIsNotHold) {
+    HotkeyCapture capture;
+
+    /* Auto-repeat for a key held a little longer than the hold time */
+    CHECK_EQUAL(false, capture.KeyDown(WinM, 0));
+    for (unsigned int t = 500; t <= 800; t += 30) {
+        CHECK_EQUAL(false, capture.KeyDown(WinM, t));
+    }
+    capture.KeyUp(VkM);
+
+    CHECK_EQUAL(WinM, capture.KeyCombination());
+    CHECK(capture.Sequence().empty());
+    CHECK_EQUAL(0u, capture.HoldTime());
+}
+
+TEST(HotkeyCaptureHold) {
+    HotkeyCapture capture;
+    CHECK_EQUAL(false, capture.KeyDown(WinV, 0));
+    CHECK_EQUAL(false, capture.KeyDown(Up, 100));
+
+    /* Auto-repeat until the key has been held long enough */
+    unsigned int t = 600;
+    while (capture.KeyDown(Up, t) == false) {
+        t += 100;
+        CHECK(t <= 100 + HotkeyCapture::HoldCaptureTime);
+    }
+    CHECK_EQUAL(100 + HotkeyCapture::HoldCaptureTime, t);
+
+    unsigned int holdTime = HotkeyMatcher::DefaultHoldTime;
+    CHECK_EQUAL(holdTime, capture.HoldTime());
+    CHECK_EQUAL(1, (int) capture.Sequence().size());
+
+    /* Pressing the same key again after releasing it is a new step */
+    capture.Reset();
+    capture.KeyDown(Up, 0);
+    capture.KeyUp(VkUp);
+    CHECK_EQUAL(false, capture.KeyDown(Up, 2000));
+    CHECK_EQUAL(1, (int) capture.Sequence().size());
+}
+
+TEST(HotkeyCaptureMouse) {
+    HotkeyCapture capture;
+    capture.Mouse(ModCtrl | 0x01);
+    CHECK_EQUAL(ModCtrl | 0x01, capture.KeyCombination());
+
+    /* A key combination captured first is kept */
+    capture.Reset();
+    capture.KeyDown(WinM, 0);
+    capture.Mouse(ModCtrl | 0x01);
+    CHECK_EQUAL(WinM, capture.KeyCombination());
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "Test.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "HotkeyProfiles.h"
+
+namespace {
+
+/// <summary>
+/// Foreground source with a fixed set of windows and processes that counts
+/// the (expensive) process path lookups.
+/// </summary>
+class FakeProcessSource : public ProcessSource {
+public:
+    FakeProcessSource() :
+    lookups(0) {
+
+    }
+
+    virtual unsigned long ProcessId(void *window) {
+        auto it = windows.find(window);
+        return (it == windows.end()) ? 0 : it->second;
+    }
+
+    virtual std::wstring ProcessPath(unsigned long pid) {
+        lookups++;
+        return paths[pid];
+    }
+
+    std::map<void *, unsigned long> windows;
+    std::map<unsigned long, std::wstring> paths;
+    int lookups;
+};
+
+void *Window(int handle) {
+    return (void *) (size_t) handle;
+}
+
+HotkeyInfo Hotkey(int keys, int action) {
+    HotkeyInfo hki;
+    hki.keyCombination = keys;
+    hki.action = action;
+    return hki;
+}
+
+std::vector<HotkeyInfo> Global() {
+    std::vector<HotkeyInfo> global;
+    global.push_back(Hotkey(0x80026, HotkeyInfo::IncreaseVolume));
+    global.push_back(Hotkey(0x80028, HotkeyInfo::DecreaseVolume));
+    global.push_back(Hotkey(0x8004D, HotkeyInfo::Mute));
+    return global;
+}
+
+std::vector<HotkeyProfile> Profiles() {
+    HotkeyProfile vlc;
+    vlc.process = L"C:\\Program Files\\VideoLAN\\VLC\\VLC.exe";
+    vlc.hotkeys.push_back(Hotkey(0x80026, HotkeyInfo::MediaKey));
+    vlc.disabled.push_back(Hotkey(0x8004D, -1));
+
+    std::vector<HotkeyProfile> profiles;
+    profiles.push_back(vlc);
+    return profiles;
+}
+
+}
+
+TEST(HotkeyProfilesProcessName) {
+    CHECK(HotkeyProfiles::ProcessName(L"C:\\Tools\\VLC.EXE") == L"vlc.exe");
+    CHECK(HotkeyProfiles::ProcessName(L"/usr/bin/vlc") == L"vlc");
+    CHECK(HotkeyProfiles::ProcessName(L"vlc.exe") == L"vlc.exe");
+}
+
+TEST(HotkeyProfilesMerge) {
+    FakeProcessSource source;
+    source.windows[Window(1)] = 100;
+    source.paths[100] = L"C:\\VLC\\vlc.exe";
+
+    HotkeyProfiles profiles(&source);
+    profiles.Load(Global(), Profiles());
+    CHECK_EQUAL(3, (int) profiles.Active().size());
+    CHECK(profiles.ActiveProfile().empty());
+
+    CHECK(profiles.Foreground(Window(1)));
+    CHECK(profiles.ActiveProfile() == L"vlc.exe");
+
+    /* Up is overridden, Down is kept, and M is disabled */
+    const std::vector<HotkeyInfo> &active = profiles.Active();
+    CHECK_EQUAL(2, (int) active.size());
+    CHECK_EQUAL(0x80028, active[0].keyCombination);
+    CHECK_EQUAL((int) HotkeyInfo::DecreaseVolume, active[0].action);
+    CHECK_EQUAL(0x80026, active[1].keyCombination);
+    CHECK_EQUAL((int) HotkeyInfo::MediaKey, active[1].action);
+}
+
+TEST(HotkeyProfilesForegroundIsCached) {
+    FakeProcessSource source;
+    source.windows[Window(1)] = 100;
+    source.windows[Window(2)] = 200;
+    source.paths[100] = L"C:\\VLC\\vlc.exe";
+    source.paths[200] = L"C:\\Windows\\explorer.exe";
+
+    HotkeyProfiles profiles(&source);
+    profiles.Load(Global(), Profiles());
+
+    CHECK(profiles.Foreground(Window(1)));
+    CHECK(profiles.Foreground(Window(2)));
+    CHECK_EQUAL(false, profiles.Foreground(Window(2)));
+    CHECK_EQUAL(2, source.lookups);
+
+    for (int i = 0; i < 10; ++i) {
+        profiles.Foreground(Window(1 + i % 2));
+    }
+    CHECK_EQUAL(2, source.lookups);
+}
+
+TEST(HotkeyProfilesReusedWindowHandle) {
+    FakeProcessSource source;
+    source.windows[Window(1)] = 100;
+    source.paths[100] = L"C:\\VLC\\vlc.exe";
+    source.paths[300] = L"C:\\Windows\\notepad.exe";
+
+    HotkeyProfiles profiles(&source);
+    profiles.Load(Global(), Profiles());
+    CHECK(profiles.Foreground(Window(1)));
+
+    /* VLC exits and its window handle is reused by another program */
+    source.windows[Window(1)] = 300;
+    CHECK(profiles.Foreground(Window(1)));
+    CHECK(profiles.ActiveProfile().empty());
+    CHECK_EQUAL(2, source.lookups);
+
+    /* A window that no longer exists has no profile */
+    source.windows.erase(Window(1));
+    CHECK_EQUAL(false, profiles.Foreground(Window(1)));
+    CHECK_EQUAL(2, source.lookups);
+}
+
+TEST(HotkeyProfilesCacheIsBounded) {
+    FakeProcessSource source;
+    unsigned int windows = HotkeyProfiles::MaxCachedWindows + 1;
+    for (unsigned int i = 1; i <= windows; ++i) {
+        source.windows[Window(i)] = 1000 + i;
+    }
+
+    HotkeyProfiles profiles(&source);
+    profiles.Load(Global(), Profiles());
+    for (unsigned int i = 1; i <= windows; ++i) {
+        profiles.Foreground(Window(i));
+    }
+    CHECK_EQUAL((int) windows, source.lookups);
+
+    /* The first window was flushed along with the rest of the cache */
+    profiles.Foreground(Window(1));
+    CHECK_EQUAL((int) windows + 1, source.lookups);
+}
+
+TEST(HotkeyProfilesEmpty) {
+    FakeProcessSource source;
+    source.windows[Window(1)] = 100;
+
+    HotkeyProfiles profiles(&source);
+    profiles.Load(Global(), std::vector<HotkeyProfile>());
+    CHECK(profiles.Empty());
+
+    /* Without profiles, nothing is looked up */
+    CHECK_EQUAL(false, profiles.Foreground(Window(1)));
+    CHECK_EQUAL(0, source.lookups);
+    CHECK_EQUAL(3, (int) profiles.Active().size());
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+/* Built without _DEBUG or FORCE_3RVX_LOG, like a release build. */
+#include "Test.h"
+
+#include "Logger.h"
+
+namespace {
+
+int evaluations = 0;
+
+int Evaluate() {
+    ++evaluations;
+    return evaluations;
+}
+
+}
+
+TEST(LoggerCompiledOutSkipsArguments) {
+#if ENABLE_3RVX_LOG == 0
+    Logger::Level(Logger::Debug);
+    Logger::EnableSubsystems(L"all");
+
+    /* Every subsystem is enabled at runtime, but the log sites are removed
+     * at compile time. */
+    evaluations = 0;
+    CLOG(L"Not logged: %d", Evaluate());
+    QCLOG(L"Not logged: %d", Evaluate());
+    CHECK_EQUAL(0, evaluations);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+/* Log sites in this file are compiled in even in release builds so the
+ * runtime subsystem and level checks can be tested. */
+#define FORCE_3RVX_LOG
+#define LOG_SUBSYSTEM Audio
+
+#include "Test.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <string>
+#include <thread>
+
+#include "LogQueue.h"
+#include "Logger.h"
+
+namespace {
+
+int evaluations = 0;
+
+int Evaluate() {
+    ++evaluations;
+    return evaluations;
+}
+
+bool Push(LogQueue &queue, int level, const wchar_t *format, ...) {
+    va_list args;
+    va_start(args, format);
+    bool pushed = queue.Push(level, NULL, 0, format, args);
+    va_end(args);
+    return pushed;
+}
+
+void Format(LogQueue::Record &record, int level, const wchar_t *format, ...) {
+    va_list args;
+    va_start(args, format);
+    LogQueue::Format(record, level, NULL, 0, format, args);
+    va_end(args);
+}
+
+}
+
+TEST(LoggerDisabledSubsystemSkipsArguments) {
+    Logger::Level(Logger::Debug);
+    Logger::EnableSubsystems(L"hotkeys, osd");
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Error) == false);
+    CHECK(Logger::Enabled(Logger::Hotkeys, Logger::Info));
+
+    evaluations = 0;
+    CLOG(L"Not logged: %d", Evaluate());
+    QCLOG(L"Not logged: %d", Evaluate());
+    CHECK_EQUAL(0, evaluations);
+
+    Logger::EnableSubsystems(L"Audio");
+    CLOG(L"Logged: %d", Evaluate());
+    CHECK_EQUAL(1, evaluations);
+
+    Logger::EnableSubsystems(L"");
+}
+
+TEST(LoggerLevelSkipsArguments) {
+    Logger::EnableSubsystems(L"all");
+    Logger::Level(Logger::Warning);
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Info) == false);
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Warning));
+
+    evaluations = 0;
+    CLOG(L"Not logged: %d", Evaluate());
+    CHECK_EQUAL(0, evaluations);
+
+    Logger::Level(Logger::Debug);
+}
+
+TEST(LoggerLevelMacros) {
+    Logger::EnableSubsystems(L"all");
+    Logger::Level(Logger::Warning);
+
+    evaluations = 0;
+    DLOG(L"Not logged: %d", Evaluate());
+    CLOG(L"Not logged: %d", Evaluate());
+    CHECK_EQUAL(0, evaluations);
+
+    WLOG(L"Logged: %d", Evaluate());
+    ELOG(L"Logged: %d", Evaluate());
+    CHECK_EQUAL(2, evaluations);
+
+    Logger::Level(Logger::None);
+    ELOG(L"Not logged: %d", Evaluate());
+    CHECK_EQUAL(2, evaluations);
+
+    Logger::Level(Logger::Debug);
+    DLOG(L"Logged: %d", Evaluate());
+    CHECK_EQUAL(3, evaluations);
+}
+
+TEST(LoggerLevelByName) {
+    Logger::EnableSubsystems(L"all");
+
+    CHECK(Logger::Level(L"Warning"));
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Info) == false);
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Warning));
+
+    CHECK(Logger::Level(L" error "));
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Warning) == false);
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Error));
+
+    /* Unknown names leave the level alone */
+    CHECK(Logger::Level(L"verbose") == false);
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Warning) == false);
+
+    CHECK(Logger::Level(L"none"));
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Error) == false);
+
+    CHECK(Logger::Level(L""));
+    CHECK(Logger::Enabled(Logger::Audio, Logger::Debug));
+}
+
+TEST(LoggerPrefix) {
+    CHECK(Logger::Prefix(12345, Logger::Warning) == L"     12.345 WARN ");
+    CHECK(Logger::Prefix(5, Logger::Error) == L"      0.005 ERROR");
+    CHECK(Logger::Prefix(0, Logger::Debug) == L"      0.000 DEBUG");
+    CHECK(Logger::Prefix(3600000, Logger::Info) == L"   3600.000 INFO ");
+    CHECK(Logger::Prefix(0, -1) == L"      0.000 ?    ");
+}
+
+TEST(LogQueueTimestamps) {
+    LogQueue queue(4);
+    CHECK(Push(queue, Logger::Warning, L"first %d", 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(Push(queue, Logger::Error, L"second %d", 2));
+
+    LogQueue::Record first, second;
+    CHECK(queue.Pop(first));
+    CHECK(queue.Pop(second));
+    CHECK_EQUAL((int) Logger::Warning, first.level);
+    CHECK_EQUAL((int) Logger::Error, second.level);
+    CHECK(first.text == std::wstring(L"first 1"));
+    CHECK(second.time >= first.time + 20);
+
+    /* Records written directly are on the same clock */
+    LogQueue::Record direct;
+    Format(direct, Logger::Info, L"direct");
+    CHECK(direct.time >= second.time);
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "Test.h"
+
+#include <math.h>
+#include <string>
+
+#include "MeterWnd/MeterLayout.h"
+
+TEST(MeterLayoutPercentRounds) {
+    for (int units = 1; units <= 100; ++units) {
+        int last = -1;
+        for (int drawn = 0; drawn <= units; ++drawn) {
+            int expected = (int) floor(100.0 * drawn / units + 0.5);
+            int perc = MeterLayout::Percent(units, drawn);
+            if (perc != expected) {
+                Test::Fail(__FILE__, __LINE__, "Percent(" + std::to_string(
+                    units) + ", " + std::to_string(drawn) + ") = "
+                    + std::to_string(perc));
+            }
+            CHECK(perc > last);
+            last = perc;
+        }
+        CHECK_EQUAL(0, MeterLayout::Percent(units, 0));
+        CHECK_EQUAL(100, MeterLayout::Percent(units, units));
+    }
+}
+
+TEST(MeterLayoutUnitsRoundTrip) {
+    for (int units = 1; units <= 100; ++units) {
+        for (int drawn = 0; drawn <= units; ++drawn) {
+            float value = (float) drawn / units;
+            CHECK_EQUAL(drawn, MeterLayout::Units(value, units));
+        }
+    }
+}
+
+TEST(MeterLayoutNumberStrip) {
+    const int charWidth = 12;
+    const int charHeight = 20;
+    MeterLayout::Rect image = { 30, 40, charWidth, charHeight * 10 };
+    const MeterLayout::Alignment aligns[] = {
+        MeterLayout::Near, MeterLayout::Center, MeterLayout::Far
+    };
+
+    for (int units = 1; units <= 100; ++units) {
+        for (int drawn = 0; drawn <= units; ++drawn) {
+            std::string number = std::to_string(
+                MeterLayout::Percent(units, drawn));
+            int chars = (int) number.size();
+
+            for (MeterLayout::Alignment align : aligns) {
+                MeterLayout::Blit blits[MeterLayout::MaxDigits];
+                int count = MeterLayout::NumberStrip(
+                    image, units, drawn, align, blits);
+                CHECK_EQUAL(chars, count);
+                if (count != chars) {
+                    continue;
+                }
+
+                /* Legacy offsets of the least significant digit: 'center'
+                 * right-aligns the number, and 'right' centers it. */
+                int lastX = image.x + charWidth * 2;
+                if (align == MeterLayout::Near) {
+                    lastX = image.x + (chars - 1) * charWidth;
+                } else if (align == MeterLayout::Far) {
+                    lastX = image.x + charWidth * 2
+                        - (3 - chars) * (charWidth / 2);
+                }
+
+                for (int i = 0; i < count; ++i) {
+                    int digit = number[chars - 1 - i] - '0';
+                    const MeterLayout::Blit &blit = blits[i];
+                    CHECK_EQUAL(0, blit.src.x);
+                    CHECK_EQUAL(digit * charHeight, blit.src.y);
+                    CHECK_EQUAL(charWidth, blit.src.width);
+                    CHECK_EQUAL(charHeight, blit.src.height);
+                    CHECK_EQUAL(lastX - i * charWidth, blit.dest.x);
+                    CHECK_EQUAL(image.y, blit.dest.y);
+                }
+            }
+        }
+    }
+}
+
+TEST(MeterLayoutSmoothStateMonotonic) {
+    const int lengths[] = { 1, 2, 13, 144, 255, 256, 1000 };
+    for (int length : lengths) {
+        CHECK_EQUAL(0, MeterLayout::SmoothState(0.0f, length));
+        CHECK_EQUAL(length * 256, MeterLayout::SmoothState(1.0f, length));
+
+        /* Out of range values are clamped */
+        CHECK_EQUAL(0, MeterLayout::SmoothState(-0.5f, length));
+        CHECK_EQUAL(length * 256, MeterLayout::SmoothState(1.5f, length));
+
+        int last = -1;
+        for (int i = 0; i <= 10000; ++i) {
+            int state = MeterLayout::SmoothState(i / 10000.0f, length);
+            if (state < last) {
+                Test::Fail(__FILE__, __LINE__, "SmoothState decreased at "
+                    + std::to_string(i) + " for length "
+                    + std::to_string(length));
+                break;
+            }
+            last = state;
+        }
+    }
+}
+
+TEST(MeterLayoutSmoothSweepRedraws) {
+    /* The Classic skin's bar: 16 units over 144 pixels, swept from 0 to 1
+     * in 1000 steps. */
+    const int steps = 1000;
+    int unitRedraws = 0;
+    int smoothRedraws = 0;
+    int units = -1;
+    int state = -1;
+    for (int i = 0; i <= steps; ++i) {
+        float value = (float) i / steps;
+        if (MeterLayout::Units(value, 16) != units) {
+            units = MeterLayout::Units(value, 16);
+            unitRedraws++;
+        }
+        if (MeterLayout::SmoothState(value, 144) != state) {
+            state = MeterLayout::SmoothState(value, 144);
+            smoothRedraws++;
+        }
+    }
+    CHECK_EQUAL(17, unitRedraws);
+    CHECK_EQUAL(steps + 1, smoothRedraws);
+}
+
+TEST(MeterLayoutSmoothVerticalBar) {
+    MeterLayout::Rect image = { 5, 30, 8, 16 };
+
+    /* 6.5 rows: six full rows at the bottom, and the row above them at half
+     * coverage. */
+    MeterLayout::SmoothBlit blit = MeterLayout::SmoothVerticalBar(
+        image, 13.0f / 32.0f);
+    CHECK_EQUAL(128, blit.coverage);
+    CHECK_EQUAL(10, blit.full.src.y);
+    CHECK_EQUAL(6, blit.full.src.height);
+    CHECK_EQUAL(8, blit.full.src.width);
+    CHECK_EQUAL(image.y + 10, blit.full.dest.y);
+    CHECK_EQUAL(9, blit.edge.src.y);
+    CHECK_EQUAL(1, blit.edge.src.height);
+    CHECK_EQUAL(image.y + 9, blit.edge.dest.y);
+    CHECK_EQUAL(image.x, blit.edge.dest.x);
+
+    /* Empty and full bars have no edge */
+    blit = MeterLayout::SmoothVerticalBar(image, 0.0f);
+    CHECK_EQUAL(0, blit.full.src.height);
+    CHECK_EQUAL(0, blit.edge.src.height);
+    CHECK_EQUAL(0, blit.coverage);
+    blit = MeterLayout::SmoothVerticalBar(image, 1.0f);
+    CHECK_EQUAL(0, blit.full.src.y);
+    CHECK_EQUAL(16, blit.full.src.height);
+    CHECK_EQUAL(0, blit.edge.src.height);
+
+    /* The edge row is always directly above the full rows, inside the
+     * image, and drawn where it is copied from. */
+    for (int i = 0; i <= 1000; ++i) {
+        blit = MeterLayout::SmoothVerticalBar(image, i / 1000.0f);
+        const MeterLayout::Rect &edge = blit.edge.src;
+        CHECK_EQUAL(blit.full.src.y, edge.y + edge.height);
+        CHECK(edge.y >= 0);
+        CHECK_EQUAL(image.y + edge.y, blit.edge.dest.y);
+        CHECK_EQUAL(blit.coverage > 0 ? 1 : 0, edge.height);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "Test.h"
+
+#include "SettingsChanges.h"
+
+TEST(SettingsChangesAffectedMatrix) {
+    struct Row {
+        const char *setting;
+        int subsystems;
+    };
+
+    const Row matrix[] = {
+        { "audioDeviceID", SettingsChanges::OSDs },
+        { "hideAnimation", SettingsChanges::WindowBehavior },
+        { "hideDelay", SettingsChanges::WindowBehavior },
+        { "hideFullscreen", SettingsChanges::None },
+        { "hideSpeed", SettingsChanges::WindowBehavior },
+        { "hotkeys", SettingsChanges::Hotkeys },
+        { "language", SettingsChanges::OSDs },
+        { "logLevel", SettingsChanges::None },
+        { "logging", SettingsChanges::None },
+        { "monitor", SettingsChanges::OSDs },
+        { "notifyIcon", SettingsChanges::OSDs },
+        { "onTop", SettingsChanges::WindowBehavior },
+        { "osdEdgeOffset", SettingsChanges::WindowPosition },
+        { "osdPosition", SettingsChanges::WindowPosition },
+        { "osdX", SettingsChanges::WindowPosition },
+        { "osdY", SettingsChanges::WindowPosition },
+        { "profiles", SettingsChanges::Hotkeys },
+        { "skin", SettingsChanges::OSDs },
+        { "soundEffects", SettingsChanges::OSDs },
+
+        /* Anything unrecognized is treated as affecting everything */
+        { "someFutureSetting", SettingsChanges::All },
+        { "HideDelay", SettingsChanges::All },
+    };
+
+    for (const Row &row : matrix) {
+        int affected = SettingsChanges::Affected(row.setting);
+        if (affected != row.subsystems) {
+            Test::Fail(__FILE__, __LINE__, std::string(row.setting)
+                + ": unexpected subsystems");
+        }
+    }
+}
+
+TEST(SettingsChangesAffectedCombines) {
+    std::vector<std::string> settings;
+    CHECK_EQUAL((int) SettingsChanges::None,
+        SettingsChanges::Affected(settings));
+
+    settings.push_back("hideDelay");
+    settings.push_back("osdX");
+    CHECK_EQUAL(SettingsChanges::WindowBehavior
+        | SettingsChanges::WindowPosition,
+        SettingsChanges::Affected(settings));
+
+    settings.push_back("unknown");
+    CHECK_EQUAL((int) SettingsChanges::All,
+        SettingsChanges::Affected(settings));
+}
+
+TEST(SettingsChangesDiff) {
+    SettingsChanges::Snapshot before;
+    before["hideDelay"] = "<hideDelay>800</hideDelay>";
+    before["osdX"] = "<osdX>10</osdX>";
+    before["skin"] = "<skin>Classic</skin>";
+
+    SettingsChanges::Snapshot after(before);
+    CHECK(SettingsChanges::Diff(before, after).empty());
+
+    after["hideDelay"] = "<hideDelay>1000</hideDelay>";
+    after.erase("osdX");
+    after["onTop"] = "<onTop>true</onTop>";
+
+    std::vector<std::string> changes = SettingsChanges::Diff(before, after);
+    CHECK_EQUAL(3u, changes.size());
+    if (changes.size() == 3) {
+        /* Sorted by name */
+        CHECK_EQUAL(std::string("hideDelay"), changes[0]);
+        CHECK_EQUAL(std::string("onTop"), changes[1]);
+        CHECK_EQUAL(std::string("osdX"), changes[2]);
+    }
+
+    CHECK_EQUAL(SettingsChanges::WindowBehavior
+        | SettingsChanges::WindowPosition,
+        SettingsChanges::Affected(changes));
+}
+
+TEST(SettingsChangesDiffEmptySnapshots) {
+    SettingsChanges::Snapshot empty;
+    SettingsChanges::Snapshot loaded;
+    loaded["skin"] = "<skin>Classic</skin>";
+
+    CHECK_EQUAL(1u, SettingsChanges::Diff(empty, loaded).size());
+    CHECK_EQUAL(1u, SettingsChanges::Diff(loaded, empty).size());
+    CHECK(SettingsChanges::Diff(empty, empty).empty());
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "Test.h"
+
+#include <string>
+
+#include "SettingsValues.h"
+#include "TinyXml2/tinyxml2.h"
+
+namespace {
+
+const char *File =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<settings>\n"
+    "    <skin>Ignition</skin>\n"
+    "    <language>Deutsch</language>\n"
+    "    <onTop>false</onTop>\n"
+    "    <hideDelay>1200</hideDelay>\n"
+    "    <osdPosition>top-RIGHT</osdPosition>\n"
+    "    <hideAnimation>None</hideAnimation>\n"
+    "    <futureSetting mode=\"fast\"><nested>1</nested></futureSetting>\n"
+    "    <hotkeys>\n"
+    "        <hotkey combination=\"65601\" action=\"Mute\"/>\n"
+    "    </hotkeys>\n"
+    "</settings>\n";
+
+std::string Print(tinyxml2::XMLDocument &xml) {
+    tinyxml2::XMLPrinter printer;
+    xml.Print(&printer);
+    return std::string(printer.CStr(), printer.CStrSize() - 1);
+}
+
+std::string PrintElement(const tinyxml2::XMLElement *elem) {
+    if (elem == NULL) {
+        return "";
+    }
+    tinyxml2::XMLPrinter printer;
+    elem->Accept(&printer);
+    return printer.CStr();
+}
+
+}
+
+TEST(SettingsValuesDefaults) {
+    SettingsValues v;
+    v.Deserialize(NULL);
+
+    CHECK(v.skin == SettingsValues::DefaultSkin);
+    CHECK(v.language == SettingsValues::DefaultLanguage);
+    CHECK(v.audioDeviceID.empty());
+    CHECK_EQUAL(true, v.onTop);
+    CHECK_EQUAL(false, v.hideFullscreen);
+    CHECK_EQUAL(800, v.hideDelay);
+    CHECK_EQUAL(765, v.hideSpeed);
+    CHECK_EQUAL(140, v.osdEdgeOffset);
+    CHECK_EQUAL((int) SettingsValues::Bottom, (int) v.osdPosition);
+    CHECK_EQUAL((int) AnimationTypes::Fade, (int) v.hideAnim);
+}
+
+TEST(SettingsValuesDeserialize) {
+    tinyxml2::XMLDocument xml;
+    CHECK_EQUAL((int) tinyxml2::XML_SUCCESS, (int) xml.Parse(File));
+
+    SettingsValues v;
+    v.Deserialize(xml.FirstChildElement("settings"));
+
+    CHECK(v.skin == L"Ignition");
+    CHECK(v.language == L"Deutsch");
+    CHECK_EQUAL(false, v.onTop);
+    CHECK_EQUAL(1200, v.hideDelay);
+    CHECK_EQUAL((int) SettingsValues::TopRight, (int) v.osdPosition);
+    CHECK_EQUAL((int) AnimationTypes::None, (int) v.hideAnim);
+
+    /* Missing settings keep their defaults */
+    CHECK_EQUAL(765, v.hideSpeed);
+    CHECK_EQUAL(true, v.notifyIcon);
+}
+
+TEST(SettingsValuesInvalidNamesUseDefaults) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(
+        "<settings>"
+        "<skin></skin>"
+        "<osdPosition>Sideways</osdPosition>"
+        "<hideAnimation>Explode</hideAnimation>"
+        "</settings>");
+
+    SettingsValues v;
+    v.osdPosition = SettingsValues::Custom;
+    v.Deserialize(xml.FirstChildElement("settings"));
+
+    CHECK(v.skin == SettingsValues::DefaultSkin);
+    CHECK_EQUAL((int) SettingsValues::Bottom, (int) v.osdPosition);
+    CHECK_EQUAL((int) AnimationTypes::Fade, (int) v.hideAnim);
+}
+
+TEST(SettingsValuesRoundTrip) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse(File);
+    tinyxml2::XMLElement *root = xml.FirstChildElement("settings");
+
+    SettingsValues v;
+    v.Deserialize(root);
+    v.hideSpeed = 300;
+    v.osdPosition = SettingsValues::Custom;
+    v.osdX = -20;
+    v.soundEffects = false;
+    v.Serialize(root);
+
+    tinyxml2::XMLDocument reloaded;
+    CHECK_EQUAL((int) tinyxml2::XML_SUCCESS,
+        (int) reloaded.Parse(Print(xml).c_str()));
+    tinyxml2::XMLElement *reloadedRoot
+        = reloaded.FirstChildElement("settings");
+
+    SettingsValues r;
+    r.Deserialize(reloadedRoot);
+    CHECK(r.skin == L"Ignition");
+    CHECK(r.language == L"Deutsch");
+    CHECK_EQUAL(false, r.onTop);
+    CHECK_EQUAL(1200, r.hideDelay);
+    CHECK_EQUAL(300, r.hideSpeed);
+    CHECK_EQUAL((int) SettingsValues::Custom, (int) r.osdPosition);
+    CHECK_EQUAL(-20, r.osdX);
+    CHECK_EQUAL(false, r.soundEffects);
+    CHECK_EQUAL((int) AnimationTypes::None, (int) r.hideAnim);
+
+    /* Elements that aren't settings values come through unchanged */
+    tinyxml2::XMLDocument original;
+    original.Parse(File);
+    tinyxml2::XMLElement *originalRoot
+        = original.FirstChildElement("settings");
+    CHECK_EQUAL(
+        PrintElement(originalRoot->FirstChildElement("futureSetting")),
+        PrintElement(reloadedRoot->FirstChildElement("futureSetting")));
+    CHECK_EQUAL(
+        PrintElement(originalRoot->FirstChildElement("hotkeys")),
+        PrintElement(reloadedRoot->FirstChildElement("hotkeys")));
+
+    /* A second save of the reloaded values doesn't change the file */
+    std::string first = Print(reloaded);
+    r.Serialize(reloadedRoot);
+    CHECK_EQUAL(first, Print(reloaded));
+}
+
+TEST(SettingsValuesDefaultsNotPinned) {
+    tinyxml2::XMLDocument xml;
+    xml.Parse("<settings><hideDelay>800</hideDelay></settings>");
+    tinyxml2::XMLElement *root = xml.FirstChildElement("settings");
+
+    SettingsValues v;
+    v.Deserialize(root);
+    v.Serialize(root);
+
+    /* Only the default that was already in the file is written */
+    CHECK(root->FirstChildElement("hideDelay") != NULL);
+    CHECK(root->FirstChildElement("hideSpeed") == NULL);
+    CHECK(root->FirstChildElement("skin") == NULL);
+    CHECK(root->FirstChildElement("osdPosition") == NULL);
+
+    v.onTop = false;
+    v.Serialize(root);
+    CHECK(root->FirstChildElement("onTop") != NULL);
+    CHECK_EQUAL(std::string("false"),
+        std::string(root->FirstChildElement("onTop")->GetText()));
+}
\ No newline at end of file
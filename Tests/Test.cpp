@@ -0,0 +1,53 @@
+#include "Test.h"
+
+#include <iostream>
+
+int Test::_failures = 0;
+
+Test::Test(const char *name, Function function) {
+    Case c = { name, function };
+    Cases().push_back(c);
+}
+
+std::vector<Test::Case> &Test::Cases() {
+    /* Tests register themselves during static initialization, so the list
+     * can't be a static member that might not be constructed yet. */
+    static std::vector<Case> cases;
+    return cases;
+}
+
+int Test::RunAll(const std::string &filter) {
+    int run = 0;
+    int failed = 0;
+    for (const Case &c : Cases()) {
+        if (std::string(c.name).find(filter) == std::string::npos) {
+            continue;
+        }
+
+        int failures = _failures;
+        c.function();
+        ++run;
+        if (_failures != failures) {
+            std::cerr << "FAILED: " << c.name << "\n";
+            ++failed;
+        }
+    }
+
+    std::cerr << run << " tests, " << failed << " failed\n";
+    return failed;
+}
+
+void Test::Fail(const char *file, int line, const std::string &message) {
+    std::cerr << file << ":" << line << ": " << message << "\n";
+    ++_failures;
+}
+
+/// <summary>
+/// Runs the core library tests. An optional argument runs only the tests
+/// whose names contain it.
+/// </summary>
+int main(int argc, char *argv[]) {
+    std::string filter = (argc > 1) ? argv[1] : "";
+    return (Test::RunAll(filter) > 0) ? 1 : 0;
+
+}
\ No newline at end of file
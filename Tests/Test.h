@@ -0,0 +1,65 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define TEST(name) \
+    static void name(); \
+    static Test name##Test(#name, &name); \
+    static void name()
+
+#define CHECK(expr) \
+do { \
+    if ((expr) == false) { \
+        Test::Fail(__FILE__, __LINE__, #expr); \
+    } \
+} while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+    Test::Equal((expected), (actual), __FILE__, __LINE__, #actual)
+
+/// <summary>
+/// Minimal unit test registry for the portable core library. Each TEST()
+/// registers a function that is run by CoreTests; failed CHECKs are reported
+/// with their location, and the program exits with a nonzero status if any
+/// test failed.
+/// </summary>
+class Test {
+public:
+    typedef void (*Function)();
+
+    /// <summary>Registers a test; used by the TEST() macro.</summary>
+    Test(const char *name, Function function);
+
+    /// <summary>
+    /// Runs the tests whose names contain the given filter (or every test,
+    /// if it is empty). Returns the number of tests that failed.
+    /// </summary>
+    static int RunAll(const std::string &filter);
+
+    static void Fail(const char *file, int line, const std::string &message);
+
+    template <typename T, typename U>
+    static void Equal(const T &expected, const U &actual,
+            const char *file, int line, const char *expression) {
+
+        if (expected == actual) {
+            return;
+        }
+
+        std::ostringstream message;
+        message << expression << ": expected " << expected
+            << ", got " << actual;
+        Fail(file, line, message.str());
+    }
+
+private:
+    struct Case {
+        const char *name;
+        Function function;
+    };
+
+    static std::vector<Case> &Cases();
+    static int _failures;
+};
\ No newline at end of file
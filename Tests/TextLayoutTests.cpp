@@ -0,0 +1,115 @@
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+#include "MeterWnd/TextLayout.h"
+
+namespace {
+
+/// <summary>
+/// Reassembles the text drawn for a percentage from its cells.
+/// </summary>
+std::wstring Draw(const TextLayout &layout, int perc) {
+    std::vector<int> glyphs(layout.MaxGlyphs());
+    int count = layout.Glyphs(perc, glyphs.data());
+    std::wstring text;
+    for (int i = 0; i < count; ++i) {
+        text += layout.Cells()[glyphs[i]];
+    }
+    return text;
+}
+
+}
+
+TEST(TextLayoutNeedsShaping) {
+    CHECK(TextLayout::NeedsShaping(L"") == false);
+    CHECK(TextLayout::NeedsShaping(L"Volume: %") == false);
+    CHECK(TextLayout::NeedsShaping(L"\x97f3\x91cf") == false);
+    CHECK(TextLayout::NeedsShaping(L"Lautst\x00e4rke") == false);
+
+    /* Combining marks, right-to-left and complex scripts */
+    CHECK(TextLayout::NeedsShaping(L"e\x0301"));
+    CHECK(TextLayout::NeedsShaping(L"\x05e2\x05d5\x05e6\x05de\x05d4"));
+    CHECK(TextLayout::NeedsShaping(L"\x0627\x0644"));
+    CHECK(TextLayout::NeedsShaping(L"\x0939\x093f"));
+    CHECK(TextLayout::NeedsShaping(L"a\x200d" L"b"));
+
+    /* Surrogate pairs are decoded; lone surrogates always need shaping */
+    std::wstring smile;
+    smile += (wchar_t) 0xD83D;
+    smile += (wchar_t) 0xDE00;
+    CHECK(TextLayout::NeedsShaping(smile) == false);
+    std::wstring modifier;
+    modifier += (wchar_t) 0xD83C;
+    modifier += (wchar_t) 0xDFFB;
+    CHECK(TextLayout::NeedsShaping(smile + modifier));
+    CHECK(TextLayout::NeedsShaping(std::wstring(1, (wchar_t) 0xD83D)));
+    CHECK(TextLayout::NeedsShaping(std::wstring(1, (wchar_t) 0xDE00)
+        + L"x"));
+}
+
+TEST(TextLayoutCharacters) {
+    std::vector<std::wstring> chars = TextLayout::Characters(L"ab%");
+    CHECK_EQUAL(3, (int) chars.size());
+    CHECK(chars[2] == L"%");
+
+    /* Surrogate pairs stay together; a lone surrogate is on its own */
+    std::wstring text = L"x";
+    text += (wchar_t) 0xD83D;
+    text += (wchar_t) 0xDE00;
+    text += (wchar_t) 0xD83D;
+    text += L"y";
+    chars = TextLayout::Characters(text);
+    CHECK_EQUAL(4, (int) chars.size());
+    if (chars.size() == 4) {
+        CHECK(chars[0] == L"x");
+        CHECK_EQUAL(2, (int) chars[1].size());
+        CHECK_EQUAL(1, (int) chars[2].size());
+        CHECK(chars[3] == L"y");
+    }
+
+    CHECK(TextLayout::Characters(L"").empty());
+}
+
+TEST(TextLayoutCells) {
+    TextLayout layout(L"Vol: [[PERC]]%");
+    CHECK(layout.HasPerc());
+    CHECK(layout.PrefixText() == L"Vol: ");
+    CHECK(layout.SuffixText() == L"%");
+
+    /* The digits, then each distinct character once */
+    const std::vector<std::wstring> &cells = layout.Cells();
+    CHECK_EQUAL(16, (int) cells.size());
+    CHECK(cells[0] == L"0");
+    CHECK(cells[9] == L"9");
+    CHECK(cells[10] == L"V");
+    CHECK(cells[15] == L"%");
+
+    TextLayout repeated(L"0 [[PERC]] 0");
+    CHECK_EQUAL(11, (int) repeated.Cells().size());
+}
+
+TEST(TextLayoutGlyphs) {
+    TextLayout layout(L"Vol: [[PERC]]%");
+    CHECK_EQUAL(5 + 3 + 1, (int) layout.MaxGlyphs());
+    for (int perc = 0; perc <= 100; ++perc) {
+        std::wstring expected = L"Vol: " + std::to_wstring(perc) + L"%";
+        if (Draw(layout, perc) != expected) {
+            Test::Fail(__FILE__, __LINE__, "wrong text for "
+                + std::to_string(perc));
+        }
+    }
+
+    /* Without [[PERC]], the format is drawn as-is */
+    TextLayout fixed(L"Muted");
+    CHECK(fixed.HasPerc() == false);
+    CHECK_EQUAL(5, (int) fixed.MaxGlyphs());
+    CHECK(Draw(fixed, 50) == L"Muted");
+
+    TextLayout bare(L"[[PERC]]");
+    CHECK_EQUAL(3, (int) bare.MaxGlyphs());
+    CHECK(Draw(bare, 0) == L"0");
+    CHECK(Draw(bare, 7) == L"7");
+    CHECK(Draw(bare, 100) == L"100");
+}
\ No newline at end of file
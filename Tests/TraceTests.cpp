@@ -0,0 +1,111 @@
+#include "Test.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Trace.h"
+
+namespace {
+
+void Span() {
+    TRACE_SPAN("span");
+}
+
+}
+
+TEST(TraceRecordsOnlyWhileActive) {
+    Trace::Stop();
+    CHECK(Trace::Active() == false);
+    Span();
+
+    Trace::Start();
+    CHECK(Trace::Active());
+    CHECK(Trace::Events().empty());
+    Span();
+    Span();
+    Trace::Stop();
+    Span();
+
+    std::vector<Trace::Event> events = Trace::Events();
+    CHECK_EQUAL(2, (int) events.size());
+    for (const Trace::Event &event : events) {
+        CHECK_EQUAL(std::string("span"), std::string(event.name));
+    }
+
+    /* Starting again discards the previous session */
+    Trace::Start();
+    CHECK(Trace::Events().empty());
+    Trace::Stop();
+}
+
+TEST(TraceRingWraparound) {
+    unsigned int capacity = Trace::Capacity;
+    unsigned int extra = 10;
+
+    Trace::Start();
+    for (unsigned int i = 0; i < capacity + extra; ++i) {
+        Trace::Record("event", i, i + 1);
+    }
+    Trace::Stop();
+
+    /* Only the most recent spans are kept, oldest first */
+    std::vector<Trace::Event> events = Trace::Events();
+    CHECK_EQUAL(capacity, (unsigned int) events.size());
+    if (events.size() != capacity) {
+        return;
+    }
+    for (unsigned int i = 0; i < capacity; ++i) {
+        if (events[i].start != i + extra) {
+            Test::Fail(__FILE__, __LINE__, "events out of order");
+            return;
+        }
+    }
+    CHECK_EQUAL(1ULL, events[0].duration);
+}
+
+TEST(TraceWriteJSON) {
+    Trace::Start();
+    std::ostringstream empty;
+    Trace::WriteJSON(empty);
+    CHECK_EQUAL(std::string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+        "\n]}\n"), empty.str());
+
+    Trace::Record("stage", 1000, 1005);
+    Trace::Record("quote\"d", 1010, 1012);
+    Trace::Stop();
+
+    std::ostringstream tid;
+    tid << Trace::Events()[0].thread;
+
+    /* Complete ("X") events with times relative to the first span */
+    std::string expected = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+        "\n{\"name\":\"stage\",\"cat\":\"3RVX\",\"ph\":\"X\",\"pid\":1,"
+        "\"tid\":" + tid.str() + ",\"ts\":0,\"dur\":5},"
+        "\n{\"name\":\"quote\\\"d\",\"cat\":\"3RVX\",\"ph\":\"X\",\"pid\":1,"
+        "\"tid\":" + tid.str() + ",\"ts\":10,\"dur\":2}"
+        "\n]}\n";
+
+    std::ostringstream out;
+    Trace::WriteJSON(out);
+    CHECK_EQUAL(expected, out.str());
+}
+
+TEST(TraceWriteSummary) {
+    /* Spans with the same name are grouped even if the literals differ */
+    char draw[] = "draw";
+
+    Trace::Start();
+    Trace::Record("draw", 100, 110);
+    Trace::Record("hotkey", 100, 107);
+    Trace::Record(draw, 200, 230);
+    Trace::Record("draw", 300, 320);
+    Trace::Stop();
+
+    std::ostringstream out;
+    Trace::WriteSummary(out);
+    CHECK_EQUAL(std::string(
+        "name,count,total_us,mean_us,min_us,max_us\n"
+        "draw,3,60,20,10,30\n"
+        "hotkey,1,7,7,7,7\n"), out.str());
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Test.h"
+
+#include <string>
+
+#include "TranslationTable.h"
+
+TEST(TranslationTableFind) {
+    TranslationTable table;
+    CHECK(table.Add(L"Settings", L"Einstellungen"));
+    CHECK(table.Add(L"Exit", L"Beenden"));
+    CHECK_EQUAL((size_t) 2, table.Size());
+
+    int handle = table.Find(L"Settings");
+    CHECK(handle != TranslationTable::NotFound);
+    CHECK(table.Translation(handle) == L"Einstellungen");
+    CHECK(table.Translation(table.Find(L"Exit")) == L"Beenden");
+
+    /* Strings are matched exactly */
+    int notFound = TranslationTable::NotFound;
+    CHECK_EQUAL(notFound, table.Find(L"settings"));
+    CHECK_EQUAL(notFound, table.Find(L"Setting"));
+    CHECK_EQUAL(notFound, table.Find(L"Settings "));
+    CHECK_EQUAL(notFound, table.Find(L""));
+}
+
+TEST(TranslationTableEmpty) {
+    TranslationTable table;
+    int notFound = TranslationTable::NotFound;
+    CHECK_EQUAL((size_t) 0, table.Size());
+    CHECK_EQUAL(notFound, table.Find(L"Settings"));
+    CHECK_EQUAL(notFound, table.Find(L""));
+
+    /* The empty string is a key like any other */
+    CHECK(table.Add(L"", L"(empty)"));
+    CHECK(table.Translation(table.Find(L"")) == L"(empty)");
+}
+
+TEST(TranslationTableRejectsDuplicates) {
+    TranslationTable table;
+    CHECK(table.Add(L"Save", L"Speichern"));
+    CHECK_EQUAL(false, table.Add(L"Save", L"Sichern"));
+    CHECK_EQUAL(false, table.Add(std::wstring(L"Save"), L""));
+
+    /* The table is unchanged */
+    CHECK_EQUAL((size_t) 1, table.Size());
+    CHECK(table.Translation(table.Find(L"Save")) == L"Speichern");
+}
+
+TEST(TranslationTableGrows) {
+    /* The table starts with 16 slots and is kept at most half full, so this
+     * grows it several times. Every entry has to survive each rehash. */
+    TranslationTable table;
+    const int Count = 1000;
+    for (int i = 0; i < Count; ++i) {
+        std::wstring original = L"String " + std::to_wstring(i);
+        CHECK(table.Add(original, std::to_wstring(i * 7)));
+    }
+    CHECK_EQUAL((size_t) Count, table.Size());
+
+    int missing = 0;
+    for (int i = 0; i < Count; ++i) {
+        int handle = table.Find(L"String " + std::to_wstring(i));
+        if (handle == TranslationTable::NotFound
+                || table.Translation(handle) != std::to_wstring(i * 7)) {
+            missing++;
+        }
+    }
+    CHECK_EQUAL(0, missing);
+
+    int notFound = TranslationTable::NotFound;
+    CHECK_EQUAL(notFound, table.Find(L"String 1000"));
+    CHECK_EQUAL(notFound, table.Find(L"String -1"));
+    CHECK_EQUAL(false, table.Add(L"String 500", L"x"));
+}
+
+TEST(TranslationTableHandlesAreStable) {
+    /* Handles index the translations, so growing the table must not change
+     * them. */
+    TranslationTable table;
+    table.Add(L"First", L"Erste");
+    int handle = table.Find(L"First");
+    for (int i = 0; i < 100; ++i) {
+        table.Add(std::to_wstring(i), L"");
+    }
+    CHECK_EQUAL(handle, table.Find(L"First"));
+    CHECK(table.Translation(handle) == L"Erste");
+}
+
+TEST(TranslationTableClear) {
+    TranslationTable table;
+    for (int i = 0; i < 100; ++i) {
+        table.Add(std::to_wstring(i), L"");
+    }
+    table.Clear();
+
+    int notFound = TranslationTable::NotFound;
+    CHECK_EQUAL((size_t) 0, table.Size());
+    CHECK_EQUAL(notFound, table.Find(L"1"));
+    CHECK(table.Add(L"1", L"one"));
+    CHECK(table.Translation(table.Find(L"1")) == L"one");
+}
\ No newline at end of file
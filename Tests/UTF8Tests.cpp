@@ -0,0 +1,311 @@
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+#include "UTF8.h"
+
+namespace {
+
+/// <summary>
+/// Deterministic pseudo-random numbers (xorshift32), so failures can be
+/// reproduced.
+/// </summary>
+class Random {
+public:
+    Random(unsigned int seed) :
+    _state(seed) {
+
+    }
+
+    unsigned int Next() {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    unsigned int Next(unsigned int limit) {
+        return Next() % limit;
+    }
+
+private:
+    unsigned int _state;
+};
+
+void AppendWide(unsigned int codePoint, std::wstring &out) {
+    if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        out.push_back((wchar_t) (0xD800 + (codePoint >> 10)));
+        out.push_back((wchar_t) (0xDC00 + (codePoint & 0x3FF)));
+    } else {
+        out.push_back((wchar_t) codePoint);
+    }
+}
+
+void AppendNarrow(unsigned int codePoint, std::string &out) {
+    if (codePoint < 0x80) {
+        out.push_back((char) codePoint);
+    } else if (codePoint < 0x800) {
+        out.push_back((char) (0xC0 | (codePoint >> 6)));
+        out.push_back((char) (0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back((char) (0xE0 | (codePoint >> 12)));
+        out.push_back((char) (0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back((char) (0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back((char) (0xF0 | (codePoint >> 18)));
+        out.push_back((char) (0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back((char) (0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back((char) (0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/// <summary>
+/// Reference decoder: the byte-at-a-time UTF-8 decoder from the WHATWG
+/// Encoding Standard, which replaces each maximal invalid subsequence with
+/// one U+FFFD.
+/// </summary>
+std::wstring ReferenceDecode(const std::string &in) {
+    std::wstring out;
+    unsigned int codePoint = 0;
+    int needed = 0;
+    int seen = 0;
+    unsigned int lower = 0x80;
+    unsigned int upper = 0xBF;
+
+    for (size_t i = 0; i < in.size(); ++i) {
+        unsigned int b = (unsigned char) in[i];
+        if (needed == 0) {
+            if (b <= 0x7F) {
+                out.push_back((wchar_t) b);
+            } else if (b >= 0xC2 && b <= 0xDF) {
+                needed = 1;
+                codePoint = b & 0x1F;
+            } else if (b >= 0xE0 && b <= 0xEF) {
+                lower = (b == 0xE0) ? 0xA0 : 0x80;
+                upper = (b == 0xED) ? 0x9F : 0xBF;
+                needed = 2;
+                codePoint = b & 0x0F;
+            } else if (b >= 0xF0 && b <= 0xF4) {
+                lower = (b == 0xF0) ? 0x90 : 0x80;
+                upper = (b == 0xF4) ? 0x8F : 0xBF;
+                needed = 3;
+                codePoint = b & 0x07;
+            } else {
+                out.push_back((wchar_t) 0xFFFD);
+            }
+            continue;
+        }
+
+        if (b < lower || b > upper) {
+            /* The byte is processed again as the start of a sequence */
+            codePoint = 0;
+            needed = 0;
+            seen = 0;
+            lower = 0x80;
+            upper = 0xBF;
+            out.push_back((wchar_t) 0xFFFD);
+            --i;
+            continue;
+        }
+
+        lower = 0x80;
+        upper = 0xBF;
+        codePoint = (codePoint << 6) | (b & 0x3F);
+        if (++seen == needed) {
+            AppendWide(codePoint, out);
+            codePoint = 0;
+            needed = 0;
+            seen = 0;
+        }
+    }
+
+    if (needed != 0) {
+        out.push_back((wchar_t) 0xFFFD);
+    }
+    return out;
+}
+
+/// <summary>
+/// Reference encoder: unpaired surrogates and values outside the Unicode
+/// range are replaced with U+FFFD.
+/// </summary>
+std::string ReferenceEncode(const std::wstring &in) {
+    std::string out;
+    for (size_t i = 0; i < in.size(); ++i) {
+        unsigned int c = (unsigned int) in[i];
+        if (sizeof(wchar_t) == 2) {
+            c &= 0xFFFF;
+        }
+
+        if (sizeof(wchar_t) == 2 && c >= 0xD800 && c <= 0xDBFF
+                && i + 1 < in.size()) {
+            unsigned int low = (unsigned int) in[i + 1] & 0xFFFF;
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                AppendNarrow(0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00),
+                    out);
+                ++i;
+                continue;
+            }
+        }
+
+        if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+            c = 0xFFFD;
+        }
+        AppendNarrow(c, out);
+    }
+    return out;
+}
+
+std::wstring Decode(const std::string &in) {
+    std::vector<wchar_t> buf(UTF8::MaxWideLength(in.size()) + 1);
+    size_t length = UTF8::Decode(in.data(), in.size(), &buf[0]);
+    return std::wstring(&buf[0], length);
+}
+
+std::string Encode(const std::wstring &in) {
+    std::vector<char> buf(UTF8::MaxNarrowLength(in.size()) + 1);
+    size_t length = UTF8::Encode(in.data(), in.size(), &buf[0]);
+    return std::string(&buf[0], length);
+}
+
+unsigned int RandomCodePoint(Random &random) {
+    switch (random.Next(4)) {
+    case 0:
+        return random.Next(0x80);
+    case 1:
+        return 0x80 + random.Next(0x800 - 0x80);
+    case 2: {
+        unsigned int c = 0x800 + random.Next(0x10000 - 0x800);
+        return (c >= 0xD800 && c <= 0xDFFF) ? 0xFFFD : c;
+    }
+    default:
+        return 0x10000 + random.Next(0x110000 - 0x10000);
+    }
+}
+
+/// <summary>
+/// Produces mostly-valid UTF-8 with long ASCII runs (to exercise the vector
+/// path) and occasional corruption: random bytes, truncated sequences, and
+/// encodings of surrogates or overlong forms.
+/// </summary>
+std::string RandomNarrow(Random &random) {
+    std::string s;
+    int pieces = (int) random.Next(24);
+    for (int i = 0; i < pieces; ++i) {
+        switch (random.Next(8)) {
+        case 0: {
+            int run = (int) random.Next(40);
+            for (int j = 0; j < run; ++j) {
+                s.push_back((char) (0x20 + random.Next(0x5F)));
+            }
+            break;
+        }
+        case 1:
+            s.push_back((char) random.Next(256));
+            break;
+        case 2: {
+            std::string seq;
+            AppendNarrow(0x80 + random.Next(0x110000 - 0x80), seq);
+            s.append(seq, 0, 1 + random.Next((unsigned int) seq.size() - 1));
+            break;
+        }
+        case 3: {
+            const char *bad[] = {
+                "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+                "\xF8\x88\x80\x80\x80", "\xFF", "\x80\x80",
+            };
+            s.append(bad[random.Next(7)]);
+            break;
+        }
+        default:
+            AppendNarrow(RandomCodePoint(random), s);
+            break;
+        }
+    }
+    return s;
+}
+
+std::wstring RandomWide(Random &random) {
+    std::wstring s;
+    int pieces = (int) random.Next(24);
+    for (int i = 0; i < pieces; ++i) {
+        switch (random.Next(6)) {
+        case 0: {
+            int run = (int) random.Next(40);
+            for (int j = 0; j < run; ++j) {
+                s.push_back((wchar_t) (0x20 + random.Next(0x5F)));
+            }
+            break;
+        }
+        case 1:
+            /* Lone surrogate */
+            s.push_back((wchar_t) (0xD800 + random.Next(0x800)));
+            break;
+        default:
+            AppendWide(RandomCodePoint(random), s);
+            break;
+        }
+    }
+    return s;
+}
+
+}
+
+TEST(UTF8DecodeKnownSequences) {
+    CHECK(Decode("") == L"");
+    CHECK(Decode("3RVX") == L"3RVX");
+    CHECK(Decode("\xC3\xA9") == L"\x00E9");
+    CHECK(Decode("\xE2\x82\xAC") == L"\x20AC");
+
+    std::wstring astral;
+    AppendWide(0x1F50A, astral);
+    CHECK(Decode("\xF0\x9F\x94\x8A") == astral);
+
+    /* Overlong, surrogate, and truncated sequences */
+    CHECK(Decode("\xC0\xAF") == L"\xFFFD\xFFFD");
+    CHECK(Decode("\xED\xA0\x80") == L"\xFFFD\xFFFD\xFFFD");
+    CHECK(Decode("\xE2\x82" "A") == L"\xFFFD" L"A");
+}
+
+TEST(UTF8DecodeMatchesReference) {
+    Random random(0x3A5F1E2D);
+    for (int i = 0; i < 20000; ++i) {
+        std::string in = RandomNarrow(random);
+        if (Decode(in) != ReferenceDecode(in)) {
+            Test::Fail(__FILE__, __LINE__,
+                "decode mismatch in case " + std::to_string(i));
+            return;
+        }
+    }
+}
+
+TEST(UTF8EncodeMatchesReference) {
+    Random random(0x1D2C3B4A);
+    for (int i = 0; i < 20000; ++i) {
+        std::wstring in = RandomWide(random);
+        if (Encode(in) != ReferenceEncode(in)) {
+            Test::Fail(__FILE__, __LINE__,
+                "encode mismatch in case " + std::to_string(i));
+            return;
+        }
+    }
+}
+
+TEST(UTF8RoundTrip) {
+    Random random(0x600DF00D);
+    for (int i = 0; i < 5000; ++i) {
+        std::wstring wide;
+        int length = (int) random.Next(64);
+        for (int j = 0; j < length; ++j) {
+            AppendWide(RandomCodePoint(random), wide);
+        }
+
+        if (Decode(Encode(wide)) != wide) {
+            Test::Fail(__FILE__, __LINE__,
+                "round trip mismatch in case " + std::to_string(i));
+            return;
+        }
+    }
+}
\ No newline at end of file
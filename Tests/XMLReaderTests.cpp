@@ -0,0 +1,217 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "TinyXml2/tinyxml2.h"
+#include "XMLReader.h"
+
+namespace {
+
+/// <summary>
+/// Reads the whole document and describes each event on its own line: start
+/// and end tags, and [text]. Errors end the transcript with "error".
+/// </summary>
+std::string Events(XMLReader &reader) {
+    std::string events;
+    while (true) {
+        switch (reader.Next()) {
+        case XMLReader::StartElement:
+            events += "<" + std::string(reader.Name()) + ">\n";
+            break;
+
+        case XMLReader::EndElement:
+            events += "</" + std::string(reader.Name()) + ">\n";
+            break;
+
+        case XMLReader::Text:
+            events += "[" + std::string(reader.Value()) + "]\n";
+            break;
+
+        case XMLReader::End:
+            return events;
+
+        case XMLReader::Error:
+            return events + "error\n";
+        }
+    }
+}
+
+std::string Events(const char *xml) {
+    XMLReader reader;
+    reader.Load(xml, strlen(xml));
+    return Events(reader);
+}
+
+bool WhiteSpace(const char *text) {
+    for (; *text != '\0'; ++text) {
+        if (tinyxml2::XMLUtil::IsWhiteSpace(*text) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>Describes a DOM subtree in the same format as Events().</summary>
+void DOMEvents(const tinyxml2::XMLNode *node, std::string &events) {
+    for (; node != NULL; node = node->NextSibling()) {
+        const tinyxml2::XMLElement *elem = node->ToElement();
+        if (elem != NULL) {
+            events += "<" + std::string(elem->Name()) + ">\n";
+            DOMEvents(elem->FirstChild(), events);
+            events += "</" + std::string(elem->Name()) + ">\n";
+            continue;
+        }
+
+        const tinyxml2::XMLText *text = node->ToText();
+        if (text != NULL && WhiteSpace(text->Value()) == false) {
+            events += "[" + std::string(text->Value()) + "]\n";
+        }
+    }
+}
+
+}
+
+TEST(XMLReaderElements) {
+    CHECK_EQUAL(std::string(
+        "<a>\n<b>\n</b>\n<c>\n[text]\n</c>\n</a>\n"),
+        Events("<?xml version=\"1.0\"?><a><b/>\n  <c>text</c></a>"));
+}
+
+TEST(XMLReaderAttributes) {
+    XMLReader reader;
+    const char *xml = "<a one=\"1\" two='&lt;2&gt;' three = \"\"/>";
+    reader.Load(xml, strlen(xml));
+
+    CHECK_EQUAL((int) XMLReader::StartElement, (int) reader.Next());
+    CHECK_EQUAL(std::string("1"), std::string(reader.Attribute("one")));
+    CHECK_EQUAL(std::string("<2>"), std::string(reader.Attribute("two")));
+    CHECK_EQUAL(std::string(""), std::string(reader.Attribute("three")));
+    CHECK(reader.Attribute("four") == NULL);
+    CHECK_EQUAL(1, reader.Depth());
+
+    CHECK_EQUAL((int) XMLReader::EndElement, (int) reader.Next());
+    CHECK(reader.IsElement("a"));
+    CHECK_EQUAL(0, reader.Depth());
+    CHECK_EQUAL((int) XMLReader::End, (int) reader.Next());
+}
+
+TEST(XMLReaderMismatchedEndTag) {
+    CHECK_EQUAL(std::string("<a>\nerror\n"), Events("<a></b>"));
+    CHECK_EQUAL(std::string("<a>\n<b>\nerror\n"), Events("<a><b></a></b>"));
+    CHECK_EQUAL(std::string("<a>\n<ab>\nerror\n"), Events("<a><ab></a>"));
+    CHECK_EQUAL(std::string("<ab>\nerror\n"), Events("<ab></a>"));
+    CHECK_EQUAL(std::string("<a>\nerror\n"), Events("<a>"));
+    CHECK_EQUAL(std::string("error\n"), Events("</a>"));
+}
+
+TEST(XMLReaderEndTagAfterText) {
+    CHECK_EQUAL(std::string("<a>\n[x]\n</a>\n"), Events("<a>x</a>"));
+    CHECK_EQUAL(std::string("<a>\n[x]\nerror\n"), Events("<a>x</b>"));
+    CHECK_EQUAL(std::string("<a>\n[x]\n<b>\n</b>\n</a>\n"),
+        Events("<a>x<b/></a>"));
+}
+
+TEST(XMLReaderUnescape) {
+    CHECK_EQUAL(std::string("<a>\n[1 < 2 & \"3\" > 'x']\n</a>\n"),
+        Events("<a>1 &lt; 2 &amp; &quot;3&quot; &gt; &apos;x&apos;</a>"));
+
+    /* Character references, unknown entities, and an entity that runs into
+     * the end of the text */
+    CHECK_EQUAL(std::string("<a>\n[AB &bogus; &amp]\n</a>\n"),
+        Events("<a>&#65;&#x42; &bogus; &amp</a>"));
+
+    /* Line endings are normalized */
+    CHECK_EQUAL(std::string("<a>\n[1\n2\n3]\n</a>\n"),
+        Events("<a>1\r\n2\r3</a>"));
+}
+
+TEST(XMLReaderUnescapeWritesAtEnd) {
+    /* Text that doesn't shrink when it is unescaped is terminated in place
+     * of the '<' that follows it, so the tag has to be read without looking
+     * for the '<' again. */
+    const char *docs[] = {
+        "<a>abc</a><!-- -->",
+        "<a>&amp;c</a><!-- -->",
+    };
+    const char *values[] = { "abc", "&c" };
+
+    for (int i = 0; i < 2; ++i) {
+        XMLReader reader;
+        reader.Load(docs[i], strlen(docs[i]));
+
+        CHECK_EQUAL((int) XMLReader::StartElement, (int) reader.Next());
+        CHECK_EQUAL((int) XMLReader::Text, (int) reader.Next());
+        CHECK_EQUAL(std::string(values[i]), std::string(reader.Value()));
+        CHECK_EQUAL((int) XMLReader::EndElement, (int) reader.Next());
+        CHECK(reader.IsElement("a"));
+        CHECK_EQUAL((int) XMLReader::End, (int) reader.Next());
+    }
+}
+
+TEST(XMLReaderCommentsAndCDATA) {
+    CHECK_EQUAL(std::string(
+        "<a>\n[one]\n[two]\n[<b>&amp;</b>]\n[three]\n</a>\n"),
+        Events("<a>one<!-- <c/> -->two<![CDATA[<b>&amp;</b>]]>three</a>"));
+
+    CHECK_EQUAL(std::string("<a>\n</a>\n"),
+        Events("<!DOCTYPE a><!-- x --><a>  <!-- y -->\n</a><!-- z -->"));
+
+    CHECK_EQUAL(std::string("<a>\nerror\n"), Events("<a><!-- x </a>"));
+    CHECK_EQUAL(std::string("<a>\nerror\n"), Events("<a><![CDATA[x</a>"));
+}
+
+TEST(XMLReaderElementText) {
+    XMLReader reader;
+    const char *xml = "<a><b>one<c>two</c>three</b><d/><e>four</e></a>";
+    reader.Load(xml, strlen(xml));
+
+    reader.Next();
+    reader.Next();
+    CHECK(reader.IsElement("b"));
+    CHECK_EQUAL(std::string("one"), std::string(reader.ElementText()));
+    CHECK_EQUAL(1, reader.Depth());
+
+    reader.Next();
+    CHECK(reader.IsElement("d"));
+    CHECK(reader.ElementText() == NULL);
+
+    reader.Next();
+    CHECK(reader.Skip());
+    CHECK_EQUAL((int) XMLReader::EndElement, (int) reader.Next());
+    CHECK(reader.IsElement("a"));
+}
+
+TEST(XMLReaderMatchesDOM) {
+    const char *files[] = {
+        "ChineseSimplified.xml",
+        "Deutsch.xml",
+        "English.xml",
+        "TestLanguage.xml",
+    };
+
+    for (const char *file : files) {
+        std::string path = std::string(TEST_SOURCE_DIR) + "/Languages/"
+            + file;
+
+        tinyxml2::XMLDocument doc;
+        CHECK_EQUAL((int) tinyxml2::XML_SUCCESS,
+            (int) doc.LoadFile(path.c_str()));
+        std::string expected;
+        DOMEvents(doc.FirstChild(), expected);
+        CHECK(expected.empty() == false);
+
+        FILE *fp = fopen(path.c_str(), "rb");
+        XMLReader reader;
+        CHECK(reader.Load(fp));
+        if (fp != NULL) {
+            fclose(fp);
+        }
+
+        if (Events(reader) != expected) {
+            Test::Fail(__FILE__, __LINE__,
+                std::string(file) + ": events differ from the DOM");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "Test.h"
+
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#include "TinyXml2/tinyxml2.h"
+
+using tinyxml2::XMLUtil;
+
+namespace {
+
+/* The scanners as they are built with TINYXML2_NO_SIMD */
+char *ScalarFindCharOrEnd(char *p, char c) {
+    while (*p && *p != c) {
+        ++p;
+    }
+    return p;
+}
+
+const char *ScalarSkipWhiteSpace(const char *p) {
+    while (XMLUtil::IsUTF8Continuation(*p) == false
+            && isspace(*reinterpret_cast<const unsigned char *>(p))) {
+        ++p;
+    }
+    return p;
+}
+
+/// <summary>
+/// Bytes the scanners have to tell apart: every kind of whitespace, the
+/// delimiters they search for, bytes with the high bit set (which are never
+/// whitespace), and ordinary text.
+/// </summary>
+const char Alphabet[] = {
+    ' ', ' ', ' ', '\t', '\n', '\v', '\f', '\r',
+    '<', '>', '&', '\"', '\'', '/',
+    'a', 'Z', '0', '\x08', '\x0e', '\x1f', '\x21',
+    '\x7f', '\x80', '\x85', '\xa0', '\xc3', '\xff',
+};
+
+std::string Describe(int offset, int length, int iteration) {
+    std::ostringstream ss;
+    ss << "offset " << offset << ", length " << length
+        << ", iteration " << iteration;
+    return ss.str();
+}
+
+}
+
+TEST(XMLScanMatchesScalar) {
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> pick(0, sizeof(Alphabet) - 1);
+
+    /* Strings start at each offset within an aligned block and run across
+     * several blocks, so every head, body, and tail case of the vector loops
+     * is covered. Bytes past the terminator are filled in too; nothing may
+     * be found there. */
+    const int Blocks = 5;
+    alignas(16) char buffer[16 * Blocks + 16];
+
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        int offset = iteration % 16;
+        int length = (int) (random() % (16 * Blocks - offset));
+        for (char &b : buffer) {
+            b = Alphabet[pick(random)];
+        }
+
+        /* Long runs of whitespace exercise the vector loop of
+         * SkipWhiteSpace. */
+        char *p = buffer + offset;
+        if (iteration % 3 == 0) {
+            int run = (int) (random() % (length + 1));
+            memset(p, (iteration % 2) ? ' ' : '\n', run);
+        }
+        p[length] = '\0';
+
+        const char delimiters[] = { '<', '>', '&', '\"', 'a' };
+        for (char c : delimiters) {
+            if (XMLUtil::FindCharOrEnd(p, c) != ScalarFindCharOrEnd(p, c)) {
+                Test::Fail(__FILE__, __LINE__, "FindCharOrEnd '"
+                    + std::string(1, c) + "': "
+                    + Describe(offset, length, iteration));
+                return;
+            }
+        }
+
+        for (int start = 0; start <= length; ++start) {
+            if (XMLUtil::SkipWhiteSpace(p + start)
+                    != ScalarSkipWhiteSpace(p + start)) {
+                Test::Fail(__FILE__, __LINE__, "SkipWhiteSpace: "
+                    + Describe(offset + start, length - start, iteration));
+                return;
+            }
+        }
+    }
+}
+
+TEST(XMLScanStopsAtTerminator) {
+    alignas(16) char buffer[48];
+
+    /* The terminator is followed by bytes that would otherwise match in the
+     * same block. */
+    for (int end = 0; end < 32; ++end) {
+        memset(buffer, ' ', sizeof(buffer));
+        buffer[end] = '\0';
+        buffer[end + 1] = '<';
+        CHECK(XMLUtil::SkipWhiteSpace(buffer) == buffer + end);
+        CHECK(XMLUtil::FindCharOrEnd(buffer, '<') == buffer + end);
+    }
+}
+
+TEST(XMLScanParsesLongRuns) {
+    /* Text and whitespace longer than a block go through the vector loops
+     * while parsing. */
+    std::string padding(70, ' ');
+    std::string text(70, 'x');
+    std::string xml = "<a>" + padding + "<b attr=\"" + text + "\">"
+        + text + "&amp;" + text + "</b>\r\n" + padding + "</a>";
+
+    tinyxml2::XMLDocument doc;
+    CHECK_EQUAL((int) tinyxml2::XML_SUCCESS, (int) doc.Parse(xml.c_str()));
+    tinyxml2::XMLElement *b = doc.FirstChildElement("a")
+        ->FirstChildElement("b");
+    CHECK(b != NULL);
+    CHECK_EQUAL(text, std::string(b->Attribute("attr")));
+    CHECK_EQUAL(text + "&" + text, std::string(b->GetText()));
+}
\ No newline at end of file